@@ -133,6 +133,11 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
             else if (std::strncmp(argv[i], "--addon=", 8) == 0)
                 mSettings->addons.emplace_back(argv[i]+8);
 
+            else if (std::strncmp(argv[i], "--coordinator=", 14) == 0) {
+                mSettings->distributedRole = Settings::DISTRIBUTED_COORDINATOR;
+                mSettings->distributedAddress = argv[i] + 14;
+            }
+
             else if (std::strncmp(argv[i], "--cppcheck-build-dir=", 21) == 0) {
                 mSettings->buildDir = Path::fromNativeSeparators(argv[i] + 21);
                 if (endsWith(mSettings->buildDir, '/'))
@@ -157,6 +162,30 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
                 mSettings->debugtemplate = true;
 
             // dump cppcheck data
+            else if (std::strncmp(argv[i], "--distributed-timeout=", 22) == 0) {
+                std::istringstream iss(22+argv[i]);
+                if (!(iss >> mSettings->distributedTimeout) || mSettings->distributedTimeout < 1) {
+                    printMessage("cppcheck: argument to '--distributed-timeout=' must be a number greater than 0.");
+                    return false;
+                }
+            }
+
+            else if (std::strncmp(argv[i], "--distributed-token-file=", 25) == 0) {
+                const std::string filename = argv[i] + 25;
+                std::ifstream f(filename);
+                if (!f.is_open()) {
+                    printMessage("cppcheck: Couldn't open the file: \"" + filename + "\".");
+                    return false;
+                }
+                std::getline(f, mSettings->distributedToken);
+                if (endsWith(mSettings->distributedToken, '\r'))
+                    mSettings->distributedToken.erase(mSettings->distributedToken.size() - 1U);
+                if (mSettings->distributedToken.empty()) {
+                    printMessage("cppcheck: error: the first line of '" + filename + "' is not a token.");
+                    return false;
+                }
+            }
+
             else if (std::strcmp(argv[i], "--dump") == 0)
                 mSettings->dump = true;
 
@@ -177,6 +206,19 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
                 CppCheckExecutor::setExceptionOutput((exceptionOutfilename=="stderr") ? stderr : stdout);
             }
 
+            // Executor used for -j
+            else if (std::strncmp(argv[i], "--executor=", 11) == 0) {
+                const std::string executor = argv[i] + 11;
+                if (executor == "thread")
+                    mSettings->executor = Settings::EXECUTOR_THREAD;
+                else if (executor == "process")
+                    mSettings->executor = Settings::EXECUTOR_PROCESS;
+                else {
+                    printMessage("cppcheck: Unknown executor '" + executor + "'. Valid values are 'thread' and 'process'.");
+                    return false;
+                }
+            }
+
             // Inconclusive checking
             else if (std::strcmp(argv[i], "--inconclusive") == 0)
                 mSettings->inconclusive = true;
@@ -275,6 +317,29 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
             else if (std::strcmp(argv[i], "-v") == 0 || std::strcmp(argv[i], "--verbose") == 0)
                 mSettings->verbose = true;
 
+            // Set maximum time of the repeated ValueFlow passes
+            else if (std::strncmp(argv[i], "--valueflow-max-time=", 21) == 0) {
+                std::istringstream iss(21+argv[i]);
+                if (!(iss >> mSettings->valueFlowMaxTime)) {
+                    printMessage("cppcheck: argument to '--valueflow-max-time=' is not a number.");
+                    return false;
+                }
+            }
+
+            // Number of function scopes that are analysed at the same time by ValueFlow
+            else if (std::strncmp(argv[i], "--valueflow-jobs=", 17) == 0) {
+                std::istringstream iss(17+argv[i]);
+                if (!(iss >> mSettings->valueFlowJobs)) {
+                    printMessage("cppcheck: argument to '--valueflow-jobs=' is not a number.");
+                    return false;
+                }
+
+                if (mSettings->valueFlowJobs < 1) {
+                    printMessage("cppcheck: argument to '--valueflow-jobs=' must be greater than 0.");
+                    return false;
+                }
+            }
+
             // Force checking of files that have "too many" configurations
             else if (std::strcmp(argv[i], "-f") == 0 || std::strcmp(argv[i], "--force") == 0)
                 mSettings->force = true;
@@ -486,6 +551,20 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
                 }
             }
 
+            // Number of configurations of a file that are checked at the same time
+            else if (std::strncmp(argv[i], "--config-jobs=", 14) == 0) {
+                std::istringstream iss(14+argv[i]);
+                if (!(iss >> mSettings->configJobs)) {
+                    printMessage("cppcheck: argument to '--config-jobs=' is not a number.");
+                    return false;
+                }
+
+                if (mSettings->configJobs < 1) {
+                    printMessage("cppcheck: argument to '--config-jobs=' must be greater than 0.");
+                    return false;
+                }
+            }
+
             // file list specified
             else if (std::strncmp(argv[i], "--file-list=", 12) == 0) {
                 // open this file and read every input file (1 file name per line)
@@ -853,6 +932,11 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
                 maxconfigs = true;
             }
 
+            else if (std::strncmp(argv[i], "--worker=", 9) == 0) {
+                mSettings->distributedRole = Settings::DISTRIBUTED_WORKER;
+                mSettings->distributedAddress = argv[i] + 9;
+            }
+
             // Print help
             else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
                 mPathNames.clear();
@@ -889,6 +973,17 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
         printMessage("cppcheck: unusedFunction check can't be used with '-j' option. Disabling unusedFunction check.");
     }
 
+    if (mSettings->distributedRole != Settings::DISTRIBUTED_NONE) {
+        if (mSettings->distributedAddress.empty()) {
+            printMessage("cppcheck: error: no address given to '--coordinator' or '--worker'.");
+            return false;
+        }
+        if (mSettings->buildDir.empty()) {
+            printMessage("cppcheck: error: '--coordinator' and '--worker' require '--cppcheck-build-dir'.");
+            return false;
+        }
+    }
+
     if (argc <= 1) {
         mShowHelp = true;
         mExitAfterPrint = true;
@@ -900,7 +995,9 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
     }
 
     // Print error only if we have "real" command and expect files
-    if (!mExitAfterPrint && mPathNames.empty() && mSettings->project.fileSettings.empty()) {
+    // Workers get the files from the coordinator
+    if (!mExitAfterPrint && mPathNames.empty() && mSettings->project.fileSettings.empty() &&
+        mSettings->distributedRole != Settings::DISTRIBUTED_WORKER) {
         printMessage("cppcheck: No C or C++ source files found.");
         return false;
     }
@@ -924,6 +1021,16 @@ void CmdLineParser::printHelp()
               "Options:\n"
               "    --addon=<addon>\n"
               "                         Execute addon. i.e. cert.\n"
+              "    --coordinator=<address>\n"
+              "                         Distribute the files to worker processes that are\n"
+              "                         started with --worker=<address>, on this or other\n"
+              "                         machines. The address is 'unix:<path>' for a local\n"
+              "                         socket, or '<host>:<port>' or '<port>' for TCP.\n"
+              "                         Without a host only loopback connections are\n"
+              "                         accepted, listening on other interfaces requires\n"
+              "                         --distributed-token-file.\n"
+              "                         Requires --cppcheck-build-dir. The workers must see\n"
+              "                         the files at the same paths and use the same options.\n"
               "    --cppcheck-build-dir=<dir>\n"
               "                         Analysis output directory. Useful for various data.\n"
               "                         Some possible usages are; whole program analysis,\n"
@@ -939,6 +1046,19 @@ void CmdLineParser::printHelp()
               "                         be considered for evaluation.\n"
               "    --config-excludes-file=<file>\n"
               "                         A file that contains a list of config-excludes\n"
+              "    --config-jobs=<jobs> Check up to <jobs> preprocessor configurations of a\n"
+              "                         file at the same time on worker threads. The results\n"
+              "                         are the same as when they are checked one by one.\n"
+              "                         Not used together with --dump, --addon and --rule.\n"
+              "    --distributed-timeout=<seconds>\n"
+              "                         Give the file of a worker to another worker when\n"
+              "                         the worker has not been heard from for this many\n"
+              "                         seconds. Workers report while checking a file, so\n"
+              "                         long files are not affected. Default is '30'.\n"
+              "    --distributed-token-file=<file>\n"
+              "                         The first line of <file> is a secret token that the\n"
+              "                         coordinator and its workers share. Workers that\n"
+              "                         don't know the token are rejected.\n"
               "    --doc                Print a list of all available checks.\n"
               "    --dump               Dump xml data for each translation unit. The dump\n"
               "                         files have the extension .dump and contain ast,\n"
@@ -987,6 +1107,13 @@ void CmdLineParser::printHelp()
               "    --exitcode-suppressions=<file>\n"
               "                         Used when certain messages should be displayed but\n"
               "                         should not cause a non-zero exitcode.\n"
+#ifdef THREADING_MODEL_FORK
+              "    --executor=<type>    How the checking is distributed when -j is used:\n"
+              "                          * thread\n"
+              "                                 Check files in long-lived worker threads\n"
+              "                          * process\n"
+              "                                 Fork one child process per file (default)\n"
+#endif
               "    --file-list=<file>   Specify the files to check in a text file. Add one\n"
               "                         filename per line. When file is '-,' the file list will\n"
               "                         be read from standard input.\n"
@@ -1152,8 +1279,20 @@ void CmdLineParser::printHelp()
               "                           \\r         insert carriage return\n"
               "                         Example format (gcc-like):\n"
               "                         '{file}:{line}:{column}: note: {info}\\n{code}'\n"
+              "    --valueflow-jobs=<jobs>\n"
+              "                         Analyse up to <jobs> functions of a configuration at\n"
+              "                         the same time on worker threads in the ValueFlow\n"
+              "                         analysis. Default is '1'.\n"
+              "    --valueflow-max-time=<seconds>\n"
+              "                         Maximum time that the ValueFlow analysis of a\n"
+              "                         configuration repeats its passes to find more\n"
+              "                         values. Default is '10'. Use 0 for no limit.\n"
               "    -v, --verbose        Output more detailed error information.\n"
               "    --version            Print out version number.\n"
+              "    --worker=<address>   Check files for the coordinator that listens on\n"
+              "                         <address>, see --coordinator. Requires\n"
+              "                         --cppcheck-build-dir, the worker keeps its own\n"
+              "                         analysis results there. No paths are given.\n"
               "    --xml                Write results in xml format to error stream (stderr).\n"
               "    --xml-version=<version>\n"
               "                         Select the XML file version. Currently only versions 2 is available."
@@ -22,6 +22,7 @@
 #include "cmdlineparser.h"
 #include "config.h"
 #include "cppcheck.h"
+#include "distributedexecutor.h"
 #include "filelister.h"
 #include "importproject.h"
 #include "library.h"
@@ -165,7 +166,7 @@ bool CppCheckExecutor::parseFromArgs(CppCheck *cppcheck, int argc, const char* c
             FileLister::recursiveAddFiles(_files, Path::toNativeSeparators(pathname), _settings->library.markupExtensions(), matcher);
     }
 
-    if (_files.empty() && settings.project.fileSettings.empty()) {
+    if (_files.empty() && settings.project.fileSettings.empty() && settings.distributedRole != Settings::DISTRIBUTED_WORKER) {
         std::cout << "cppcheck: error: could not find or open any of the paths given." << std::endl;
         if (!ignored.empty())
             std::cout << "cppcheck: Maybe all paths were ignored?" << std::endl;
@@ -293,7 +294,7 @@ static void print_stacktrace(FILE* output, bool demangling, int maxdepth, bool l
 #endif
 }
 
-static const size_t MYSTACKSIZE = 16*1024+SIGSTKSZ; // wild guess about a reasonable buffer
+static const size_t MYSTACKSIZE = 16*1024+32768; // wild guess about a reasonable buffer (SIGSTKSZ is not a constant expression with newer glibc)
 static char mytstack[MYSTACKSIZE]= {0}; // alternative stack for signal handler
 static bool bStackBelowHeap=false; // lame attempt to locate heap vs. stack address space. See CppCheckExecutor::check_wrapper()
 
@@ -878,6 +879,12 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
         return EXIT_FAILURE;
     }
 
+    if (settings.distributedRole == Settings::DISTRIBUTED_WORKER) {
+        // The results are sent to the coordinator
+        DistributedWorker worker(settings);
+        return worker.run();
+    }
+
     if (settings.reportProgress)
         latestProgressOutputTime = std::time(nullptr);
 
@@ -897,7 +904,14 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
     }
 
     unsigned int returnValue = 0;
-    if (settings.jobs == 1) {
+    if (settings.distributedRole == Settings::DISTRIBUTED_COORDINATOR) {
+        if (DistributedExecutor::isEnabled()) {
+            DistributedExecutor executor(_files, settings, *this);
+            returnValue = executor.check();
+        } else {
+            std::cout << "No distributed analysis support yet implemented for this platform." << std::endl;
+        }
+    } else if (settings.jobs == 1) {
         // Single process
         settings.jointSuppressionReport = true;
 
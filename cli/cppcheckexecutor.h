@@ -91,8 +91,8 @@ public:
      *
      * @param fileindex This many files have been checked.
      * @param filecount This many files there are in total.
-     * @param sizedone The sum of sizes of the files checked.
-     * @param sizetotal The total sizes of the files.
+     * @param sizedone The sum of sizes (or estimated costs) of the files checked.
+     * @param sizetotal The total sizes (or estimated costs) of the files.
      */
     static void reportStatus(std::size_t fileindex, std::size_t filecount, std::size_t sizedone, std::size_t sizetotal);
 
@@ -0,0 +1,860 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "distributedexecutor.h"
+
+#include "analyzerinfo.h"
+#include "config.h"
+#include "cppcheck.h"
+#include "cppcheckexecutor.h"
+#include "framing.h"
+#include "importproject.h"
+#include "path.h"
+#include "settings.h"
+#include "suppressions.h"
+#include "utils.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#ifdef THREADING_MODEL_FORK
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+DistributedExecutor::DistributedExecutor(const std::map<std::string, std::size_t> &files, Settings &settings, ErrorLogger &errorLogger)
+    : _files(files), _settings(settings), _errorLogger(errorLogger)
+{
+}
+
+DistributedWorker::DistributedWorker(Settings &settings)
+    : _settings(settings), _socket(-1)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+////// This code is for platforms that support fork() only ////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(THREADING_MODEL_FORK)
+
+bool DistributedExecutor::isEnabled()
+{
+    return true;
+}
+
+/** A lost peer must not kill the process with SIGPIPE */
+static void disableSigPipe(int fd)
+{
+#ifdef SO_NOSIGPIPE
+    const int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+    UNUSED(fd);
+#endif
+}
+
+/** A file is given to this many workers before it is reported as not checked */
+static const unsigned int MAX_ATTEMPTS = 3;
+
+/** A worker sends a KEEPALIVE message this often while it checks a file */
+static const std::chrono::seconds KEEPALIVE_INTERVAL(1);
+
+/** Read what is available from the socket, false on end of file or error */
+static bool readSocket(int fd, std::string &buffer)
+{
+    char buf[65536];
+    for (;;) {
+        const ssize_t res = ::recv(fd, buf, sizeof(buf), 0);
+        if (res < 0 && errno == EINTR)
+            continue;
+        if (res <= 0)
+            return false;
+        buffer.append(buf, res);
+        return true;
+    }
+}
+
+/**
+ * Take the first frame from the buffer.
+ * @return -1 if the frame is invalid, 0 if it is not complete and 1 if it was taken
+ */
+static int takeFrame(std::string &buffer, char *type, std::string *payload)
+{
+    std::size_t len;
+    const int frame = Framing::peekFrame(buffer, 0, type, &len);
+    if (frame <= 0)
+        return frame;
+    payload->assign(buffer, Framing::HEADER_SIZE, len);
+    buffer.erase(0, Framing::HEADER_SIZE + len);
+    return 1;
+}
+
+static void appendStrings(std::string &out, const std::list<std::string> &strings)
+{
+    Framing::appendInt(out, static_cast<unsigned int>(strings.size()));
+    for (const std::string &s : strings)
+        Framing::appendString(out, s);
+}
+
+static std::list<std::string> readStrings(Framing::PayloadReader &reader)
+{
+    std::list<std::string> strings;
+    const unsigned int count = reader.readInt();
+    for (unsigned int i = 0; i < count && !reader.error(); ++i)
+        strings.push_back(reader.readString());
+    return strings;
+}
+
+/** Binary form of an error message, unlike the xml form nothing is lost */
+static std::string encodeMessage(const ErrorLogger::ErrorMessage &msg)
+{
+    std::string payload;
+    Framing::appendMessage(payload, msg, Framing::appendString);
+    return payload;
+}
+
+static bool decodeMessage(const std::string &payload, ErrorLogger::ErrorMessage *msg)
+{
+    Framing::PayloadReader reader(payload.data(), payload.size());
+    const auto readName = [](Framing::PayloadReader &r) {
+        return r.readString();
+    };
+    return Framing::readMessage(reader, msg, readName);
+}
+
+static bool isUnixAddress(const std::string &address)
+{
+    return address.compare(0, 5, "unix:") == 0;
+}
+
+/** Split "<host>:<port>" or "<port>", the host is empty if it is not given. An IPv6 host is written as "[<host>]" */
+static void splitAddress(const std::string &address, std::string *host, std::string *port)
+{
+    const std::string::size_type pos = address.rfind(':');
+    if (pos == std::string::npos) {
+        host->clear();
+        *port = address;
+    } else {
+        *host = address.substr(0, pos);
+        *port = address.substr(pos + 1);
+        if (host->size() >= 2 && (*host)[0] == '[' && endsWith(*host, ']'))
+            *host = host->substr(1, host->size() - 2);
+    }
+}
+
+/** Is the coordinator only reachable from this machine? */
+static bool isLocalAddress(const std::string &address)
+{
+    if (isUnixAddress(address))
+        return true;
+    std::string host, port;
+    splitAddress(address, &host, &port);
+    return host.empty() || host == "localhost" || host.compare(0, 4, "127.") == 0 || host == "::1";
+}
+
+/** Compare tokens, the time does not tell how much of the token is right */
+static bool sameToken(const std::string &token1, const std::string &token2)
+{
+    if (token1.size() != token2.size())
+        return false;
+    unsigned char diff = 0;
+    for (std::string::size_type i = 0; i < token1.size(); ++i)
+        diff |= static_cast<unsigned char>(token1[i] ^ token2[i]);
+    return diff == 0;
+}
+
+static bool unixSocketAddress(const std::string &address, struct sockaddr_un *addr, std::string *errmsg)
+{
+    const std::string path = address.substr(5);
+    std::memset(addr, 0, sizeof(*addr));
+    if (path.empty() || path.size() >= sizeof(addr->sun_path)) {
+        *errmsg = "invalid socket path '" + path + "'";
+        return false;
+    }
+    addr->sun_family = AF_UNIX;
+    std::memcpy(addr->sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+static int listenOn(const std::string &address, std::string *errmsg)
+{
+    if (isUnixAddress(address)) {
+        struct sockaddr_un addr;
+        if (!unixSocketAddress(address, &addr, errmsg))
+            return -1;
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            *errmsg = std::string("socket() failed: ") + std::strerror(errno);
+            return -1;
+        }
+        // Remove the socket of an earlier run
+        unlink(addr.sun_path);
+        if (bind(fd, reinterpret_cast<const struct sockaddr *>(&addr), sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+            *errmsg = "failed to listen on '" + address + "': " + std::strerror(errno);
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    std::string host, port;
+    splitAddress(address, &host, &port);
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    // Other machines can only connect if the host is given, for instance
+    // "0.0.0.0" to listen on all interfaces
+    if (host.empty())
+        host = "127.0.0.1";
+    struct addrinfo *result = nullptr;
+    const int err = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+    if (err != 0) {
+        *errmsg = "invalid address '" + address + "': " + gai_strerror(err);
+        return -1;
+    }
+    int fd = -1;
+    for (const struct addrinfo *ai = result; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0)
+            continue;
+        const int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) < 0 || listen(fd, SOMAXCONN) < 0) {
+            *errmsg = "failed to listen on '" + address + "': " + std::strerror(errno);
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(result);
+    return fd;
+}
+
+static int connectTo(const std::string &address, std::string *errmsg)
+{
+    if (isUnixAddress(address)) {
+        struct sockaddr_un addr;
+        if (!unixSocketAddress(address, &addr, errmsg))
+            return -1;
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            *errmsg = std::string("socket() failed: ") + std::strerror(errno);
+            return -1;
+        }
+        if (connect(fd, reinterpret_cast<const struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+            *errmsg = "failed to connect to '" + address + "': " + std::strerror(errno);
+            close(fd);
+            return -1;
+        }
+        disableSigPipe(fd);
+        return fd;
+    }
+
+    std::string host, port;
+    splitAddress(address, &host, &port);
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *result = nullptr;
+    const int err = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result);
+    if (err != 0) {
+        *errmsg = "invalid address '" + address + "': " + gai_strerror(err);
+        return -1;
+    }
+    int fd = -1;
+    for (const struct addrinfo *ai = result; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0)
+            continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) < 0) {
+            *errmsg = "failed to connect to '" + address + "': " + std::strerror(errno);
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(result);
+    if (fd >= 0) {
+        // The worker waits for work, find out if the coordinator machine is gone
+        const int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+        disableSigPipe(fd);
+    }
+    return fd;
+}
+
+/** Wall time since @p start in microseconds */
+static unsigned long long elapsedTime(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool readFile(const std::string &filename, std::string *content)
+{
+    std::ifstream fin(filename, std::ios::binary);
+    if (!fin.is_open())
+        return false;
+    content->assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/** Analyzerinfo files are written by the coordinator, a name must not point out of the build dir */
+static bool validAnalyzerInfoName(const std::string &name)
+{
+    return !name.empty() && name != "." && name != ".." && name.find_first_of("/\\") == std::string::npos;
+}
+
+std::string DistributedExecutor::workPayload(const ThreadExecutor::ScheduledFile &file, const std::string &analyzerInfoName) const
+{
+    std::string payload;
+    const ImportProject::FileSettings *fs = file.fileSettings;
+    Framing::appendString(payload, fs ? fs->filename : *file.file);
+    Framing::appendString(payload, analyzerInfoName);
+    Framing::appendInt(payload, fs ? 1U : 0U);
+    if (fs) {
+        Framing::appendString(payload, fs->cfg);
+        Framing::appendString(payload, fs->defines);
+        appendStrings(payload, std::list<std::string>(fs->undefs.begin(), fs->undefs.end()));
+        appendStrings(payload, fs->includePaths);
+        appendStrings(payload, fs->systemIncludePaths);
+        Framing::appendString(payload, fs->standard);
+        Framing::appendInt(payload, fs->platformType);
+        Framing::appendInt(payload, fs->msc ? 1U : 0U);
+        Framing::appendInt(payload, fs->useMfc ? 1U : 0U);
+    }
+    return payload;
+}
+
+void DistributedExecutor::report(const ErrorLogger::ErrorMessage &msg, MessageType type)
+{
+    if (_settings.nomsg.isSuppressed(msg.toSuppressionsErrorMessage()))
+        return;
+
+    // Alert only about unique errors
+    if (!_errorList.insert(msg.toString(_settings.verbose)).second)
+        return;
+
+    if (type == REPORT_ERROR)
+        _errorLogger.reportErr(msg);
+    else
+        _errorLogger.reportInfo(msg);
+}
+
+namespace {
+    /** Message of a worker, reported when the file is done */
+    struct WorkerMessage {
+        explicit WorkerMessage(DistributedExecutor::MessageType t) : type(t) {}
+
+        DistributedExecutor::MessageType type;
+        std::string outmsg;
+        ErrorLogger::ErrorMessage msg;
+    };
+
+    struct WorkerConnection {
+        WorkerConnection() : fd(-1), hello(false), item(0), busy(false) {}
+
+        int fd;
+        std::string buffer;
+        bool hello;
+
+        /** Index of the file in the schedule */
+        std::size_t item;
+        bool busy;
+        std::chrono::steady_clock::time_point start;
+
+        /** When something was last read from the worker */
+        std::chrono::steady_clock::time_point lastActivity;
+
+        /**
+         * The results are held back until the file is done, so nothing is
+         * reported twice if the worker is lost and the file is checked again
+         */
+        std::vector<WorkerMessage> messages;
+        std::string analyzerInfo;
+    };
+}
+
+unsigned int DistributedExecutor::check()
+{
+    std::map<std::string, unsigned long long> fileTimes = AnalyzerInformation::readFileTimes(_settings.buildDir);
+    _schedule = ThreadExecutor::scheduleFiles(_files, _settings.project.fileSettings, fileTimes);
+    std::size_t totalCost = 0;
+    for (std::vector<ThreadExecutor::ScheduledFile>::const_iterator f = _schedule.begin(); f != _schedule.end(); ++f)
+        totalCost += f->cost;
+
+    // The workers write the analyzerinfo files with the names of files.txt
+    // of the coordinator, so the whole program analysis finds them
+    std::vector<std::string> analyzerInfoNames;
+    for (std::vector<ThreadExecutor::ScheduledFile>::const_iterator f = _schedule.begin(); f != _schedule.end(); ++f) {
+        const std::string sourcefile = Path::simplifyPath(Path::fromNativeSeparators(f->fileSettings ? f->fileSettings->filename : *f->file));
+        const std::string analyzerInfoFile = AnalyzerInformation::getAnalyzerInfoFile(_settings.buildDir, sourcefile, f->fileSettings ? f->fileSettings->cfg : emptyString);
+        analyzerInfoNames.push_back(analyzerInfoFile.substr(analyzerInfoFile.rfind('/') + 1));
+    }
+
+    if (_settings.distributedToken.empty() && !isLocalAddress(_settings.distributedAddress)) {
+        std::cerr << "cppcheck: error: a coordinator that listens on '" << _settings.distributedAddress << "' requires '--distributed-token-file'." << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::string errmsg;
+    const int listenSocket = listenOn(_settings.distributedAddress, &errmsg);
+    if (listenSocket < 0) {
+        std::cerr << "cppcheck: error: " << errmsg << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    if (!_settings.quiet)
+        _errorLogger.reportOut("Waiting for workers on " + _settings.distributedAddress);
+
+    std::deque<std::size_t> queue;
+    for (std::size_t i = 0; i < _schedule.size(); ++i)
+        queue.push_back(i);
+    std::vector<unsigned int> attempts(_schedule.size(), 0);
+
+    std::list<WorkerConnection> workers;
+    unsigned int result = 0;
+    std::size_t fileCount = 0;
+    std::size_t processedCost = 0;
+
+    const auto fileDone = [&](std::size_t item) {
+        ++fileCount;
+        processedCost += _schedule[item].cost;
+        if (!_settings.quiet)
+            CppCheckExecutor::reportStatus(fileCount, _schedule.size(), processedCost, totalCost);
+    };
+
+    const auto loseWorker = [&](std::list<WorkerConnection>::iterator w, const std::string &reason) {
+        close(w->fd);
+        if (w->busy) {
+            const std::size_t item = w->item;
+            const ThreadExecutor::ScheduledFile &file = _schedule[item];
+            const std::string &filename = file.fileSettings ? file.fileSettings->filename : *file.file;
+            if (++attempts[item] < MAX_ATTEMPTS) {
+                if (!_settings.quiet)
+                    _errorLogger.reportOut(reason + ", " + filename + " is checked again");
+                queue.push_front(item);
+            } else {
+                std::list<ErrorLogger::ErrorMessage::FileLocation> locations;
+                locations.emplace_back(filename, 0);
+                const ErrorLogger::ErrorMessage msg(locations,
+                                                    emptyString,
+                                                    Severity::error,
+                                                    "Internal error: Lost connection to the workers checking the file",
+                                                    "cppcheckError",
+                                                    false);
+                report(msg, REPORT_ERROR);
+                fileDone(item);
+            }
+        }
+        return workers.erase(w);
+    };
+
+    const std::chrono::seconds timeout(_settings.distributedTimeout);
+    const std::string timeoutReason = "A worker did not respond for " + std::to_string(_settings.distributedTimeout) + " seconds";
+    const std::string lostReason = "Lost connection to a worker";
+
+    while (fileCount < _schedule.size()) {
+        // A busy worker sends KEEPALIVE messages, one that is silent is lost
+        // even if the connection is not closed, for instance if it hangs or
+        // its machine is gone
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        for (std::list<WorkerConnection>::iterator w = workers.begin(); w != workers.end();) {
+            if ((w->busy || !w->hello) && now - w->lastActivity > timeout)
+                w = loseWorker(w, timeoutReason);
+            else
+                ++w;
+        }
+
+        // Give files to idle workers
+        for (std::list<WorkerConnection>::iterator w = workers.begin(); w != workers.end();) {
+            if (!w->hello || w->busy || queue.empty()) {
+                ++w;
+                continue;
+            }
+            w->item = queue.front();
+            queue.pop_front();
+            w->busy = true;
+            w->start = std::chrono::steady_clock::now();
+            w->lastActivity = w->start;
+            std::string out;
+            Framing::appendFrame(out, WORK, workPayload(_schedule[w->item], analyzerInfoNames[w->item]));
+            if (Framing::writeAll(w->fd, out, true))
+                ++w;
+            else
+                w = loseWorker(w, lostReason);
+        }
+
+        std::vector<struct pollfd> fds;
+        struct pollfd pfd;
+        pfd.fd = listenSocket;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        fds.push_back(pfd);
+        for (std::list<WorkerConnection>::const_iterator w = workers.begin(); w != workers.end(); ++w) {
+            pfd.fd = w->fd;
+            fds.push_back(pfd);
+        }
+        const int r = poll(fds.data(), fds.size(), 1000);
+        if (r < 0 && errno != EINTR) {
+            std::cerr << "#### DistributedExecutor::check, poll() failed: " << std::strerror(errno) << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        if (r <= 0)
+            continue;
+
+        std::size_t index = 1;
+        for (std::list<WorkerConnection>::iterator w = workers.begin(); w != workers.end(); ++index) {
+            if (fds[index].revents == 0) {
+                ++w;
+                continue;
+            }
+            bool lost = !readSocket(w->fd, w->buffer);
+            w->lastActivity = std::chrono::steady_clock::now();
+
+            // Handle the complete frames, also when the worker has closed the connection
+            char type;
+            std::string payload;
+            int frame;
+            while (!lost && (frame = takeFrame(w->buffer, &type, &payload)) != 0) {
+                if (frame < 0) {
+                    lost = true;
+                    break;
+                }
+                if (!w->hello) {
+                    Framing::PayloadReader reader(payload.data(), payload.size());
+                    const std::string version = reader.readString();
+                    const std::string token = reader.readString();
+                    if (type != HELLO || reader.error() || !sameToken(token, _settings.distributedToken)) {
+                        _errorLogger.reportOut("Rejected worker that does not know the token of the coordinator");
+                        lost = true;
+                        break;
+                    }
+                    if (version != CppCheck::version()) {
+                        _errorLogger.reportOut("Rejected worker with Cppcheck version " + version +
+                                               ", the version of the coordinator is " + CppCheck::version());
+                        lost = true;
+                        break;
+                    }
+                    w->hello = true;
+                } else if (type == KEEPALIVE) {
+                    // Also accepted from an idle worker, it may have been sent before WORK_DONE
+                } else if (!w->busy) {
+                    lost = true;
+                } else if (type == REPORT_OUT) {
+                    w->messages.emplace_back(REPORT_OUT);
+                    w->messages.back().outmsg = payload;
+                } else if (type == REPORT_ERROR || type == REPORT_INFO) {
+                    w->messages.emplace_back(static_cast<MessageType>(type));
+                    lost = !decodeMessage(payload, &w->messages.back().msg);
+                } else if (type == ANALYZER_INFO) {
+                    w->analyzerInfo = payload;
+                } else if (type == WORK_DONE) {
+                    Framing::PayloadReader reader(payload.data(), payload.size());
+                    const unsigned int fileResult = reader.readInt();
+                    Framing::readMissingIncludes(reader);
+                    if (reader.error()) {
+                        lost = true;
+                        break;
+                    }
+                    for (const WorkerMessage &m : w->messages) {
+                        if (m.type == REPORT_OUT)
+                            _errorLogger.reportOut(m.outmsg);
+                        else
+                            report(m.msg, m.type);
+                    }
+                    const std::string analyzerInfoFile = _settings.buildDir + '/' + analyzerInfoNames[w->item];
+                    if (w->analyzerInfo.empty()) {
+                        std::remove(analyzerInfoFile.c_str());
+                    } else {
+                        std::ofstream fout(analyzerInfoFile, std::ios::binary);
+                        fout << w->analyzerInfo;
+                    }
+                    result += fileResult;
+                    fileTimes[_schedule[w->item].key()] = elapsedTime(w->start);
+                    w->busy = false;
+                    w->messages.clear();
+                    w->analyzerInfo.clear();
+                    fileDone(w->item);
+                } else {
+                    lost = true;
+                }
+            }
+
+            if (lost)
+                w = loseWorker(w, lostReason);
+            else
+                ++w;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            const int fd = accept(listenSocket, nullptr, nullptr);
+            if (fd >= 0) {
+                disableSigPipe(fd);
+                workers.emplace_back();
+                workers.back().fd = fd;
+                workers.back().lastActivity = std::chrono::steady_clock::now();
+            }
+        }
+    }
+
+    // The workers stop when the connection is closed
+    for (std::list<WorkerConnection>::const_iterator w = workers.begin(); w != workers.end(); ++w)
+        close(w->fd);
+    close(listenSocket);
+    if (isUnixAddress(_settings.distributedAddress))
+        unlink(_settings.distributedAddress.c_str() + 5);
+
+    AnalyzerInformation::writeFileTimes(_settings.buildDir, fileTimes);
+
+    return result;
+}
+
+namespace {
+    /** Calls a function every KEEPALIVE_INTERVAL on another thread until it is destroyed */
+    class Heartbeat {
+    public:
+        explicit Heartbeat(const std::function<void()> &beat) : mStop(false), mThread(&Heartbeat::run, this, beat) {}
+
+        ~Heartbeat() {
+            {
+                std::lock_guard<std::mutex> lock(mSync);
+                mStop = true;
+            }
+            mStopped.notify_one();
+            mThread.join();
+        }
+
+    private:
+        void run(const std::function<void()> &beat) {
+            std::unique_lock<std::mutex> lock(mSync);
+            const auto stopped = [this]() {
+                return mStop;
+            };
+            while (!mStopped.wait_for(lock, KEEPALIVE_INTERVAL, stopped))
+                beat();
+        }
+
+        std::mutex mSync;
+        std::condition_variable mStopped;
+        bool mStop;
+        std::thread mThread;
+    };
+}
+
+int DistributedWorker::run()
+{
+    // The coordinator may not be listening yet
+    std::string errmsg;
+    for (int attempt = 0; attempt < 100 && _socket < 0; ++attempt) {
+        if (attempt > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        _socket = connectTo(_settings.distributedAddress, &errmsg);
+    }
+    if (_socket < 0) {
+        std::cerr << "cppcheck: error: " << errmsg << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // files.txt maps the files of the coordinator to the analyzerinfo files
+    {
+        std::ofstream fout(_settings.buildDir + "/files.txt");
+    }
+    _filesTxt.clear();
+
+    std::string hello;
+    Framing::appendString(hello, CppCheck::version());
+    Framing::appendString(hello, _settings.distributedToken);
+    if (send(DistributedExecutor::HELLO, hello)) {
+        CppCheck cppcheck(*this, false);
+        cppcheck.settings() = _settings;
+
+        std::string buffer;
+        for (;;) {
+            char type;
+            std::string payload;
+            const int frame = takeFrame(buffer, &type, &payload);
+            if (frame < 0)
+                break;
+            if (frame == 0) {
+                if (!readSocket(_socket, buffer))
+                    break;
+                continue;
+            }
+            if (type != DistributedExecutor::WORK || !work(cppcheck, payload))
+                break;
+        }
+    }
+
+    close(_socket);
+    _socket = -1;
+    return EXIT_SUCCESS;
+}
+
+bool DistributedWorker::work(CppCheck &cppcheck, const std::string &payload)
+{
+    Framing::PayloadReader reader(payload.data(), payload.size());
+    const std::string filename = reader.readString();
+    const std::string analyzerInfoName = reader.readString();
+    const bool hasFileSettings = reader.readInt() != 0;
+    ImportProject::FileSettings fs;
+    if (hasFileSettings) {
+        fs.filename = filename;
+        fs.cfg = reader.readString();
+        fs.defines = reader.readString();
+        const std::list<std::string> undefs = readStrings(reader);
+        fs.undefs.insert(undefs.begin(), undefs.end());
+        fs.includePaths = readStrings(reader);
+        fs.systemIncludePaths = readStrings(reader);
+        fs.standard = reader.readString();
+        fs.platformType = static_cast<cppcheck::Platform::PlatformType>(reader.readInt());
+        fs.msc = reader.readInt() != 0;
+        fs.useMfc = reader.readInt() != 0;
+    }
+    if (reader.error() || !validAnalyzerInfoName(analyzerInfoName))
+        return false;
+
+    // Use the analyzerinfo file name of the coordinator
+    const std::string line = analyzerInfoName + ':' + fs.cfg + ':' + Path::simplifyPath(Path::fromNativeSeparators(filename));
+    if (_filesTxt.insert(line).second) {
+        std::ofstream fout(_settings.buildDir + "/files.txt", std::ios::app);
+        fout << line << '\n';
+    }
+
+    unsigned int result = 0;
+    {
+        // Tell the coordinator that the file is still being checked
+        const Heartbeat heartbeat([this]() {
+            send(DistributedExecutor::KEEPALIVE, emptyString);
+        });
+        try {
+            if (hasFileSettings)
+                result = cppcheck.check(fs);
+            else
+                result = cppcheck.check(filename);
+        } catch (const std::exception &e) {
+            std::list<ErrorLogger::ErrorMessage::FileLocation> locations;
+            locations.emplace_back(filename, 0);
+            const ErrorLogger::ErrorMessage errmsg(locations,
+                                                   emptyString,
+                                                   Severity::error,
+                                                   std::string("Internal error: Worker caught exception: ") + e.what(),
+                                                   "cppcheckError",
+                                                   false);
+            reportErr(errmsg);
+        }
+    }
+
+    std::string analyzerInfo;
+    readFile(_settings.buildDir + '/' + analyzerInfoName, &analyzerInfo);
+    std::string done;
+    Framing::appendInt(done, result);
+    Framing::appendMissingIncludes(done);
+    return send(DistributedExecutor::ANALYZER_INFO, analyzerInfo) &&
+           send(DistributedExecutor::WORK_DONE, done);
+}
+
+bool DistributedWorker::send(DistributedExecutor::MessageType type, const std::string &payload)
+{
+    std::string out;
+    Framing::appendFrame(out, static_cast<char>(type), payload);
+    std::lock_guard<std::mutex> lock(_sendSync);
+    return Framing::writeAll(_socket, out, true);
+}
+
+void DistributedWorker::reportOut(const std::string &outmsg)
+{
+    send(DistributedExecutor::REPORT_OUT, outmsg);
+}
+
+void DistributedWorker::reportErr(const ErrorLogger::ErrorMessage &msg)
+{
+    send(DistributedExecutor::REPORT_ERROR, encodeMessage(msg));
+}
+
+void DistributedWorker::reportInfo(const ErrorLogger::ErrorMessage &msg)
+{
+    send(DistributedExecutor::REPORT_INFO, encodeMessage(msg));
+}
+
+#else
+
+bool DistributedExecutor::isEnabled()
+{
+    return false;
+}
+
+unsigned int DistributedExecutor::check()
+{
+    return 0;
+}
+
+std::string DistributedExecutor::workPayload(const ThreadExecutor::ScheduledFile &, const std::string &) const
+{
+    return std::string();
+}
+
+void DistributedExecutor::report(const ErrorLogger::ErrorMessage &, MessageType)
+{
+}
+
+int DistributedWorker::run()
+{
+    std::cerr << "cppcheck: error: distributed analysis is not supported on this platform" << std::endl;
+    return EXIT_FAILURE;
+}
+
+bool DistributedWorker::work(CppCheck &, const std::string &)
+{
+    return false;
+}
+
+bool DistributedWorker::send(DistributedExecutor::MessageType, const std::string &)
+{
+    return false;
+}
+
+void DistributedWorker::reportOut(const std::string &)
+{
+}
+
+void DistributedWorker::reportErr(const ErrorLogger::ErrorMessage &)
+{
+}
+
+void DistributedWorker::reportInfo(const ErrorLogger::ErrorMessage &)
+{
+}
+
+#endif
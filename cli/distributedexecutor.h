@@ -0,0 +1,149 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DISTRIBUTEDEXECUTOR_H
+#define DISTRIBUTEDEXECUTOR_H
+
+#include "errorlogger.h"
+#include "threadexecutor.h"
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+class CppCheck;
+class Settings;
+
+/// @addtogroup CLI
+/// @{
+
+/**
+ * Coordinator of distributed analysis (--coordinator=<address>).
+ *
+ * The coordinator owns the file list and the build dir. Worker processes,
+ * see DistributedWorker, connect to the address and are given one file at
+ * a time. A worker sends back the messages of the file and its
+ * analyzerinfo file, which contains the whole program analysis data. The
+ * coordinator writes the analyzerinfo file to its build dir so the whole
+ * program analysis can be done when all files are checked. If a worker
+ * is lost its file is given to another worker. A worker sends KEEPALIVE
+ * messages while it checks a file, a worker that has been silent for
+ * Settings::distributedTimeout seconds is treated as lost.
+ *
+ * The address is "unix:<path>" for a Unix socket, or "<host>:<port>" or
+ * "<port>" for TCP. Without a host the coordinator listens on loopback
+ * only. Listening on other interfaces requires Settings::distributedToken,
+ * a worker that does not send the token in its HELLO message is rejected.
+ * The workers must see the source files at the same paths as the
+ * coordinator and use the same options.
+ *
+ * Messages are frames written with the Framing functions.
+ */
+class DistributedExecutor {
+public:
+    DistributedExecutor(const std::map<std::string, std::size_t> &files, Settings &settings, ErrorLogger &errorLogger);
+    unsigned int check();
+
+    /** @brief Message types of the protocol */
+    enum MessageType {
+        HELLO='H',          ///< worker to coordinator, version of cppcheck and token
+        WORK='W',           ///< coordinator to worker, file to check
+        REPORT_OUT='O',     ///< worker to coordinator, output text
+        REPORT_ERROR='E',   ///< worker to coordinator, error message
+        REPORT_INFO='I',    ///< worker to coordinator, information message
+        ANALYZER_INFO='A',  ///< worker to coordinator, content of the analyzerinfo file
+        WORK_DONE='D',      ///< worker to coordinator, result of the check
+        KEEPALIVE='K'       ///< worker to coordinator, the file is still being checked
+    };
+
+    /**
+     * @return true if distributed analysis is supported on this platform
+     */
+    static bool isEnabled();
+
+private:
+    const std::map<std::string, std::size_t> &_files;
+    Settings &_settings;
+    ErrorLogger &_errorLogger;
+
+    std::vector<ThreadExecutor::ScheduledFile> _schedule;
+
+    /** @brief Messages that have been reported, to alert only about unique errors */
+    std::set<std::string> _errorList;
+
+    /** @brief Payload of WORK message for a file, the analyzerinfo file name is taken from files.txt */
+    std::string workPayload(const ThreadExecutor::ScheduledFile &file, const std::string &analyzerInfoName) const;
+
+    /** @brief Report a message of a worker, unless it is suppressed or has already been reported */
+    void report(const ErrorLogger::ErrorMessage &msg, MessageType type);
+
+    /** disabled copy constructor */
+    DistributedExecutor(const DistributedExecutor &);
+
+    /** disabled assignment operator */
+    void operator=(const DistributedExecutor &);
+};
+
+/**
+ * Worker of distributed analysis (--worker=<address>). Connects to the
+ * coordinator and checks the files that it is given until the coordinator
+ * closes the connection.
+ *
+ * The worker checks the files with its own build dir, so unchanged files
+ * are not analyzed again when the worker is used in the next run.
+ */
+class DistributedWorker : public ErrorLogger {
+public:
+    explicit DistributedWorker(Settings &settings);
+
+    /** @return EXIT_SUCCESS, or EXIT_FAILURE if the coordinator could not be reached */
+    int run();
+
+    virtual void reportOut(const std::string &outmsg) OVERRIDE;
+    virtual void reportErr(const ErrorLogger::ErrorMessage &msg) OVERRIDE;
+    virtual void reportInfo(const ErrorLogger::ErrorMessage &msg) OVERRIDE;
+
+private:
+    Settings &_settings;
+    int _socket;
+
+    /** @brief KEEPALIVE messages are sent from another thread */
+    std::mutex _sendSync;
+
+    /** @brief Lines in files.txt of the build dir of the worker */
+    std::set<std::string> _filesTxt;
+
+    /** @brief Check the file of a WORK message and send the results */
+    bool work(CppCheck &cppcheck, const std::string &payload);
+
+    /** @brief Send a message to the coordinator */
+    bool send(DistributedExecutor::MessageType type, const std::string &payload);
+
+    /** disabled copy constructor */
+    DistributedWorker(const DistributedWorker &);
+
+    /** disabled assignment operator */
+    void operator=(const DistributedWorker &);
+};
+
+/// @}
+
+#endif // DISTRIBUTEDEXECUTOR_H
@@ -0,0 +1,203 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "framing.h"
+
+#include "config.h"
+#include "preprocessor.h"
+#include "threadexecutor.h" // Threading model
+
+#include <list>
+
+#ifdef THREADING_MODEL_FORK
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+void Framing::appendInt(std::string &out, unsigned int value)
+{
+    out += static_cast<char>((value >> 24) & 0xff);
+    out += static_cast<char>((value >> 16) & 0xff);
+    out += static_cast<char>((value >> 8) & 0xff);
+    out += static_cast<char>(value & 0xff);
+}
+
+void Framing::appendString(std::string &out, const std::string &str)
+{
+    appendInt(out, static_cast<unsigned int>(str.size()));
+    out += str;
+}
+
+void Framing::appendFrame(std::string &out, char type, const std::string &payload)
+{
+    out += type;
+    appendInt(out, static_cast<unsigned int>(payload.size()));
+    out += payload;
+}
+
+static unsigned int readInt(const char *data)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+    return (static_cast<unsigned int>(p[0]) << 24) | (static_cast<unsigned int>(p[1]) << 16) |
+           (static_cast<unsigned int>(p[2]) << 8) | static_cast<unsigned int>(p[3]);
+}
+
+int Framing::peekFrame(const std::string &buffer, std::size_t pos, char *type, std::size_t *len)
+{
+    if (buffer.size() - pos < HEADER_SIZE)
+        return 0;
+    const std::size_t n = readInt(buffer.data() + pos + 1);
+    if (n > MAX_FRAME_SIZE)
+        return -1;
+    if (buffer.size() - pos - HEADER_SIZE < n)
+        return 0;
+    *type = buffer[pos];
+    *len = n;
+    return 1;
+}
+
+#ifdef THREADING_MODEL_FORK
+
+#ifdef MSG_NOSIGNAL
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static const int SEND_FLAGS = 0;
+#endif
+
+bool Framing::writeAll(int fd, const std::string &out, bool isSocket)
+{
+    std::size_t written = 0;
+    while (written < out.size()) {
+        const ssize_t res = isSocket ?
+                            ::send(fd, out.data() + written, out.size() - written, SEND_FLAGS) :
+                            ::write(fd, out.data() + written, out.size() - written);
+        if (res < 0 && errno == EINTR)
+            continue;
+        if (res <= 0)
+            return false;
+        written += res;
+    }
+    return true;
+}
+
+#else
+
+bool Framing::writeAll(int, const std::string &, bool)
+{
+    return false;
+}
+
+#endif
+
+unsigned int Framing::PayloadReader::readInt()
+{
+    if (mLen - mPos < 4) {
+        mError = true;
+        return 0;
+    }
+    const unsigned int value = ::readInt(mData + mPos);
+    mPos += 4;
+    return value;
+}
+
+std::string Framing::PayloadReader::readString()
+{
+    const std::size_t len = readInt();
+    if (mLen - mPos < len) {
+        mError = true;
+        return std::string();
+    }
+    const std::string str(mData + mPos, len);
+    mPos += len;
+    return str;
+}
+
+const std::string &Framing::PayloadReader::readInterned(const std::vector<std::string> &strings)
+{
+    const unsigned int index = readInt();
+    if (index >= strings.size()) {
+        mError = true;
+        return emptyString;
+    }
+    return strings[index];
+}
+
+void Framing::appendMissingIncludes(std::string &payload)
+{
+    appendInt(payload, Preprocessor::missingIncludeFlag ? 1U : 0U);
+    appendInt(payload, Preprocessor::missingSystemIncludeFlag ? 1U : 0U);
+}
+
+void Framing::readMissingIncludes(PayloadReader &reader)
+{
+    if (reader.readInt() != 0)
+        Preprocessor::missingIncludeFlag = true;
+    if (reader.readInt() != 0)
+        Preprocessor::missingSystemIncludeFlag = true;
+}
+
+void Framing::appendMessage(std::string &payload, const ErrorLogger::ErrorMessage &msg,
+                            const std::function<void(std::string &, const std::string &)> &appendName)
+{
+    appendName(payload, msg._id);
+    appendName(payload, msg.file0);
+    appendInt(payload, msg._severity);
+    appendInt(payload, msg._cwe.id);
+    appendInt(payload, msg._inconclusive ? 1U : 0U);
+    appendString(payload, msg.shortMessage());
+    appendString(payload, msg.verboseMessage());
+    appendString(payload, msg.symbolNames());
+    appendInt(payload, static_cast<unsigned int>(msg._callStack.size()));
+    for (std::list<ErrorLogger::ErrorMessage::FileLocation>::const_iterator loc = msg._callStack.begin(); loc != msg._callStack.end(); ++loc) {
+        appendName(payload, loc->getOrigFile(false));
+        appendName(payload, loc->getfile(false));
+        appendInt(payload, static_cast<unsigned int>(loc->line));
+        appendString(payload, loc->getinfo());
+        appendInt(payload, loc->col);
+        appendInt(payload, loc->fileIndex);
+    }
+}
+
+bool Framing::readMessage(PayloadReader &reader, ErrorLogger::ErrorMessage *msg,
+                          const std::function<std::string(PayloadReader &)> &readName)
+{
+    msg->_id = readName(reader);
+    msg->file0 = readName(reader);
+    msg->_severity = static_cast<Severity::SeverityType>(reader.readInt());
+    msg->_cwe.id = static_cast<unsigned short>(reader.readInt());
+    msg->_inconclusive = reader.readInt() != 0;
+    const std::string shortMessage = reader.readString();
+    const std::string verboseMessage = reader.readString();
+    const std::string symbolNames = reader.readString();
+    msg->setmsg(shortMessage, verboseMessage, symbolNames);
+    const unsigned int callStackSize = reader.readInt();
+    for (unsigned int i = 0; i < callStackSize && !reader.error(); ++i) {
+        const std::string origFile = readName(reader);
+        const std::string file = readName(reader);
+        const int line = static_cast<int>(reader.readInt());
+        ErrorLogger::ErrorMessage::FileLocation loc(origFile, reader.readString(), 0);
+        loc.setfile(file);
+        loc.line = line;
+        loc.col = reader.readInt();
+        loc.fileIndex = reader.readInt();
+        msg->_callStack.push_back(loc);
+    }
+    return !reader.error();
+}
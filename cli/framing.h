@@ -0,0 +1,116 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMING_H
+#define FRAMING_H
+
+#include "errorlogger.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// @addtogroup CLI
+/// @{
+
+/**
+ * Messages that the executors send through pipes and sockets, see
+ * ThreadExecutor and DistributedExecutor.
+ *
+ * Messages are frames [type:1][length:4][payload]. Integers are written
+ * in network byte order and strings as length and characters.
+ */
+namespace Framing {
+    /** Size of the type and length in front of the payload */
+    const std::size_t HEADER_SIZE = 5;
+
+    /** Frames larger than this are not accepted */
+    const std::size_t MAX_FRAME_SIZE = 256U * 1024U * 1024U;
+
+    void appendInt(std::string &out, unsigned int value);
+    void appendString(std::string &out, const std::string &str);
+    void appendFrame(std::string &out, char type, const std::string &payload);
+
+    /**
+     * Look at the frame that starts at @p pos in @p buffer. The payload
+     * follows the header.
+     * @return -1 if the frame is too large, 0 if it is not complete and 1
+     *         if @p type and @p len are set
+     */
+    int peekFrame(const std::string &buffer, std::size_t pos, char *type, std::size_t *len);
+
+    /**
+     * Write all of @p out to a pipe or socket. A lost peer does not raise
+     * SIGPIPE if @p isSocket is true.
+     * @return false if writing failed
+     */
+    bool writeAll(int fd, const std::string &out, bool isSocket);
+
+    /** Reads the fields of a frame payload, written with appendInt() and appendString() */
+    class PayloadReader {
+    public:
+        PayloadReader(const char *data, std::size_t len) : mData(data), mLen(len), mPos(0), mError(false) {}
+
+        unsigned int readInt();
+        std::string readString();
+
+        /** @brief Read an index into @p strings */
+        const std::string &readInterned(const std::vector<std::string> &strings);
+
+        bool error() const {
+            return mError;
+        }
+
+    private:
+        const char *mData;
+        std::size_t mLen;
+        std::size_t mPos;
+        bool mError;
+    };
+
+    /**
+     * Append the missing include flags of the Preprocessor. The executors
+     * send them with the result of a file, so that the information
+     * message about missing includes is the same as with one job.
+     */
+    void appendMissingIncludes(std::string &payload);
+
+    /** Read the flags written by appendMissingIncludes() and set the flags of the Preprocessor */
+    void readMissingIncludes(PayloadReader &reader);
+
+    /**
+     * Append an error or information message. Nothing is lost, unlike
+     * the xml form. The ids and file names are written by @p appendName,
+     * for instance as indexes into a string table.
+     */
+    void appendMessage(std::string &payload, const ErrorLogger::ErrorMessage &msg,
+                       const std::function<void(std::string &, const std::string &)> &appendName);
+
+    /**
+     * Read a message written by appendMessage(), @p readName reads what
+     * the appendName function wrote.
+     * @return false if the payload is not valid
+     */
+    bool readMessage(PayloadReader &reader, ErrorLogger::ErrorMessage *msg,
+                     const std::function<std::string(PayloadReader &)> &readName);
+}
+
+/// @}
+
+#endif // FRAMING_H
@@ -18,17 +18,21 @@
 
 #include "threadexecutor.h"
 
+#include "analyzerinfo.h"
 #include "config.h"
 #include "cppcheck.h"
 #include "cppcheckexecutor.h"
+#include "framing.h"
 #include "importproject.h"
 #include "settings.h"
 #include "suppressions.h"
 
 #include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <utility>
 
@@ -36,21 +40,29 @@
 #include <sys/loadavg.h>
 #endif
 #ifdef THREADING_MODEL_FORK
-#include <sys/select.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <sys/wait.h>
 #include <fcntl.h>
 #include <unistd.h>
+#if defined(__linux__)
+#define HAVE_EPOLL
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
 #endif
 #ifdef THREADING_MODEL_WIN
 #include <process.h>
 #include <windows.h>
 #endif
 
-// required for FD_ZERO
-using std::memset;
-
 ThreadExecutor::ThreadExecutor(const std::map<std::string, std::size_t> &files, Settings &settings, ErrorLogger &errorLogger)
-    : _files(files), _settings(settings), _errorLogger(errorLogger), _fileCount(0)
+    : _files(files), _settings(settings), _errorLogger(errorLogger), _fileCount(0), _totalCost(0)
       // Not initialized _fileSync, _errorSync, _reportSync
 {
 #if defined(THREADING_MODEL_FORK)
@@ -58,8 +70,7 @@ ThreadExecutor::ThreadExecutor(const std::map<std::string, std::size_t> &files,
 #elif defined(THREADING_MODEL_WIN)
     _processedFiles = 0;
     _totalFiles = 0;
-    _processedSize = 0;
-    _totalFileSize = 0;
+    _processedCost = 0;
 #endif
 }
 
@@ -68,6 +79,90 @@ ThreadExecutor::~ThreadExecutor()
     //dtor
 }
 
+std::string ThreadExecutor::ScheduledFile::key() const
+{
+    if (fileSettings)
+        return fileSettings->cfg + ':' + fileSettings->filename;
+    return ':' + *file;
+}
+
+static bool moreExpensive(const ThreadExecutor::ScheduledFile &f1, const ThreadExecutor::ScheduledFile &f2)
+{
+    return f1.cost > f2.cost;
+}
+
+std::vector<ThreadExecutor::ScheduledFile> ThreadExecutor::scheduleFiles(const std::map<std::string, std::size_t> &files,
+        const std::list<ImportProject::FileSettings> &fileSettings,
+        const std::map<std::string, unsigned long long> &fileTimes)
+{
+    std::vector<ScheduledFile> schedule;
+    schedule.reserve(fileSettings.size() + files.size());
+    for (std::list<ImportProject::FileSettings>::const_iterator fs = fileSettings.begin(); fs != fileSettings.end(); ++fs) {
+        ScheduledFile f;
+        f.fileSettings = &*fs;
+        std::ifstream fin(fs->filename, std::ios::in | std::ios::binary | std::ios::ate);
+        if (fin.is_open())
+            f.size = static_cast<std::size_t>(fin.tellg());
+        schedule.push_back(f);
+    }
+    for (std::map<std::string, std::size_t>::const_iterator i = files.begin(); i != files.end(); ++i) {
+        ScheduledFile f;
+        f.file = &i->first;
+        f.size = i->second;
+        schedule.push_back(f);
+    }
+
+    // Time per byte of the files that were checked in the previous run
+    std::vector<const unsigned long long *> history(schedule.size(), nullptr);
+    unsigned long long knownTime = 0;
+    std::size_t knownSize = 0;
+    for (std::size_t i = 0; i < schedule.size(); ++i) {
+        const std::map<std::string, unsigned long long>::const_iterator t = fileTimes.find(schedule[i].key());
+        if (t == fileTimes.end())
+            continue;
+        history[i] = &t->second;
+        knownTime += t->second;
+        knownSize += schedule[i].size;
+    }
+    const double timePerByte = (knownTime > 0 && knownSize > 0) ? (static_cast<double>(knownTime) / static_cast<double>(knownSize)) : 0.0;
+
+    for (std::size_t i = 0; i < schedule.size(); ++i) {
+        if (history[i])
+            schedule[i].cost = static_cast<std::size_t>(*history[i]);
+        else if (timePerByte > 0.0)
+            schedule[i].cost = static_cast<std::size_t>(static_cast<double>(schedule[i].size) * timePerByte);
+        else
+            schedule[i].cost = schedule[i].size;
+    }
+
+    std::stable_sort(schedule.begin(), schedule.end(), moreExpensive);
+    return schedule;
+}
+
+void ThreadExecutor::prepareSchedule()
+{
+    _fileTimes.clear();
+    if (!_settings.buildDir.empty())
+        _fileTimes = AnalyzerInformation::readFileTimes(_settings.buildDir);
+
+    _schedule = scheduleFiles(_files, _settings.project.fileSettings, _fileTimes);
+    _totalCost = 0;
+    for (std::vector<ScheduledFile>::const_iterator f = _schedule.begin(); f != _schedule.end(); ++f)
+        _totalCost += f->cost;
+}
+
+void ThreadExecutor::saveFileTimes() const
+{
+    if (!_settings.buildDir.empty())
+        AnalyzerInformation::writeFileTimes(_settings.buildDir, _fileTimes);
+}
+
+/** Wall time since @p start in microseconds */
+static unsigned long long elapsedTime(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ////// This code is for platforms that support fork() only ////////////////////
@@ -80,68 +175,106 @@ void ThreadExecutor::addFileContent(const std::string &path, const std::string &
     _fileContents[ path ] = content;
 }
 
-int ThreadExecutor::handleRead(int rpipe, unsigned int &result)
+/** Write to the pipe of the parent, the child can't go on if the parent is gone */
+static void writeAll(int wpipe, const std::string &out)
 {
-    char type = 0;
-    if (read(rpipe, &type, 1) <= 0) {
-        if (errno == EAGAIN)
-            return 0;
-
-        return -1;
-    }
-
-    if (type != REPORT_OUT && type != REPORT_ERROR && type != REPORT_INFO && type != CHILD_END) {
-        std::cerr << "#### ThreadExecutor::handleRead error, type was:" << type << std::endl;
+    if (!Framing::writeAll(wpipe, out, false)) {
+        std::cerr << "#### ThreadExecutor::writeToPipe, Failed to write to pipe" << std::endl;
         std::exit(0);
     }
+}
 
-    unsigned int len = 0;
-    if (read(rpipe, &len, sizeof(len)) <= 0) {
-        std::cerr << "#### ThreadExecutor::handleRead error, type was:" << type << std::endl;
-        std::exit(0);
+int ThreadExecutor::handleRead(int rpipe, ChildPipe &childPipe, unsigned int &result)
+{
+    // Drain the pipe with large reads, then handle all complete frames
+    bool gotData = false;
+    bool closed = false;
+    for (;;) {
+        char buf[65536];
+        const ssize_t readRes = read(rpipe, buf, sizeof(buf));
+        if (readRes > 0) {
+            childPipe.buffer.append(buf, readRes);
+            gotData = true;
+        } else if (readRes < 0 && errno == EINTR) {
+            continue;
+        } else {
+            closed = !(readRes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+            break;
+        }
     }
 
-    // Don't rely on incoming data being null-terminated.
-    // Allocate +1 element and null-terminate the buffer.
-    char *buf = new char[len + 1];
-    const ssize_t readIntoBuf = read(rpipe, buf, len);
-    if (readIntoBuf <= 0) {
-        std::cerr << "#### ThreadExecutor::handleRead error, type was:" << type << std::endl;
-        std::exit(0);
+    std::size_t pos = 0;
+    bool done = false;
+    char type;
+    std::size_t len;
+    int frame;
+    while (!done && (frame = Framing::peekFrame(childPipe.buffer, pos, &type, &len)) != 0) {
+        if (frame < 0) {
+            std::cerr << "#### ThreadExecutor::handleRead error, frame is too large" << std::endl;
+            std::exit(0);
+        }
+        done = !handleFrame(type, childPipe.buffer.data() + pos + Framing::HEADER_SIZE, len, childPipe, result);
+        pos += Framing::HEADER_SIZE + len;
     }
-    buf[readIntoBuf] = 0;
+    childPipe.buffer.erase(0, pos);
+
+    // The child may also have closed the pipe without CHILD_END, if it crashed
+    if (done || closed)
+        return -1;
+    return gotData ? 1 : 0;
+}
+
+bool ThreadExecutor::handleFrame(char type, const char *data, std::size_t len, ChildPipe &childPipe, unsigned int &result)
+{
+    Framing::PayloadReader reader(data, len);
 
     if (type == REPORT_OUT) {
-        _errorLogger.reportOut(buf);
+        _errorLogger.reportOut(std::string(data, len));
+    } else if (type == DEFINE_STRING) {
+        if (reader.readInt() != childPipe.strings.size()) {
+            std::cerr << "#### ThreadExecutor::handleRead error, string table out of sync" << std::endl;
+            std::exit(0);
+        }
+        childPipe.strings.emplace_back(data + sizeof(unsigned int), len - sizeof(unsigned int));
     } else if (type == REPORT_ERROR || type == REPORT_INFO) {
         ErrorLogger::ErrorMessage msg;
-        msg.deserialize(buf);
-
-        if (!_settings.nomsg.isSuppressed(msg.toSuppressionsErrorMessage())) {
-            // Alert only about unique errors
-            std::string errmsg = msg.toString(_settings.verbose);
-            if (std::find(_errorList.begin(), _errorList.end(), errmsg) == _errorList.end()) {
-                _errorList.push_back(errmsg);
-                if (type == REPORT_ERROR)
-                    _errorLogger.reportErr(msg);
-                else
-                    _errorLogger.reportInfo(msg);
-            }
+        const std::vector<std::string> &strings = childPipe.strings;
+        const auto readName = [&strings](Framing::PayloadReader &r) {
+            return r.readInterned(strings);
+        };
+        if (!Framing::readMessage(reader, &msg, readName)) {
+            std::cerr << "#### ThreadExecutor::handleRead error, type was:" << type << std::endl;
+            std::exit(0);
         }
+        report(msg, static_cast<PipeSignal>(type));
     } else if (type == CHILD_END) {
-        std::istringstream iss(buf);
-        unsigned int fileResult = 0;
-        iss >> fileResult;
-        result += fileResult;
-        delete [] buf;
-        return -1;
+        result += reader.readInt();
+        Framing::readMissingIncludes(reader);
+        return false;
+    } else {
+        std::cerr << "#### ThreadExecutor::handleRead error, type was:" << type << std::endl;
+        std::exit(0);
     }
 
-    delete [] buf;
-    return 1;
+    return true;
+}
+
+void ThreadExecutor::report(const ErrorLogger::ErrorMessage &msg, PipeSignal type)
+{
+    if (_settings.nomsg.isSuppressed(msg.toSuppressionsErrorMessage()))
+        return;
+
+    // Alert only about unique errors
+    if (!_errorList.insert(msg.toString(_settings.verbose)).second)
+        return;
+
+    if (type == REPORT_ERROR)
+        _errorLogger.reportErr(msg);
+    else
+        _errorLogger.reportInfo(msg);
 }
 
-bool ThreadExecutor::checkLoadAverage(size_t nchildren)
+bool ThreadExecutor::checkLoadAverage(size_t nchildren) const
 {
 #if defined(__CYGWIN__) || defined(__QNX__)  // getloadavg() is unsupported on Cygwin, Qnx.
     return true;
@@ -162,25 +295,296 @@ bool ThreadExecutor::checkLoadAverage(size_t nchildren)
 }
 
 unsigned int ThreadExecutor::check()
+{
+    if (_settings.executor == Settings::EXECUTOR_PROCESS)
+        return checkProcesses();
+    return checkThreads();
+}
+
+void ThreadExecutor::WorkQueue::push(std::size_t worker, const ScheduledFile *item)
+{
+    Deque &deque = mDeques[worker % mDeques.size()];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    deque.items.push_back(item);
+}
+
+bool ThreadExecutor::WorkQueue::pop(std::size_t worker, const ScheduledFile **item)
+{
+    {
+        Deque &own = mDeques[worker % mDeques.size()];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.items.empty()) {
+            *item = own.items.front();
+            own.items.pop_front();
+            return true;
+        }
+    }
+
+    // Steal the most expensive file that is waiting. Another worker may
+    // take it first, then look again.
+    for (;;) {
+        Deque *victim = nullptr;
+        std::size_t victimCost = 0;
+        for (std::size_t i = 1; i < mDeques.size(); ++i) {
+            Deque &deque = mDeques[(worker + i) % mDeques.size()];
+            std::lock_guard<std::mutex> lock(deque.mutex);
+            if (!deque.items.empty() && (!victim || deque.items.front()->cost > victimCost)) {
+                victim = &deque;
+                victimCost = deque.items.front()->cost;
+            }
+        }
+        if (!victim)
+            return false;
+        std::lock_guard<std::mutex> lock(victim->mutex);
+        if (!victim->items.empty()) {
+            *item = victim->items.front();
+            victim->items.pop_front();
+            return true;
+        }
+    }
+}
+
+namespace {
+    typedef ThreadExecutor::ScheduledFile WorkItem;
+
+    /** Result sent from a worker thread to the main thread */
+    struct WorkerResult {
+        enum Type {REPORT_OUT, REPORT_ERROR, REPORT_INFO, FILE_DONE};
+
+        explicit WorkerResult(Type t) : type(t), fileResult(0), file(nullptr), checkTime(0), next(nullptr) {}
+
+        Type type;
+        std::string outmsg;
+        ErrorLogger::ErrorMessage msg;
+        unsigned int fileResult;
+        const WorkItem *file;
+        unsigned long long checkTime;
+        WorkerResult *next;
+    };
+
+    /**
+     * Lock-free multiple producer / single consumer collector. The workers
+     * push results on an intrusive stack and the main thread takes the
+     * whole stack at once.
+     */
+    class ResultCollector {
+    public:
+        ResultCollector() : mHead(nullptr) {
+        }
+
+        ~ResultCollector() {
+            WorkerResult *result = takeAll();
+            while (result) {
+                WorkerResult *next = result->next;
+                delete result;
+                result = next;
+            }
+        }
+
+        void push(WorkerResult *result) {
+            result->next = mHead.load(std::memory_order_relaxed);
+            while (!mHead.compare_exchange_weak(result->next, result, std::memory_order_release, std::memory_order_relaxed))
+                ;
+            mWakeup.notify_one();
+        }
+
+        /** Take all pushed results, oldest first */
+        WorkerResult *takeAll() {
+            WorkerResult *result = mHead.exchange(nullptr, std::memory_order_acquire);
+            WorkerResult *ordered = nullptr;
+            while (result) {
+                WorkerResult *next = result->next;
+                result->next = ordered;
+                ordered = result;
+                result = next;
+            }
+            return ordered;
+        }
+
+        /**
+         * Wait until something has been pushed. The producers do not lock
+         * the mutex so a wakeup can be missed, the timeout bounds the delay.
+         */
+        void wait() {
+            std::unique_lock<std::mutex> lock(mWaitMutex);
+            mWakeup.wait_for(lock, std::chrono::milliseconds(100), [this]() {
+                return mHead.load(std::memory_order_relaxed) != nullptr;
+            });
+        }
+
+    private:
+        std::atomic<WorkerResult *> mHead;
+        std::mutex mWaitMutex;
+        std::condition_variable mWakeup;
+    };
+
+    /** Error logger of a worker thread, everything goes to the collector */
+    class WorkerErrorLogger : public ErrorLogger {
+    public:
+        explicit WorkerErrorLogger(ResultCollector &collector) : mCollector(collector) {
+        }
+
+        void reportOut(const std::string &outmsg) OVERRIDE {
+            WorkerResult *result = new WorkerResult(WorkerResult::REPORT_OUT);
+            result->outmsg = outmsg;
+            mCollector.push(result);
+        }
+
+        void reportErr(const ErrorLogger::ErrorMessage &msg) OVERRIDE {
+            WorkerResult *result = new WorkerResult(WorkerResult::REPORT_ERROR);
+            result->msg = msg;
+            mCollector.push(result);
+        }
+
+        void reportInfo(const ErrorLogger::ErrorMessage &msg) OVERRIDE {
+            WorkerResult *result = new WorkerResult(WorkerResult::REPORT_INFO);
+            result->msg = msg;
+            mCollector.push(result);
+        }
+
+    private:
+        ResultCollector &mCollector;
+    };
+}
+
+unsigned int ThreadExecutor::checkThreads()
 {
     _fileCount = 0;
     unsigned int result = 0;
 
-    std::size_t totalfilesize = 0;
-    for (std::map<std::string, std::size_t>::const_iterator i = _files.begin(); i != _files.end(); ++i) {
-        totalfilesize += i->second;
+    prepareSchedule();
+
+    const unsigned int workerCount = std::max(_settings.jobs, 1U);
+
+    // Deal the files out round robin, most expensive first. A worker that
+    // runs dry steals the most expensive file that another worker has not
+    // started yet.
+    WorkQueue queue(workerCount);
+    for (std::size_t i = 0; i < _schedule.size(); ++i)
+        queue.push(i, &_schedule[i]);
+
+    ResultCollector collector;
+    std::atomic<unsigned int> runningWorkers(workerCount);
+    std::atomic<std::size_t> busyWorkers(0);
+
+    const auto worker = [&](std::size_t index) {
+        WorkerErrorLogger logger(collector);
+        CppCheck fileChecker(logger, false);
+        fileChecker.settings() = _settings;
+
+        const WorkItem *item;
+        while (queue.pop(index, &item)) {
+            while (!checkLoadAverage(busyWorkers))
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+
+            ++busyWorkers;
+            WorkerResult *done = new WorkerResult(WorkerResult::FILE_DONE);
+            done->file = item;
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            try {
+                if (item->fileSettings) {
+                    done->fileResult = fileChecker.check(*item->fileSettings);
+                } else {
+                    const std::map<std::string, std::string>::const_iterator fileContent = _fileContents.find(*item->file);
+                    if (fileContent != _fileContents.end()) {
+                        // File content was given as a string
+                        done->fileResult = fileChecker.check(*item->file, fileContent->second);
+                    } else {
+                        // Read file from a file
+                        done->fileResult = fileChecker.check(*item->file);
+                    }
+                }
+            } catch (const std::exception &e) {
+                std::list<ErrorLogger::ErrorMessage::FileLocation> locations;
+                locations.emplace_back(item->fileSettings ? item->fileSettings->filename : *item->file, 0);
+                const ErrorLogger::ErrorMessage errmsg(locations,
+                                                       emptyString,
+                                                       Severity::error,
+                                                       std::string("Internal error: Worker thread caught exception: ") + e.what(),
+                                                       "cppcheckError",
+                                                       false);
+                logger.reportErr(errmsg);
+            }
+            done->checkTime = elapsedTime(start);
+            --busyWorkers;
+            collector.push(done);
+        }
+        --runningWorkers;
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < workerCount; ++i)
+        workers.emplace_back(worker, i);
+
+    std::size_t processedCost = 0;
+    for (;;) {
+        // Everything pushed before the last worker stopped is in the final batch
+        const bool allDone = (runningWorkers == 0);
+
+        WorkerResult *res = collector.takeAll();
+        while (res) {
+            switch (res->type) {
+            case WorkerResult::REPORT_OUT:
+                _errorLogger.reportOut(res->outmsg);
+                break;
+            case WorkerResult::REPORT_ERROR:
+                report(res->msg, REPORT_ERROR);
+                break;
+            case WorkerResult::REPORT_INFO:
+                report(res->msg, REPORT_INFO);
+                break;
+            case WorkerResult::FILE_DONE:
+                result += res->fileResult;
+                _fileTimes[res->file->key()] = res->checkTime;
+                _fileCount++;
+                processedCost += res->file->cost;
+                if (!_settings.quiet)
+                    CppCheckExecutor::reportStatus(_fileCount, _schedule.size(), processedCost, _totalCost);
+                break;
+            }
+            WorkerResult *next = res->next;
+            delete res;
+            res = next;
+        }
+
+        if (allDone)
+            break;
+        collector.wait();
     }
 
+    for (std::thread &t : workers)
+        t.join();
+
+    saveFileTimes();
+
+    return result;
+}
+
+unsigned int ThreadExecutor::checkProcesses()
+{
+    _fileCount = 0;
+    unsigned int result = 0;
+
+    prepareSchedule();
+
     std::list<int> rpipes;
     std::map<pid_t, std::string> childFile;
-    std::map<int, std::string> pipeFile;
-    std::size_t processedsize = 0;
-    std::map<std::string, std::size_t>::const_iterator iFile = _files.begin();
-    std::list<ImportProject::FileSettings>::const_iterator iFileSettings = _settings.project.fileSettings.begin();
+    std::map<int, const ScheduledFile *> pipeFile;
+    std::map<int, std::chrono::steady_clock::time_point> pipeStart;
+    std::map<int, ChildPipe> childPipes;
+    std::size_t processedCost = 0;
+#ifdef HAVE_EPOLL
+    const int epollfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollfd < 0) {
+        std::cerr << "#### ThreadExecutor::check, epoll_create1() failed: "<< std::strerror(errno) << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+#endif
+    std::vector<ScheduledFile>::const_iterator iFile = _schedule.begin();
     for (;;) {
         // Start a new child
         size_t nchildren = rpipes.size();
-        if ((iFile != _files.end() || iFileSettings != _settings.project.fileSettings.end()) && nchildren < _settings.jobs && checkLoadAverage(nchildren)) {
+        if (iFile != _schedule.end() && nchildren < _settings.jobs && checkLoadAverage(nchildren)) {
             int pipes[2];
             if (pipe(pipes) == -1) {
                 std::cerr << "#### ThreadExecutor::check, pipe() failed: "<< std::strerror(errno) << std::endl;
@@ -205,78 +609,98 @@ unsigned int ThreadExecutor::check()
                 std::exit(EXIT_FAILURE);
             } else if (pid == 0) {
                 close(pipes[0]);
+#ifdef HAVE_EPOLL
+                close(epollfd);
+#endif
                 _wpipe = pipes[1];
 
                 CppCheck fileChecker(*this, false);
                 fileChecker.settings() = _settings;
                 unsigned int resultOfCheck = 0;
 
-                if (iFileSettings != _settings.project.fileSettings.end()) {
-                    resultOfCheck = fileChecker.check(*iFileSettings);
-                } else if (!_fileContents.empty() && _fileContents.find(iFile->first) != _fileContents.end()) {
+                if (iFile->fileSettings) {
+                    resultOfCheck = fileChecker.check(*iFile->fileSettings);
+                } else if (!_fileContents.empty() && _fileContents.find(*iFile->file) != _fileContents.end()) {
                     // File content was given as a string
-                    resultOfCheck = fileChecker.check(iFile->first, _fileContents[ iFile->first ]);
+                    resultOfCheck = fileChecker.check(*iFile->file, _fileContents[ *iFile->file ]);
                 } else {
                     // Read file from a file
-                    resultOfCheck = fileChecker.check(iFile->first);
+                    resultOfCheck = fileChecker.check(*iFile->file);
                 }
 
-                std::ostringstream oss;
-                oss << resultOfCheck;
-                writeToPipe(CHILD_END, oss.str());
+                std::string data;
+                Framing::appendInt(data, resultOfCheck);
+                Framing::appendMissingIncludes(data);
+                writeToPipe(CHILD_END, data);
                 std::exit(0);
             }
 
             close(pipes[1]);
-            rpipes.push_back(pipes[0]);
-            if (iFileSettings != _settings.project.fileSettings.end()) {
-                childFile[pid] = iFileSettings->filename + ' ' + iFileSettings->cfg;
-                pipeFile[pipes[0]] = iFileSettings->filename + ' ' + iFileSettings->cfg;
-                ++iFileSettings;
-            } else {
-                childFile[pid] = iFile->first;
-                pipeFile[pipes[0]] = iFile->first;
-                ++iFile;
+#ifdef HAVE_EPOLL
+            struct epoll_event event;
+            event.events = EPOLLIN;
+            event.data.fd = pipes[0];
+            if (epoll_ctl(epollfd, EPOLL_CTL_ADD, pipes[0], &event) < 0) {
+                std::cerr << "#### ThreadExecutor::check, epoll_ctl() failed: "<< std::strerror(errno) << std::endl;
+                std::exit(EXIT_FAILURE);
             }
+#endif
+            rpipes.push_back(pipes[0]);
+            if (iFile->fileSettings)
+                childFile[pid] = iFile->fileSettings->filename + ' ' + iFile->fileSettings->cfg;
+            else
+                childFile[pid] = *iFile->file;
+            pipeFile[pipes[0]] = &*iFile;
+            pipeStart[pipes[0]] = std::chrono::steady_clock::now();
+            ++iFile;
         } else if (!rpipes.empty()) {
-            fd_set rfds;
-            FD_ZERO(&rfds);
-            for (std::list<int>::const_iterator rp = rpipes.begin(); rp != rpipes.end(); ++rp)
-                FD_SET(*rp, &rfds);
-            struct timeval tv; // for every second polling of load average condition
-            tv.tv_sec = 1;
-            tv.tv_usec = 0;
-            int r = select(*std::max_element(rpipes.begin(), rpipes.end()) + 1, &rfds, nullptr, nullptr, &tv);
-
-            if (r > 0) {
-                std::list<int>::iterator rp = rpipes.begin();
-                while (rp != rpipes.end()) {
-                    if (FD_ISSET(*rp, &rfds)) {
-                        int readRes = handleRead(*rp, result);
-                        if (readRes == -1) {
-                            std::size_t size = 0;
-                            std::map<int, std::string>::iterator p = pipeFile.find(*rp);
-                            if (p != pipeFile.end()) {
-                                std::string name = p->second;
-                                pipeFile.erase(p);
-                                std::map<std::string, std::size_t>::const_iterator fs = _files.find(name);
-                                if (fs != _files.end()) {
-                                    size = fs->second;
-                                }
-                            }
-
-                            _fileCount++;
-                            processedsize += size;
-                            if (!_settings.quiet)
-                                CppCheckExecutor::reportStatus(_fileCount, _files.size() + _settings.project.fileSettings.size(), processedsize, totalfilesize);
-
-                            close(*rp);
-                            rp = rpipes.erase(rp);
-                        } else
-                            ++rp;
-                    } else
-                        ++rp;
+            // Wait at most a second, for polling of load average condition
+            std::vector<int> readyPipes;
+#ifdef HAVE_EPOLL
+            std::vector<struct epoll_event> events(rpipes.size());
+            const int r = epoll_wait(epollfd, events.data(), static_cast<int>(events.size()), 1000);
+            for (int i = 0; i < r; ++i)
+                readyPipes.push_back(events[i].data.fd);
+#else
+            std::vector<struct pollfd> fds;
+            for (std::list<int>::const_iterator rp = rpipes.begin(); rp != rpipes.end(); ++rp) {
+                struct pollfd fd;
+                fd.fd = *rp;
+                fd.events = POLLIN;
+                fd.revents = 0;
+                fds.push_back(fd);
+            }
+            const int r = poll(fds.data(), fds.size(), 1000);
+            for (std::size_t i = 0; r > 0 && i < fds.size(); ++i) {
+                if (fds[i].revents)
+                    readyPipes.push_back(fds[i].fd);
+            }
+#endif
+
+            for (std::vector<int>::const_iterator rp = readyPipes.begin(); rp != readyPipes.end(); ++rp) {
+                const int readRes = handleRead(*rp, childPipes[*rp], result);
+                if (readRes != -1)
+                    continue;
+
+                std::map<int, const ScheduledFile *>::iterator p = pipeFile.find(*rp);
+                if (p != pipeFile.end()) {
+                    _fileTimes[p->second->key()] = elapsedTime(pipeStart[*rp]);
+                    processedCost += p->second->cost;
+                    pipeFile.erase(p);
                 }
+                pipeStart.erase(*rp);
+                childPipes.erase(*rp);
+
+                _fileCount++;
+                if (!_settings.quiet)
+                    CppCheckExecutor::reportStatus(_fileCount, _schedule.size(), processedCost, _totalCost);
+
+#ifdef HAVE_EPOLL
+                // Children may still hold a copy of the pipe, remove it explicitly
+                epoll_ctl(epollfd, EPOLL_CTL_DEL, *rp, nullptr);
+#endif
+                close(*rp);
+                rpipes.remove(*rp);
             }
 
             int stat = 0;
@@ -312,25 +736,47 @@ unsigned int ThreadExecutor::check()
         }
     }
 
+#ifdef HAVE_EPOLL
+    close(epollfd);
+#endif
+    saveFileTimes();
 
     return result;
 }
 
 void ThreadExecutor::writeToPipe(PipeSignal type, const std::string &data)
 {
-    unsigned int len = static_cast<unsigned int>(data.length() + 1);
-    char *out = new char[ len + 1 + sizeof(len)];
-    out[0] = static_cast<char>(type);
-    std::memcpy(&(out[1]), &len, sizeof(len));
-    std::memcpy(&(out[1+sizeof(len)]), data.c_str(), len);
-    if (write(_wpipe, out, len + 1 + sizeof(len)) <= 0) {
-        delete [] out;
-        out = nullptr;
-        std::cerr << "#### ThreadExecutor::writeToPipe, Failed to write to pipe" << std::endl;
-        std::exit(0);
-    }
+    std::string out;
+    Framing::appendFrame(out, static_cast<char>(type), data);
+    writeAll(_wpipe, out);
+}
 
-    delete [] out;
+unsigned int ThreadExecutor::internString(const std::string &str, std::string &out)
+{
+    const std::map<std::string, unsigned int>::const_iterator it = _pipeStrings.find(str);
+    if (it != _pipeStrings.end())
+        return it->second;
+    const unsigned int index = static_cast<unsigned int>(_pipeStrings.size());
+    _pipeStrings[str] = index;
+    std::string payload;
+    Framing::appendInt(payload, index);
+    payload += str;
+    Framing::appendFrame(out, DEFINE_STRING, payload);
+    return index;
+}
+
+void ThreadExecutor::writeMessageToPipe(PipeSignal type, const ErrorLogger::ErrorMessage &msg)
+{
+    // New strings are defined in front of the message, and all is sent
+    // with one write so nothing is lost if the child crashes later
+    std::string out;
+    std::string payload;
+    const auto appendName = [this, &out](std::string &p, const std::string &name) {
+        Framing::appendInt(p, internString(name, out));
+    };
+    Framing::appendMessage(payload, msg, appendName);
+    Framing::appendFrame(out, static_cast<char>(type), payload);
+    writeAll(_wpipe, out);
 }
 
 void ThreadExecutor::reportOut(const std::string &outmsg)
@@ -340,12 +786,12 @@ void ThreadExecutor::reportOut(const std::string &outmsg)
 
 void ThreadExecutor::reportErr(const ErrorLogger::ErrorMessage &msg)
 {
-    writeToPipe(REPORT_ERROR, msg.serialize());
+    writeMessageToPipe(REPORT_ERROR, msg);
 }
 
 void ThreadExecutor::reportInfo(const ErrorLogger::ErrorMessage &msg)
 {
-    writeToPipe(REPORT_INFO, msg.serialize());
+    writeMessageToPipe(REPORT_INFO, msg);
 }
 
 #elif defined(THREADING_MODEL_WIN)
@@ -359,16 +805,12 @@ unsigned int ThreadExecutor::check()
 {
     HANDLE *threadHandles = new HANDLE[_settings.jobs];
 
-    _itNextFile = _files.begin();
-    _itNextFileSettings = _settings.project.fileSettings.begin();
+    prepareSchedule();
+    _itNextFile = _schedule.begin();
 
     _processedFiles = 0;
-    _processedSize = 0;
-    _totalFiles = _files.size() + _settings.project.fileSettings.size();
-    _totalFileSize = 0;
-    for (std::map<std::string, std::size_t>::const_iterator i = _files.begin(); i != _files.end(); ++i) {
-        _totalFileSize += i->second;
-    }
+    _processedCost = 0;
+    _totalFiles = _schedule.size();
 
     InitializeCriticalSection(&_fileSync);
     InitializeCriticalSection(&_errorSync);
@@ -416,6 +858,8 @@ unsigned int ThreadExecutor::check()
 
     delete[] threadHandles;
 
+    saveFileTimes();
+
     return result;
 }
 
@@ -424,8 +868,7 @@ unsigned int __stdcall ThreadExecutor::threadProc(void *args)
     unsigned int result = 0;
 
     ThreadExecutor *threadExecutor = static_cast<ThreadExecutor*>(args);
-    std::map<std::string, std::size_t>::const_iterator &itFile = threadExecutor->_itNextFile;
-    std::list<ImportProject::FileSettings>::const_iterator &itFileSettings = threadExecutor->_itNextFileSettings;
+    std::vector<ScheduledFile>::const_iterator &itFile = threadExecutor->_itNextFile;
 
     // guard static members of CppCheck against concurrent access
     EnterCriticalSection(&threadExecutor->_fileSync);
@@ -434,19 +877,21 @@ unsigned int __stdcall ThreadExecutor::threadProc(void *args)
     fileChecker.settings() = threadExecutor->_settings;
 
     for (;;) {
-        if (itFile == threadExecutor->_files.end() && itFileSettings == threadExecutor->_settings.project.fileSettings.end()) {
+        if (itFile == threadExecutor->_schedule.end()) {
             LeaveCriticalSection(&threadExecutor->_fileSync);
             break;
         }
 
-        std::size_t fileSize = 0;
-        if (itFile != threadExecutor->_files.end()) {
-            const std::string &file = itFile->first;
-            fileSize = itFile->second;
-            ++itFile;
+        const ScheduledFile &scheduledFile = *itFile;
+        ++itFile;
 
-            LeaveCriticalSection(&threadExecutor->_fileSync);
+        LeaveCriticalSection(&threadExecutor->_fileSync);
 
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (scheduledFile.fileSettings) {
+            result += fileChecker.check(*scheduledFile.fileSettings);
+        } else {
+            const std::string &file = *scheduledFile.file;
             const std::map<std::string, std::string>::const_iterator fileContent = threadExecutor->_fileContents.find(file);
             if (fileContent != threadExecutor->_fileContents.end()) {
                 // File content was given as a string
@@ -455,20 +900,17 @@ unsigned int __stdcall ThreadExecutor::threadProc(void *args)
                 // Read file from a file
                 result += fileChecker.check(file);
             }
-        } else { // file settings..
-            const ImportProject::FileSettings &fs = *itFileSettings;
-            ++itFileSettings;
-            LeaveCriticalSection(&threadExecutor->_fileSync);
-            result += fileChecker.check(fs);
         }
+        const unsigned long long checkTime = elapsedTime(start);
 
         EnterCriticalSection(&threadExecutor->_fileSync);
 
-        threadExecutor->_processedSize += fileSize;
+        threadExecutor->_fileTimes[scheduledFile.key()] = checkTime;
+        threadExecutor->_processedCost += scheduledFile.cost;
         threadExecutor->_processedFiles++;
         if (!threadExecutor->_settings.quiet) {
             EnterCriticalSection(&threadExecutor->_reportSync);
-            CppCheckExecutor::reportStatus(threadExecutor->_processedFiles, threadExecutor->_totalFiles, threadExecutor->_processedSize, threadExecutor->_totalFileSize);
+            CppCheckExecutor::reportStatus(threadExecutor->_processedFiles, threadExecutor->_totalFiles, threadExecutor->_processedCost, threadExecutor->_totalCost);
             LeaveCriticalSection(&threadExecutor->_reportSync);
         }
     }
@@ -25,10 +25,14 @@
 #include <cstddef>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 #if (defined(__GNUC__) || defined(__sun)) && !defined(__MINGW32__) && !defined(__CYGWIN__)
 #define THREADING_MODEL_FORK
+#include <deque>
+#include <mutex>
 #elif defined(_WIN32)
 #define THREADING_MODEL_WIN
 #include <windows.h>
@@ -42,8 +46,14 @@ class Settings;
 /**
  * This class will take a list of filenames and settings and check then
  * all files using threads.
+ *
+ * With the fork threading model there are two backends, selected with
+ * Settings::executor. The thread backend runs -j long-lived CppCheck
+ * workers on a work-stealing queue, the process backend forks one child
+ * per file and reads the results from a pipe.
  */
 class ThreadExecutor : public ErrorLogger {
+    friend class TestThreadExecutor;
 public:
     ThreadExecutor(const std::map<std::string, std::size_t> &files, Settings &settings, ErrorLogger &errorLogger);
     virtual ~ThreadExecutor();
@@ -62,40 +72,149 @@ public:
      */
     void addFileContent(const std::string &path, const std::string &content);
 
+    /** @brief A file to check, either a plain file or an imported project file */
+    struct ScheduledFile {
+        ScheduledFile() : file(nullptr), size(0), fileSettings(nullptr), cost(0) {}
+
+        /** Key of the file in the build dir file times, "cfg:sourcefile" */
+        std::string key() const;
+
+        const std::string *file;
+        std::size_t size;
+        const ImportProject::FileSettings *fileSettings;
+
+        /** Estimated cost, the unit is only meaningful relative to other files */
+        std::size_t cost;
+    };
+
+    /**
+     * @brief Order the files by estimated cost, most expensive first.
+     *
+     * The cost of a file is the time it took to check it in the previous
+     * run. Files without history are estimated from their size, using the
+     * time per byte of the files that have history.
+     * @param files plain files and their sizes
+     * @param fileSettings imported project files
+     * @param fileTimes check times of the previous run, see AnalyzerInformation::readFileTimes()
+     */
+    static std::vector<ScheduledFile> scheduleFiles(const std::map<std::string, std::size_t> &files,
+            const std::list<ImportProject::FileSettings> &fileSettings,
+            const std::map<std::string, unsigned long long> &fileTimes);
+
+#if defined(THREADING_MODEL_FORK)
+    /**
+     * @brief Work-stealing queue of the thread backend.
+     *
+     * Every worker owns a deque of files, dealt out most expensive first,
+     * and takes work from its front. When it runs dry it steals the most
+     * expensive file from the fronts of the other deques, so the long
+     * files don't wait behind a busy worker.
+     */
+    class WorkQueue {
+    public:
+        explicit WorkQueue(std::size_t workers) : mDeques(workers) {}
+
+        void push(std::size_t worker, const ScheduledFile *item);
+
+        /** Take the next item for @p worker, false if all deques are empty */
+        bool pop(std::size_t worker, const ScheduledFile **item);
+
+    private:
+        struct Deque {
+            std::mutex mutex;
+            std::deque<const ScheduledFile *> items;
+        };
+        std::vector<Deque> mDeques;
+    };
+#endif
+
 private:
     const std::map<std::string, std::size_t> &_files;
     Settings &_settings;
     ErrorLogger &_errorLogger;
     unsigned int _fileCount;
 
+    /** @brief Files in the order they are dispatched */
+    std::vector<ScheduledFile> _schedule;
+    std::size_t _totalCost;
+
+    /** @brief Check times measured in this run, written to the build dir */
+    std::map<std::string, unsigned long long> _fileTimes;
+
+    /** @brief Build the schedule, reading the file times of the previous run */
+    void prepareSchedule();
+
+    /** @brief Store the file times of this run in the build dir */
+    void saveFileTimes() const;
+
 #if defined(THREADING_MODEL_FORK)
 
     /** @brief Key is file name, and value is the content of the file */
     std::map<std::string, std::string> _fileContents;
 private:
-    enum PipeSignal {REPORT_OUT='1',REPORT_ERROR='2', REPORT_INFO='3', CHILD_END='4'};
+    enum PipeSignal {REPORT_OUT='1',REPORT_ERROR='2', REPORT_INFO='3', CHILD_END='4', DEFINE_STRING='5'};
+
+    /**
+     * @brief Data received from a child that is not handled yet.
+     *
+     * Every frame in the pipe is [type:1][length:4][payload]. File names
+     * and ids in error and info messages are sent as indexes into a string
+     * table that the child builds with DEFINE_STRING frames.
+     */
+    struct ChildPipe {
+        std::string buffer;
+        std::vector<std::string> strings;
+    };
 
     /**
-     * Read from the pipe, parse and handle what ever is in there.
-     *@return -1 in case of error
+     * Read from the pipe until it is empty, parse and handle all complete frames.
+     *@return -1 in case of error or when the child is done
      *         0 if there is nothing in the pipe to be read
      *         1 if we did read something
      */
-    int handleRead(int rpipe, unsigned int &result);
+    int handleRead(int rpipe, ChildPipe &childPipe, unsigned int &result);
+
+    /** @brief Handle a frame from a child, returns false when the child is done */
+    bool handleFrame(char type, const char *data, std::size_t len, ChildPipe &childPipe, unsigned int &result);
+
     void writeToPipe(PipeSignal type, const std::string &data);
+
+    /** @brief Send error or info message to the parent in binary form */
+    void writeMessageToPipe(PipeSignal type, const ErrorLogger::ErrorMessage &msg);
+
+    /** @brief Index of string in the table of the parent, adds a DEFINE_STRING frame to out for new strings */
+    unsigned int internString(const std::string &str, std::string &out);
+
+    /**
+     * Report error or information message unless it is suppressed or
+     * has already been reported for another file.
+     */
+    void report(const ErrorLogger::ErrorMessage &msg, PipeSignal type);
+
+    /** @brief Check files by forking a child process per file (--executor=process) */
+    unsigned int checkProcesses();
+
+    /** @brief Check files with long-lived worker threads (--executor=thread) */
+    unsigned int checkThreads();
+
+    /** @brief Messages that have been reported, to alert only about unique errors */
+    std::set<std::string> _errorList;
+
     /**
      * Write end of status pipe, different for each child.
      * Not used in master process.
      */
-    std::list<std::string> _errorList;
     int _wpipe;
 
+    /** @brief Strings sent to the parent by this child and their indexes */
+    std::map<std::string, unsigned int> _pipeStrings;
+
     /**
      * @brief Check load average condition
      * @param nchildren - count of currently ran children
      * @return true - if new process can be started
      */
-    bool checkLoadAverage(size_t nchildren);
+    bool checkLoadAverage(size_t nchildren) const;
 
 public:
     /**
@@ -111,12 +230,10 @@ private:
     enum MessageType {REPORT_ERROR, REPORT_INFO};
 
     std::map<std::string, std::string> _fileContents;
-    std::map<std::string, std::size_t>::const_iterator _itNextFile;
-    std::list<ImportProject::FileSettings>::const_iterator _itNextFileSettings;
+    std::vector<ScheduledFile>::const_iterator _itNextFile;
     std::size_t _processedFiles;
     std::size_t _totalFiles;
-    std::size_t _processedSize;
-    std::size_t _totalFileSize;
+    std::size_t _processedCost;
     CRITICAL_SECTION _fileSync;
 
     std::list<std::string> _errorList;
@@ -13,6 +13,8 @@ if (HAVE_RULES)
     endif()
 endif()
 
+find_package(Threads REQUIRED)
+
 set(CMAKE_INCLUDE_CURRENT_DIR ON)
 set(CMAKE_AUTOMOC OFF)
 
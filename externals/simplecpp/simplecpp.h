@@ -297,7 +297,19 @@ namespace simplecpp {
         std::list<std::string> includes;
     };
 
-    SIMPLECPP_LIB std::map<std::string, TokenList*> load(const TokenList &rawtokens, std::vector<std::string> &filenames, const DUI &dui, OutputList *outputList = NULL);
+    /**
+     * Tokenizes the files that load() reads. Override this to share the
+     * tokens of header files between several load() calls.
+     */
+    class SIMPLECPP_LIB FileLoader {
+    public:
+        virtual ~FileLoader() {}
+        virtual TokenList *load(std::istream &istr, std::vector<std::string> &filenames, const std::string &filename, OutputList *outputList) {
+            return new TokenList(istr, filenames, filename, outputList);
+        }
+    };
+
+    SIMPLECPP_LIB std::map<std::string, TokenList*> load(const TokenList &rawtokens, std::vector<std::string> &filenames, const DUI &dui, OutputList *outputList = NULL, FileLoader *fileLoader = NULL);
 
     /**
      * Preprocess
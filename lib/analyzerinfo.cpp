@@ -19,12 +19,17 @@
 #include "analyzerinfo.h"
 
 #include "path.h"
+#include "tokencache.h"
 #include "utils.h"
 
 #include <tinyxml2.h>
+#include <ctime>
 #include <cstring>
+#include <iterator>
 #include <map>
 #include <sstream>
+#include <sys/stat.h>
+#include <sys/types.h>
 
 AnalyzerInformation::~AnalyzerInformation()
 {
@@ -60,6 +65,30 @@ void AnalyzerInformation::writeFilesTxt(const std::string &buildDir, const std::
     }
 }
 
+std::map<std::string, unsigned long long> AnalyzerInformation::readFileTimes(const std::string &buildDir)
+{
+    std::map<std::string, unsigned long long> fileTimes;
+    std::ifstream fin(buildDir + "/filetimes.txt");
+    std::string line;
+    while (std::getline(fin, line)) {
+        const std::string::size_type pos = line.find(':');
+        if (pos == std::string::npos || pos == 0)
+            continue;
+        std::istringstream istr(line.substr(0, pos));
+        unsigned long long t;
+        if (istr >> t)
+            fileTimes[line.substr(pos + 1)] = t;
+    }
+    return fileTimes;
+}
+
+void AnalyzerInformation::writeFileTimes(const std::string &buildDir, const std::map<std::string, unsigned long long> &fileTimes)
+{
+    std::ofstream fout(buildDir + "/filetimes.txt");
+    for (std::map<std::string, unsigned long long>::const_iterator it = fileTimes.begin(); it != fileTimes.end(); ++it)
+        fout << it->second << ':' << it->first << '\n';
+}
+
 void AnalyzerInformation::close()
 {
     mAnalyzerInfoFile.clear();
@@ -69,6 +98,128 @@ void AnalyzerInformation::close()
     }
 }
 
+static std::string getToolInfoHash(const std::string &toolinfo)
+{
+    return std::to_string(TokenCache::hash(toolinfo));
+}
+
+static bool readFile(const std::string &filename, std::string *content)
+{
+    std::ifstream fin(filename, std::ios::binary);
+    if (!fin.is_open())
+        return false;
+    content->assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+    return true;
+}
+
+std::string AnalyzerInformation::getDependencies(const std::string &toolinfo, const std::map<std::string, TokenCache::FileStamp> &files, const std::set<std::string> &dirs, std::time_t readTime)
+{
+    std::ostringstream ostr;
+    ostr << "  <dependencies toolinfo=\"" << getToolInfoHash(toolinfo) << "\">\n";
+    for (std::map<std::string, TokenCache::FileStamp>::const_iterator it = files.begin(); it != files.end(); ++it) {
+        ostr << "    <file name=\"" << ErrorLogger::toxml(it->first) << '\"'
+             << " mtime=\"" << it->second.mtime << '\"'
+             << " size=\"" << it->second.size << '\"'
+             << " hash=\"" << it->second.hash << "\"/>\n";
+    }
+    for (const std::string &d : dirs) {
+        struct stat dirStat;
+        if (stat(d.c_str(), &dirStat) != 0)
+            continue;
+        // A header could be added to the directory in the same second as it was read
+        ostr << "    <dir name=\"" << ErrorLogger::toxml(d) << '\"'
+             << " mtime=\"" << (dirStat.st_mtime < readTime ? dirStat.st_mtime : 0) << "\"/>\n";
+    }
+    ostr << "  </dependencies>\n";
+    return ostr.str();
+}
+
+static bool isUnchanged(const tinyxml2::XMLElement *dependency)
+{
+    const char *name = dependency->Attribute("name");
+    const char *mtime = dependency->Attribute("mtime");
+    if (!name || !mtime)
+        return false;
+    struct stat fileStat;
+    if (stat(name, &fileStat) != 0)
+        return false;
+
+    if (std::strcmp(dependency->Name(), "dir") == 0)
+        return std::to_string(fileStat.st_mtime) == mtime;
+
+    const char *size = dependency->Attribute("size");
+    if (std::to_string(fileStat.st_mtime) == mtime && size && std::to_string(fileStat.st_size) == size)
+        return true;
+
+    // Modification time or size is changed, compare content
+    const char *hash = dependency->Attribute("hash");
+    std::string content;
+    return hash && readFile(name, &content) && std::to_string(TokenCache::hash(content)) == hash;
+}
+
+bool AnalyzerInformation::reuseResults(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, const std::string &toolinfo, std::list<ErrorLogger::ErrorMessage> *errors)
+{
+    if (buildDir.empty() || sourcefile.empty())
+        return false;
+
+    tinyxml2::XMLDocument doc;
+    const tinyxml2::XMLError error = doc.LoadFile(getAnalyzerInfoFile(buildDir, sourcefile, cfg).c_str());
+    if (error != tinyxml2::XML_SUCCESS)
+        return false;
+
+    const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
+    if (rootNode == nullptr)
+        return false;
+
+    const tinyxml2::XMLElement * const dependencies = rootNode->FirstChildElement("dependencies");
+    if (!dependencies)
+        return false;
+
+    const char *attr = dependencies->Attribute("toolinfo");
+    if (!attr || attr != getToolInfoHash(toolinfo))
+        return false;
+
+    for (const tinyxml2::XMLElement *e = dependencies->FirstChildElement(); e; e = e->NextSiblingElement()) {
+        if (!isUnchanged(e))
+            return false;
+    }
+
+    for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
+        if (std::strcmp(e->Name(), "error") == 0)
+            errors->emplace_back(e);
+    }
+
+    return true;
+}
+
+/** Replace the dependencies in the analyzerinfo file */
+static void updateDependencies(const std::string &analyzerInfoFile, const std::string &dependencies)
+{
+    std::string content;
+    if (!readFile(analyzerInfoFile, &content))
+        return;
+
+    const std::string::size_type start = content.find("  <dependencies ");
+    if (start != std::string::npos) {
+        const std::string endTag("  </dependencies>\n");
+        const std::string::size_type end = content.find(endTag, start);
+        if (end == std::string::npos)
+            return;
+        if (content.compare(start, end + endTag.size() - start, dependencies) == 0)
+            return;
+        content.replace(start, end + endTag.size() - start, dependencies);
+    } else {
+        // Insert after the root element
+        const std::string::size_type pos = content.find("<analyzerinfo ");
+        if (pos == std::string::npos || content.find('\n', pos) == std::string::npos)
+            return;
+        content.insert(content.find('\n', pos) + 1, dependencies);
+    }
+
+    std::ofstream fout(analyzerInfoFile, std::ios::binary);
+    fout << content;
+}
+
 static bool skipAnalysis(const std::string &analyzerInfoFile, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors)
 {
     tinyxml2::XMLDocument doc;
@@ -122,7 +273,7 @@ std::string AnalyzerInformation::getAnalyzerInfoFile(const std::string &buildDir
     return filename;
 }
 
-bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors)
+bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors, const std::string &dependencies)
 {
     if (buildDir.empty() || sourcefile.empty())
         return true;
@@ -130,13 +281,17 @@ bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::st
 
     mAnalyzerInfoFile = AnalyzerInformation::getAnalyzerInfoFile(buildDir,sourcefile,cfg);
 
-    if (skipAnalysis(mAnalyzerInfoFile, checksum, errors))
+    if (skipAnalysis(mAnalyzerInfoFile, checksum, errors)) {
+        if (!dependencies.empty())
+            updateDependencies(mAnalyzerInfoFile, dependencies);
         return false;
+    }
 
     mOutputStream.open(mAnalyzerInfoFile);
     if (mOutputStream.is_open()) {
         mOutputStream << "<?xml version=\"1.0\"?>\n";
         mOutputStream << "<analyzerinfo checksum=\"" << checksum << "\">\n";
+        mOutputStream << dependencies;
     } else {
         mAnalyzerInfoFile.clear();
     }
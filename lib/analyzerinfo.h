@@ -24,9 +24,13 @@
 #include "config.h"
 #include "errorlogger.h"
 #include "importproject.h"
+#include "tokencache.h"
 
+#include <ctime>
 #include <fstream>
 #include <list>
+#include <map>
+#include <set>
 #include <string>
 
 /// @addtogroup Core
@@ -37,6 +41,7 @@
 *
 * Store various analysis information:
 * - checksum
+* - dependencies (files and directories with their timestamps)
 * - error messages
 * - whole program analysis data
 *
@@ -51,9 +56,46 @@ public:
 
     static void writeFilesTxt(const std::string &buildDir, const std::list<std::string> &sourcefiles, const std::list<ImportProject::FileSettings> &fileSettings);
 
+    /**
+     * Wall time in microseconds it took to check each file in the previous
+     * run (filetimes.txt). The key is "cfg:sourcefile".
+     */
+    static std::map<std::string, unsigned long long> readFileTimes(const std::string &buildDir);
+    static void writeFileTimes(const std::string &buildDir, const std::map<std::string, unsigned long long> &fileTimes);
+
+    /**
+     * Manifest of the files and directories that the results of a TU
+     * depend on. Files are recorded with modification time, size and
+     * content hash as they were read by the preprocessor, so a file that
+     * is modified during the analysis is analyzed again in the next run.
+     * Directories are recorded with modification time, so that new
+     * headers in the include paths are noticed.
+     * @param toolinfo tool version and settings that affect the results
+     * @param files source file and all included headers
+     * @param dirs directories where headers are searched
+     * @param readTime time before the files were read, directories that are modified later are recorded as changed
+     */
+    static std::string getDependencies(const std::string &toolinfo, const std::map<std::string, TokenCache::FileStamp> &files, const std::set<std::string> &dirs, std::time_t readTime);
+
+    /**
+     * Reuse the results of the previous run without tokenizing the file.
+     * That is possible if the toolinfo is the same and no dependency is
+     * changed. Files with another modification time or size are compared
+     * by content hash.
+     * @return true if the results are reused, they are added to errors
+     */
+    static bool reuseResults(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, const std::string &toolinfo, std::list<ErrorLogger::ErrorMessage> *errors);
+
     /** Close current TU.analyzerinfo file */
     void close();
-    bool analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors);
+
+    /**
+     * Start analysis of a file, unless the checksum is the same as in the
+     * previous run.
+     * @param dependencies see getDependencies(), if the checksum is the same they replace the old dependencies
+     * @return false if the old results are reused, they are added to errors
+     */
+    bool analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors, const std::string &dependencies = emptyString);
     void reportErr(const ErrorLogger::ErrorMessage &msg, bool verbose);
     void setFileInfo(const std::string &check, const std::string &fileInfo);
     static std::string getAnalyzerInfoFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg);
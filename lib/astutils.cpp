@@ -27,6 +27,8 @@
 #include "token.h"
 #include "valueflow.h"
 
+#include <algorithm>
+#include <limits>
 #include <list>
 #include <stack>
 
@@ -517,6 +519,65 @@ bool isSameExpression(bool cpp, bool macro, const Token *tok1, const Token *tok2
     return commutativeEquals;
 }
 
+static std::size_t combineHash(std::size_t seed, std::size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+ExpressionHasher::ExpressionHasher(bool cpp, bool followVar)
+    : mCpp(cpp)
+    , mFollowVar(followVar)
+{
+}
+
+std::size_t ExpressionHasher::hash(const Token *tok)
+{
+    if (!tok)
+        return 0;
+    const std::unordered_map<const Token *, std::size_t>::const_iterator it = mHashes.find(tok);
+    if (it != mHashes.end())
+        return it->second;
+    const std::size_t h = computeHash(tok);
+    mHashes[tok] = h;
+    return h;
+}
+
+std::size_t ExpressionHasher::computeHash(const Token *tok)
+{
+    // The same normalizations as isSameExpression()
+    if (mCpp && tok->str() == "." && tok->astOperand1() && tok->astOperand1()->str() == "this")
+        return hash(tok->astOperand2());
+    if (Token::simpleMatch(tok, "!") && Token::simpleMatch(tok->astOperand1(), "!") && !Token::simpleMatch(tok->astParent(), "="))
+        return hash(tok->astOperand1()->astOperand1());
+    // A variable can be the same as the expression it is initialized with.
+    // Use the hash of that expression for all tokens of the variable.
+    if (mFollowVar && tok->varId() && tok->variable()) {
+        const Token *varTok = getVariableInitExpression(tok->variable());
+        if (varTok && mFollowing.insert(tok->varId()).second) {
+            const std::size_t h = hash(varTok);
+            mFollowing.erase(tok->varId());
+            return h;
+        }
+    }
+
+    const std::size_t h1 = hash(tok->astOperand1());
+    const std::size_t h2 = hash(tok->astOperand2());
+
+    // 'a<b' is the same as 'b>a'
+    if (Token::Match(tok, "<|>|<=|>=")) {
+        const std::size_t h = std::hash<std::string>()(tok->str().size() == 1 ? "<" : "<=");
+        return combineHash(combineHash(h, std::min(h1, h2)), std::max(h1, h2));
+    }
+
+    std::size_t h = std::hash<std::string>()(tok->str());
+    h = combineHash(h, tok->varId());
+    h = combineHash(h, std::hash<std::string>()(tok->originalName()));
+    h = combineHash(h, (tok->isComplex() ? 1U : 0U) | (tok->isLong() ? 2U : 0U) | (tok->isUnsigned() ? 4U : 0U) | (tok->isSigned() ? 8U : 0U));
+    if (tok->isBinaryOp() && Token::Match(tok, "%or%|%oror%|+|*|&|&&|^|==|!="))
+        return combineHash(combineHash(h, std::min(h1, h2)), std::max(h1, h2));
+    return combineHash(combineHash(h, h1), h2);
+}
+
 bool isEqualKnownValue(const Token * const tok1, const Token * const tok2)
 {
     return tok1->hasKnownValue() && tok2->hasKnownValue() && tok1->values() == tok2->values();
@@ -738,9 +799,9 @@ bool isUniqueExpression(const Token* tok)
         const Type * varType = var->type();
         // Iterate over the variables in scope and the parameters of the function if possible
         const Function * fun = scope->function;
-        const std::list<Variable>* setOfVars[] = {&scope->varlist, fun ? &fun->argumentList : nullptr};
+        const ChunkedVector<Variable>* setOfVars[] = {&scope->varlist, fun ? &fun->argumentList : nullptr};
 
-        for (const std::list<Variable>* vars:setOfVars) {
+        for (const ChunkedVector<Variable>* vars:setOfVars) {
             if (!vars)
                 continue;
             bool other = std::any_of(vars->cbegin(), vars->cend(), [=](const Variable &v) {
@@ -930,60 +991,71 @@ bool isVariableChangedByFunctionCall(const Token *tok, const Settings *settings,
     return arg && !arg->isConst() && arg->isReference();
 }
 
-bool isVariableChanged(const Token *start, const Token *end, const unsigned int varid, bool globalvar, const Settings *settings, bool cpp)
+/** Is the variable of the given token changed there? */
+static bool isVariableChangedAt(const Token *tok, const Settings *settings, bool cpp)
 {
-    for (const Token *tok = start; tok != end; tok = tok->next()) {
-        if (tok->varId() != varid) {
-            if (globalvar && Token::Match(tok, "%name% ("))
-                // TODO: Is global variable really changed by function call?
-                return true;
-            continue;
-        }
+    const Token *tok2 = tok;
+    while (Token::simpleMatch(tok2->astParent(), "*"))
+        tok2 = tok2->astParent();
 
-        const Token *tok2 = tok;
-        while (Token::simpleMatch(tok2->astParent(), "*"))
-            tok2 = tok2->astParent();
+    if (Token::Match(tok2->astParent(), "++|--"))
+        return true;
 
-        if (Token::Match(tok2->astParent(), "++|--"))
-            return true;
+    if (tok2->astParent() && tok2->astParent()->isAssignmentOp() && tok2 == tok2->astParent()->astOperand1())
+        return true;
 
-        if (tok2->astParent() && tok2->astParent()->isAssignmentOp() && tok2 == tok2->astParent()->astOperand1())
-            return true;
+    if (isLikelyStreamRead(cpp, tok->previous()))
+        return true;
+
+    // Member function call
+    if (Token::Match(tok, "%name% . %name% (")) {
+        const Variable * var = tok->variable();
+        bool isConst = var && var->isConst();
+        if (!isConst && var) {
+            const ValueType * valueType = var->valueType();
+            isConst = (valueType && valueType->pointer == 1 && valueType->constness == 1);
+        }
 
-        if (isLikelyStreamRead(cpp, tok->previous()))
+        const Token *ftok = tok->tokAt(2);
+        const Function * fun = ftok->function();
+        if (!isConst && (!fun || !fun->isConst()))
             return true;
+    }
 
-        // Member function call
-        if (Token::Match(tok, "%name% . %name% (")) {
-            const Variable * var = tok->variable();
-            bool isConst = var && var->isConst();
-            if (!isConst && var) {
-                const ValueType * valueType = var->valueType();
-                isConst = (valueType && valueType->pointer == 1 && valueType->constness == 1);
-            }
+    const Token *ftok = tok;
+    while (ftok && (!Token::Match(ftok, "[({[]") || ftok->isCast()))
+        ftok = ftok->astParent();
 
-            const Token *ftok = tok->tokAt(2);
-            const Function * fun = ftok->function();
-            if (!isConst && (!fun || !fun->isConst()))
-                return true;
-        }
+    if (ftok && Token::Match(ftok->link(), ") !!{")) {
+        bool inconclusive = false;
+        bool isChanged = isVariableChangedByFunctionCall(tok, settings, &inconclusive);
+        isChanged |= inconclusive;
+        if (isChanged)
+            return true;
+    }
+
+    const Token *parent = tok->astParent();
+    while (Token::Match(parent, ".|::"))
+        parent = parent->astParent();
+    if (parent && parent->tokType() == Token::eIncDecOp)
+        return true;
+    return false;
+}
 
-        const Token *ftok = tok;
-        while (ftok && (!Token::Match(ftok, "[({[]") || ftok->isCast()))
-            ftok = ftok->astParent();
+bool isVariableChanged(const Token *start, const Token *end, const unsigned int varid, bool globalvar, const Settings *settings, bool cpp)
+{
+    const DefUseIndex *defUseIndex = (start && varid) ? start->defUseIndex() : nullptr;
+    if (defUseIndex)
+        return defUseIndex->isVariableChanged(start, end, varid, globalvar, settings, cpp);
 
-        if (ftok && Token::Match(ftok->link(), ") !!{")) {
-            bool inconclusive = false;
-            bool isChanged = isVariableChangedByFunctionCall(tok, settings, &inconclusive);
-            isChanged |= inconclusive;
-            if (isChanged)
+    for (const Token *tok = start; tok != end; tok = tok->next()) {
+        if (tok->varId() != varid) {
+            if (globalvar && Token::Match(tok, "%name% ("))
+                // TODO: Is global variable really changed by function call?
                 return true;
+            continue;
         }
-
-        const Token *parent = tok->astParent();
-        while (Token::Match(parent, ".|::"))
-            parent = parent->astParent();
-        if (parent && parent->tokType() == Token::eIncDecOp)
+        if (isVariableChangedAt(tok, settings, cpp))
             return true;
     }
     return false;
@@ -1003,6 +1075,63 @@ bool isVariableChanged(const Variable * var, const Settings *settings, bool cpp)
     return isVariableChanged(start->next(), var->scope()->bodyEnd, var->declarationId(), var->isGlobal(), settings, cpp);
 }
 
+static bool isBeforeIndex(const Token *tok, unsigned int index)
+{
+    return tok->index() < index;
+}
+
+DefUseIndex::DefUseIndex(const Token *front, const Settings *settings, bool cpp)
+    : mSettings(settings), mCpp(cpp)
+{
+    for (const Token *tok = front; tok; tok = tok->next()) {
+        if (Token::Match(tok, "%name% ("))
+            mFunctionCalls.push_back(tok);
+        const unsigned int varid = tok->varId();
+        if (varid == 0)
+            continue;
+        if (varid >= mUses.size()) {
+            mUses.resize(varid + 1);
+            mChanges.resize(varid + 1);
+        }
+        mUses[varid].push_back(tok);
+        if (isVariableChangedAt(tok, settings, cpp))
+            mChanges[varid].push_back(tok);
+    }
+}
+
+bool DefUseIndex::isVariableChanged(const Token *start, const Token *end, unsigned int varid, bool globalvar, const Settings *settings, bool cpp) const
+{
+    const unsigned int startIndex = start->index();
+    // The whole rest of the list is searched if end is not after start
+    const unsigned int endIndex = (end && end->index() >= startIndex) ? end->index() : std::numeric_limits<unsigned int>::max();
+
+    if (globalvar) {
+        // TODO: Is global variable really changed by function call?
+        for (std::vector<const Token *>::const_iterator it = std::lower_bound(mFunctionCalls.begin(), mFunctionCalls.end(), startIndex, isBeforeIndex);
+             it != mFunctionCalls.end() && (*it)->index() < endIndex; ++it) {
+            if ((*it)->varId() != varid)
+                return true;
+        }
+    }
+
+    if (varid >= mUses.size())
+        return false;
+
+    if (settings == mSettings && cpp == mCpp) {
+        const std::vector<const Token *> &changes = mChanges[varid];
+        const std::vector<const Token *>::const_iterator it = std::lower_bound(changes.begin(), changes.end(), startIndex, isBeforeIndex);
+        return it != changes.end() && (*it)->index() < endIndex;
+    }
+
+    const std::vector<const Token *> &uses = mUses[varid];
+    for (std::vector<const Token *>::const_iterator it = std::lower_bound(uses.begin(), uses.end(), startIndex, isBeforeIndex);
+         it != uses.end() && (*it)->index() < endIndex; ++it) {
+        if (isVariableChangedAt(*it, settings, cpp))
+            return true;
+    }
+    return false;
+}
+
 int numberOfArguments(const Token *start)
 {
     int arguments=0;
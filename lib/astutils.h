@@ -22,8 +22,11 @@
 #define astutilsH
 //---------------------------------------------------------------------------
 
+#include <cstddef>
 #include <functional>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "errorlogger.h"
@@ -83,6 +86,33 @@ bool precedes(const Token * tok1, const Token * tok2);
 
 bool isSameExpression(bool cpp, bool macro, const Token *tok1, const Token *tok2, const Library& library, bool pure, bool followVar, ErrorPath* errors=nullptr);
 
+/**
+ * Structural hash of expressions. If isSameExpression() says two expressions
+ * are the same then they have the same hash, for any value of macro and pure.
+ * Different hashes are a cheap proof that the expressions are not the same.
+ * The hash of each AST node is computed the first time it is asked for.
+ */
+class CPPCHECKLIB ExpressionHasher {
+public:
+    ExpressionHasher(bool cpp, bool followVar);
+
+    std::size_t hash(const Token *tok);
+
+    /** Can isSameExpression() be true for these expressions? */
+    bool maybeSame(const Token *tok1, const Token *tok2) {
+        return hash(tok1) == hash(tok2);
+    }
+
+private:
+    std::size_t computeHash(const Token *tok);
+
+    bool mCpp;
+    bool mFollowVar;
+    std::unordered_map<const Token *, std::size_t> mHashes;
+    /** Variables whose initialization expression is being hashed */
+    std::set<unsigned int> mFollowing;
+};
+
 bool isEqualKnownValue(const Token * const tok1, const Token * const tok2);
 
 bool isDifferentKnownValues(const Token * const tok1, const Token * const tok2);
@@ -135,6 +165,32 @@ bool isVariableChanged(const Token *start, const Token *end, const unsigned int
 
 bool isVariableChanged(const Variable * var, const Settings *settings, bool cpp);
 
+/**
+ * Where the variables of a token list are used and changed. It is created
+ * when the token list, the AST and the symbol database are complete. Then
+ * isVariableChanged() only looks at the tokens of the variable in the given
+ * range instead of every token.
+ */
+class CPPCHECKLIB DefUseIndex {
+public:
+    DefUseIndex(const Token *front, const Settings *settings, bool cpp);
+
+    /** Is variable changed from start up to end? Same result as isVariableChanged() */
+    bool isVariableChanged(const Token *start, const Token *end, unsigned int varid, bool globalvar, const Settings *settings, bool cpp) const;
+
+private:
+    /** Settings used to find the changes */
+    const Settings *mSettings;
+    bool mCpp;
+
+    /** Tokens of each varid, ordered by Token::index() */
+    std::vector<std::vector<const Token *>> mUses;
+    /** Tokens of each varid where the variable is changed */
+    std::vector<std::vector<const Token *>> mChanges;
+    /** Function calls */
+    std::vector<const Token *> mFunctionCalls;
+};
+
 /** Determines the number of arguments - if token is a function call or macro
  * @param start token which is supposed to be the function/macro name.
  * \return Number of arguments
@@ -20,7 +20,10 @@
 
 #include "check.h"
 
+#include "symboldatabase.h"
+
 #include <iostream>
+#include <unordered_map>
 
 //---------------------------------------------------------------------------
 
@@ -36,6 +39,18 @@ Check::Check(const std::string &aname)
     instances().push_back(this);
 }
 
+bool Check::canReport(const Settings *settings) const
+{
+    // Debug warnings can be reported for any severity
+    if (settings->debugwarnings)
+        return true;
+    for (Severity::SeverityType severity : severities()) {
+        if (settings->isEnabled(severity))
+            return true;
+    }
+    return false;
+}
+
 void Check::reportError(const ErrorLogger::ErrorMessage &errmsg)
 {
     std::cout << errmsg.toXML() << std::endl;
@@ -66,3 +81,56 @@ std::list<Check *> &Check::instances()
     return _instances;
 #endif
 }
+
+void TokenDispatcher::visit(Kind kind, bool inFunctionBody, const Token *tok) const
+{
+    for (const Visitor &visitor : mVisitors[EVERYWHERE][kind])
+        visitor(tok);
+    if (inFunctionBody) {
+        for (const Visitor &visitor : mVisitors[FUNCTION_BODIES][kind])
+            visitor(tok);
+    }
+}
+
+void TokenDispatcher::dispatch(const Tokenizer *tokenizer) const
+{
+    std::unordered_map<const Token *, const Token *> functionBodies;
+    for (const Scope *scope : tokenizer->getSymbolDatabase()->functionScopes)
+        functionBodies[scope->bodyStart] = scope->bodyEnd;
+
+    // End of the outermost function body that tok is in
+    const Token *bodyEnd = nullptr;
+
+    for (const Token *tok = tokenizer->tokens(); tok; tok = tok->next()) {
+        if (tok == bodyEnd)
+            bodyEnd = nullptr;
+        const bool inFunctionBody = (bodyEnd != nullptr);
+
+        visit(ANY, inFunctionBody, tok);
+        if (tok->isName()) {
+            if (tok->str() == "sizeof")
+                visit(SIZEOF, inFunctionBody, tok);
+            if (tok->strAt(1) == "(")
+                visit(FUNCTION_CALL, inFunctionBody, tok);
+            if (tok->variable() && tok->variable()->nameToken() == tok)
+                visit(VARIABLE_DECLARATION, inFunctionBody, tok);
+        } else if (tok->isAssignmentOp())
+            visit(ASSIGNMENT, inFunctionBody, tok);
+        else if (tok->isComparisonOp())
+            visit(COMPARISON, inFunctionBody, tok);
+        else if (tok->tokType() == Token::eIncDecOp)
+            visit(INC_DEC, inFunctionBody, tok);
+        else if (tok->str() == "[")
+            visit(SUBSCRIPT, inFunctionBody, tok);
+        else if (tok->str() == "{")
+            visit(SCOPE_BEGIN, inFunctionBody, tok);
+        else if (tok->str() == "}")
+            visit(SCOPE_END, inFunctionBody, tok);
+
+        if (!bodyEnd && tok->str() == "{") {
+            const std::unordered_map<const Token *, const Token *>::const_iterator it = functionBodies.find(tok);
+            if (it != functionBodies.end())
+                bodyEnd = it->second;
+        }
+    }
+}
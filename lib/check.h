@@ -28,8 +28,11 @@
 #include "tokenize.h"
 #include "valueflow.h"
 
+#include <functional>
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace tinyxml2 {
     class XMLElement;
@@ -39,6 +42,8 @@ namespace CTU {
     class FileInfo;
 }
 
+class TokenDispatcher;
+
 /** Use WRONG_DATA in checkers to mark conditions that check that data is correct */
 #define WRONG_DATA(COND, TOK)  (wrongData((TOK), (COND), #COND))
 
@@ -70,6 +75,37 @@ public:
     /** run checks, the token list is not simplified */
     virtual void runChecks(const Tokenizer *, const Settings *, ErrorLogger *) = 0;
 
+    /**
+     * Subscribe to the tokens that the check looks at. Cppcheck then walks
+     * the tokens once for all subscribed checks instead of calling their
+     * runChecks(). Returns false if the check does not subscribe.
+     */
+    virtual bool subscribe(TokenDispatcher &dispatcher, const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+        (void)dispatcher;
+        (void)tokenizer;
+        (void)settings;
+        (void)errorLogger;
+        return false;
+    }
+
+    /** Severities that runChecks() can report. By default all of them. */
+    virtual std::vector<Severity::SeverityType> severities() const {
+        return {Severity::error, Severity::warning, Severity::style, Severity::performance, Severity::portability, Severity::information};
+    }
+
+    /** Is runChecks() needed, can it report anything with these settings? */
+    bool canReport(const Settings *settings) const;
+
+    /**
+     * Optional analysis results that runChecks() reads, Settings::Analysis
+     * flags. ValueFlow values are always computed, nearly all checks that
+     * report errors read them.
+     */
+    virtual int analysis(const Settings *settings) const {
+        (void)settings;
+        return 0;
+    }
+
     /** get error messages */
     virtual void getErrorMessages(ErrorLogger *errorLogger, const Settings *settings) const = 0;
 
@@ -190,6 +226,66 @@ private:
     Check(const Check &) = delete;
 };
 
+/**
+ * @brief Walks the tokens once and calls the visitors that checks subscribed,
+ * see Check::subscribe(). Visitors get the tokens of their kind in the order
+ * of the token list.
+ */
+class CPPCHECKLIB TokenDispatcher {
+public:
+    /** Kinds of tokens */
+    enum Kind {
+        ANY,                  ///< every token
+        FUNCTION_CALL,        ///< name followed by "(", also keywords such as "if" and "sizeof"
+        ASSIGNMENT,           ///< assignment operator
+        COMPARISON,           ///< comparison operator
+        SUBSCRIPT,            ///< "["
+        INC_DEC,              ///< "++" and "--"
+        SIZEOF,               ///< "sizeof"
+        SCOPE_BEGIN,          ///< "{"
+        SCOPE_END,            ///< "}"
+        VARIABLE_DECLARATION, ///< name token of a variable declaration
+        KINDS
+    };
+
+    /** Where the tokens are */
+    enum Where {
+        EVERYWHERE,
+        FUNCTION_BODIES       ///< between the braces of function bodies
+    };
+
+    typedef std::function<void(const Token *)> Visitor;
+
+    TokenDispatcher() {}
+
+    /** Keep check instance alive until the tokens are walked */
+    template<class T>
+    T *add(T *check) {
+        mChecks.emplace_back(check);
+        return check;
+    }
+
+    void subscribe(Kind kind, Where where, const Visitor &visitor) {
+        mVisitors[where][kind].push_back(visitor);
+    }
+
+    template<class T>
+    void subscribe(Kind kind, Where where, T *check, void (T::*visit)(const Token *)) {
+        subscribe(kind, where, [check, visit](const Token *tok) {
+            (check->*visit)(tok);
+        });
+    }
+
+    /** Walk the tokens and call the visitors */
+    void dispatch(const Tokenizer *tokenizer) const;
+
+private:
+    void visit(Kind kind, bool inFunctionBody, const Token *tok) const;
+
+    std::vector<Visitor> mVisitors[2][KINDS];
+    std::vector<std::unique_ptr<Check>> mChecks;
+};
+
 /// @}
 //---------------------------------------------------------------------------
 #endif //  checkH
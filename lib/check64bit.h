@@ -26,6 +26,7 @@
 #include "config.h"
 
 #include <string>
+#include <vector>
 
 class ErrorLogger;
 class Settings;
@@ -57,6 +58,10 @@ public:
         check64BitPortability.pointerassignment();
     }
 
+    std::vector<Severity::SeverityType> severities() const OVERRIDE {
+        return {Severity::portability};
+    }
+
     /** Check for pointer assignment */
     void pointerassignment();
 
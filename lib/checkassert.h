@@ -26,6 +26,7 @@
 #include "config.h"
 
 #include <string>
+#include <vector>
 
 class ErrorLogger;
 class Scope;
@@ -55,6 +56,10 @@ public:
         checkAssert.assertWithSideEffects();
     }
 
+    std::vector<Severity::SeverityType> severities() const OVERRIDE {
+        return {Severity::warning};
+    }
+
     void assertWithSideEffects();
 
 protected:
@@ -49,20 +49,43 @@ static bool isBool(const Variable* var)
 }
 
 //---------------------------------------------------------------------------
-void CheckBool::checkIncrementBoolean()
+void CheckBool::subscribeChecks(TokenDispatcher &dispatcher)
 {
-    if (!mSettings->isEnabled(Settings::STYLE))
-        return;
+    const bool printStyle = mSettings->isEnabled(Settings::STYLE);
+    const bool printWarning = mSettings->isEnabled(Settings::WARNING);
+    const bool cpp = mTokenizer->isCPP();
+
+    if (printWarning)
+        dispatcher.subscribe(TokenDispatcher::COMPARISON, TokenDispatcher::FUNCTION_BODIES, this, &CheckBool::checkComparisonOfBoolExpressionWithInt);
+    if (printWarning && cpp)
+        dispatcher.subscribe(TokenDispatcher::COMPARISON, TokenDispatcher::FUNCTION_BODIES, this, &CheckBool::checkComparisonOfBoolWithInt);
+    if (printStyle && cpp)
+        dispatcher.subscribe(TokenDispatcher::ASSIGNMENT, TokenDispatcher::FUNCTION_BODIES, this, &CheckBool::checkAssignBoolToFloat);
+    dispatcher.subscribe(TokenDispatcher::SCOPE_BEGIN, TokenDispatcher::EVERYWHERE, this, &CheckBool::pointerArithBool);
+    if (printStyle)
+        dispatcher.subscribe(TokenDispatcher::SCOPE_BEGIN, TokenDispatcher::EVERYWHERE, this, &CheckBool::returnValueOfFunctionReturningBool);
+    if (printStyle && cpp)
+        dispatcher.subscribe(TokenDispatcher::COMPARISON, TokenDispatcher::FUNCTION_BODIES, this, &CheckBool::checkComparisonOfFuncReturningBool);
+    // FIXME: This checking is "experimental" because of the false positives
+    //        when self checking lib/tokenize.cpp (#2617)
+    if (mSettings->experimental && printStyle && cpp)
+        dispatcher.subscribe(TokenDispatcher::COMPARISON, TokenDispatcher::FUNCTION_BODIES, this, &CheckBool::checkComparisonOfBoolWithBool);
+    if (printStyle)
+        dispatcher.subscribe(TokenDispatcher::INC_DEC, TokenDispatcher::FUNCTION_BODIES, this, &CheckBool::checkIncrementBoolean);
+    dispatcher.subscribe(TokenDispatcher::ASSIGNMENT, TokenDispatcher::FUNCTION_BODIES, this, &CheckBool::checkAssignBoolToPointer);
+    // danmar: this is inconclusive because I don't like that there are
+    //         warnings for calculations. Example: set_flag(a & b);
+    if (printStyle && mSettings->inconclusive)
+        dispatcher.subscribe(TokenDispatcher::ANY, TokenDispatcher::FUNCTION_BODIES, this, &CheckBool::checkBitwiseOnBoolean);
+}
 
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (Token::Match(tok, "%var% ++")) {
-                const Variable *var = tok->variable();
-                if (isBool(var))
-                    incrementBooleanError(tok);
-            }
-        }
+//---------------------------------------------------------------------------
+void CheckBool::checkIncrementBoolean(const Token *tok)
+{
+    if (Token::Match(tok->previous(), "%var% ++")) {
+        const Variable *var = tok->previous()->variable();
+        if (isBool(var))
+            incrementBooleanError(tok->previous());
     }
 }
 
@@ -82,32 +105,25 @@ void CheckBool::incrementBooleanError(const Token *tok)
 // if (bool & bool) -> if (bool && bool)
 // if (bool | bool) -> if (bool || bool)
 //---------------------------------------------------------------------------
-void CheckBool::checkBitwiseOnBoolean()
+void CheckBool::checkBitwiseOnBoolean(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::STYLE))
-        return;
-
-    // danmar: this is inconclusive because I don't like that there are
-    //         warnings for calculations. Example: set_flag(a & b);
-    if (!mSettings->inconclusive)
-        return;
+    if (mBitwiseOnBooleanSkip) {
+        if (tok->index() <= mBitwiseOnBooleanSkip->index())
+            return;
+        mBitwiseOnBooleanSkip = nullptr;
+    }
 
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (Token::Match(tok, "(|.|return|&&|%oror%|throw|, %var% [&|]")) {
-                const Variable *var = tok->next()->variable();
-                if (isBool(var)) {
-                    bitwiseOnBooleanError(tok->next(), var->name(), tok->strAt(2) == "&" ? "&&" : "||");
-                    tok = tok->tokAt(2);
-                }
-            } else if (Token::Match(tok, "[&|] %var% )|.|return|&&|%oror%|throw|,") && (!tok->previous() || !tok->previous()->isExtendedOp() || tok->strAt(-1) == ")" || tok->strAt(-1) == "]")) {
-                const Variable *var = tok->next()->variable();
-                if (isBool(var)) {
-                    bitwiseOnBooleanError(tok->next(), var->name(), tok->str() == "&" ? "&&" : "||");
-                    tok = tok->tokAt(2);
-                }
-            }
+    if (Token::Match(tok, "(|.|return|&&|%oror%|throw|, %var% [&|]")) {
+        const Variable *var = tok->next()->variable();
+        if (isBool(var)) {
+            bitwiseOnBooleanError(tok->next(), var->name(), tok->strAt(2) == "&" ? "&&" : "||");
+            mBitwiseOnBooleanSkip = tok->tokAt(2);
+        }
+    } else if (Token::Match(tok, "[&|] %var% )|.|return|&&|%oror%|throw|,") && (!tok->previous() || !tok->previous()->isExtendedOp() || tok->strAt(-1) == ")" || tok->strAt(-1) == "]")) {
+        const Variable *var = tok->next()->variable();
+        if (isBool(var)) {
+            bitwiseOnBooleanError(tok->next(), var->name(), tok->str() == "&" ? "&&" : "||");
+            mBitwiseOnBooleanSkip = tok->tokAt(2);
         }
     }
 }
@@ -124,27 +140,19 @@ void CheckBool::bitwiseOnBooleanError(const Token *tok, const std::string &varna
 //    if (!x==3) <- Probably meant to be "x!=3"
 //---------------------------------------------------------------------------
 
-void CheckBool::checkComparisonOfBoolWithInt()
+void CheckBool::checkComparisonOfBoolWithInt(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING) || !mTokenizer->isCPP())
+    if (!tok->isBinaryOp())
         return;
-
-    const SymbolDatabase* const symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (!tok->isComparisonOp() || !tok->isBinaryOp())
-                continue;
-            const Token* const left = tok->astOperand1();
-            const Token* const right = tok->astOperand2();
-            if (left->isBoolean() && right->varId()) { // Comparing boolean constant with variable
-                if (tok->str() != "==" && tok->str() != "!=") {
-                    comparisonOfBoolWithInvalidComparator(right, left->str());
-                }
-            } else if (left->varId() && right->isBoolean()) { // Comparing variable with boolean constant
-                if (tok->str() != "==" && tok->str() != "!=") {
-                    comparisonOfBoolWithInvalidComparator(right, left->str());
-                }
-            }
+    const Token* const left = tok->astOperand1();
+    const Token* const right = tok->astOperand2();
+    if (left->isBoolean() && right->varId()) { // Comparing boolean constant with variable
+        if (tok->str() != "==" && tok->str() != "!=") {
+            comparisonOfBoolWithInvalidComparator(right, left->str());
+        }
+    } else if (left->varId() && right->isBoolean()) { // Comparing variable with boolean constant
+        if (tok->str() != "==" && tok->str() != "!=") {
+            comparisonOfBoolWithInvalidComparator(right, left->str());
         }
     }
 }
@@ -173,38 +181,26 @@ static bool tokenIsFunctionReturningBool(const Token* tok)
     return false;
 }
 
-void CheckBool::checkComparisonOfFuncReturningBool()
+void CheckBool::checkComparisonOfFuncReturningBool(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::STYLE))
+    if (tok->str() == "==" || tok->str() == "!=")
         return;
-
-    if (!mTokenizer->isCPP())
-        return;
-
-    const SymbolDatabase * const symbolDatabase = mTokenizer->getSymbolDatabase();
-
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (!tok->isComparisonOp() || tok->str() == "==" || tok->str() == "!=")
-                continue;
-            const Token *firstToken = tok->previous();
-            if (tok->strAt(-1) == ")") {
-                firstToken = firstToken->link()->previous();
-            }
-            const Token *secondToken = tok->next();
-            while (secondToken->str() == "!") {
-                secondToken = secondToken->next();
-            }
-            const bool firstIsFunctionReturningBool = tokenIsFunctionReturningBool(firstToken);
-            const bool secondIsFunctionReturningBool = tokenIsFunctionReturningBool(secondToken);
-            if (firstIsFunctionReturningBool && secondIsFunctionReturningBool) {
-                comparisonOfTwoFuncsReturningBoolError(firstToken->next(), firstToken->str(), secondToken->str());
-            } else if (firstIsFunctionReturningBool) {
-                comparisonOfFuncReturningBoolError(firstToken->next(), firstToken->str());
-            } else if (secondIsFunctionReturningBool) {
-                comparisonOfFuncReturningBoolError(secondToken->previous(), secondToken->str());
-            }
-        }
+    const Token *firstToken = tok->previous();
+    if (tok->strAt(-1) == ")") {
+        firstToken = firstToken->link()->previous();
+    }
+    const Token *secondToken = tok->next();
+    while (secondToken->str() == "!") {
+        secondToken = secondToken->next();
+    }
+    const bool firstIsFunctionReturningBool = tokenIsFunctionReturningBool(firstToken);
+    const bool secondIsFunctionReturningBool = tokenIsFunctionReturningBool(secondToken);
+    if (firstIsFunctionReturningBool && secondIsFunctionReturningBool) {
+        comparisonOfTwoFuncsReturningBoolError(firstToken->next(), firstToken->str(), secondToken->str());
+    } else if (firstIsFunctionReturningBool) {
+        comparisonOfFuncReturningBoolError(firstToken->next(), firstToken->str());
+    } else if (secondIsFunctionReturningBool) {
+        comparisonOfFuncReturningBoolError(secondToken->previous(), secondToken->str());
     }
 }
 
@@ -230,48 +226,31 @@ void CheckBool::comparisonOfTwoFuncsReturningBoolError(const Token *tok, const s
 // Comparison of bool with bool
 //-------------------------------------------------------------------------------
 
-void CheckBool::checkComparisonOfBoolWithBool()
+void CheckBool::checkComparisonOfBoolWithBool(const Token *tok)
 {
-    // FIXME: This checking is "experimental" because of the false positives
-    //        when self checking lib/tokenize.cpp (#2617)
-    if (!mSettings->experimental)
-        return;
-
-    if (!mSettings->isEnabled(Settings::STYLE))
+    if (tok->str() == "==" || tok->str() == "!=")
         return;
+    bool firstTokenBool = false;
 
-    if (!mTokenizer->isCPP())
+    const Token *firstToken = tok->previous();
+    if (firstToken->varId()) {
+        if (isBool(firstToken->variable())) {
+            firstTokenBool = true;
+        }
+    }
+    if (!firstTokenBool)
         return;
 
-    const SymbolDatabase* const symbolDatabase = mTokenizer->getSymbolDatabase();
-
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (!tok->isComparisonOp() || tok->str() == "==" || tok->str() == "!=")
-                continue;
-            bool firstTokenBool = false;
-
-            const Token *firstToken = tok->previous();
-            if (firstToken->varId()) {
-                if (isBool(firstToken->variable())) {
-                    firstTokenBool = true;
-                }
-            }
-            if (!firstTokenBool)
-                continue;
-
-            bool secondTokenBool = false;
-            const Token *secondToken = tok->next();
-            if (secondToken->varId()) {
-                if (isBool(secondToken->variable())) {
-                    secondTokenBool = true;
-                }
-            }
-            if (secondTokenBool) {
-                comparisonOfBoolWithBoolError(firstToken->next(), secondToken->str());
-            }
+    bool secondTokenBool = false;
+    const Token *secondToken = tok->next();
+    if (secondToken->varId()) {
+        if (isBool(secondToken->variable())) {
+            secondTokenBool = true;
         }
     }
+    if (secondTokenBool) {
+        comparisonOfBoolWithBoolError(firstToken->next(), secondToken->str());
+    }
 }
 
 void CheckBool::comparisonOfBoolWithBoolError(const Token *tok, const std::string &expression)
@@ -284,23 +263,18 @@ void CheckBool::comparisonOfBoolWithBoolError(const Token *tok, const std::strin
 }
 
 //-----------------------------------------------------------------------------
-void CheckBool::checkAssignBoolToPointer()
+void CheckBool::checkAssignBoolToPointer(const Token *tok)
 {
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart; tok != scope->bodyEnd; tok = tok->next()) {
-            if (tok->str() != "=")
-                continue;
-            const ValueType *lhsType = tok->astOperand1() ? tok->astOperand1()->valueType() : nullptr;
-            if (!lhsType || lhsType->pointer == 0)
-                continue;
-            const ValueType *rhsType = tok->astOperand2() ? tok->astOperand2()->valueType() : nullptr;
-            if (!rhsType || rhsType->pointer > 0 || rhsType->type != ValueType::Type::BOOL)
-                continue;
-
-            assignBoolToPointerError(tok);
-        }
-    }
+    if (tok->str() != "=")
+        return;
+    const ValueType *lhsType = tok->astOperand1() ? tok->astOperand1()->valueType() : nullptr;
+    if (!lhsType || lhsType->pointer == 0)
+        return;
+    const ValueType *rhsType = tok->astOperand2() ? tok->astOperand2()->valueType() : nullptr;
+    if (!rhsType || rhsType->pointer > 0 || rhsType->type != ValueType::Type::BOOL)
+        return;
+
+    assignBoolToPointerError(tok);
 }
 
 void CheckBool::assignBoolToPointerError(const Token *tok)
@@ -311,59 +285,47 @@ void CheckBool::assignBoolToPointerError(const Token *tok)
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-void CheckBool::checkComparisonOfBoolExpressionWithInt()
+void CheckBool::checkComparisonOfBoolExpressionWithInt(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
+    const Token* numTok = nullptr;
+    const Token* boolExpr = nullptr;
+    bool numInRhs;
+    if (astIsBool(tok->astOperand1())) {
+        boolExpr = tok->astOperand1();
+        numTok = tok->astOperand2();
+        numInRhs = true;
+    } else if (astIsBool(tok->astOperand2())) {
+        boolExpr = tok->astOperand2();
+        numTok = tok->astOperand1();
+        numInRhs = false;
+    } else {
         return;
-
-    const SymbolDatabase* symbolDatabase = mTokenizer->getSymbolDatabase();
-
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (!tok->isComparisonOp())
-                continue;
-
-            const Token* numTok = nullptr;
-            const Token* boolExpr = nullptr;
-            bool numInRhs;
-            if (astIsBool(tok->astOperand1())) {
-                boolExpr = tok->astOperand1();
-                numTok = tok->astOperand2();
-                numInRhs = true;
-            } else if (astIsBool(tok->astOperand2())) {
-                boolExpr = tok->astOperand2();
-                numTok = tok->astOperand1();
-                numInRhs = false;
-            } else {
-                continue;
-            }
-
-            if (!numTok || !boolExpr)
-                continue;
-
-            if (boolExpr->isOp() && numTok->isName() && Token::Match(tok, "==|!="))
-                // there is weird code such as:  ((a<b)==c)
-                // but it is probably written this way by design.
-                continue;
-
-            if (astIsBool(numTok))
-                continue;
-
-            if (numTok->isNumber()) {
-                const MathLib::bigint num = MathLib::toLongNumber(numTok->str());
-                if (num==0 &&
-                    (numInRhs ? Token::Match(tok, ">|==|!=")
-                     : Token::Match(tok, "<|==|!=")))
-                    continue;
-                if (num==1 &&
-                    (numInRhs ? Token::Match(tok, "<|==|!=")
-                     : Token::Match(tok, ">|==|!=")))
-                    continue;
-                comparisonOfBoolExpressionWithIntError(tok, true);
-            } else if (astIsIntegral(numTok, false) && mTokenizer->isCPP())
-                comparisonOfBoolExpressionWithIntError(tok, false);
-        }
     }
+
+    if (!numTok || !boolExpr)
+        return;
+
+    if (boolExpr->isOp() && numTok->isName() && Token::Match(tok, "==|!="))
+        // there is weird code such as:  ((a<b)==c)
+        // but it is probably written this way by design.
+        return;
+
+    if (astIsBool(numTok))
+        return;
+
+    if (numTok->isNumber()) {
+        const MathLib::bigint num = MathLib::toLongNumber(numTok->str());
+        if (num==0 &&
+            (numInRhs ? Token::Match(tok, ">|==|!=")
+             : Token::Match(tok, "<|==|!=")))
+            return;
+        if (num==1 &&
+            (numInRhs ? Token::Match(tok, "<|==|!=")
+             : Token::Match(tok, ">|==|!=")))
+            return;
+        comparisonOfBoolExpressionWithIntError(tok, true);
+    } else if (astIsIntegral(numTok, false) && mTokenizer->isCPP())
+        comparisonOfBoolExpressionWithIntError(tok, false);
 }
 
 void CheckBool::comparisonOfBoolExpressionWithIntError(const Token *tok, bool n0o1)
@@ -377,25 +339,24 @@ void CheckBool::comparisonOfBoolExpressionWithIntError(const Token *tok, bool n0
 }
 
 
-void CheckBool::pointerArithBool()
+void CheckBool::pointerArithBool(const Token *tok)
 {
-    const SymbolDatabase* symbolDatabase = mTokenizer->getSymbolDatabase();
-
-    for (const Scope &scope : symbolDatabase->scopeList) {
-        if (scope.type != Scope::eIf && scope.type != Scope::eWhile && scope.type != Scope::eDo && scope.type != Scope::eFor)
-            continue;
-        const Token* tok = scope.classDef->next()->astOperand2();
-        if (scope.type == Scope::eFor) {
-            tok = Token::findsimplematch(scope.classDef->tokAt(2), ";");
-            if (tok)
-                tok = tok->astOperand2();
-            if (tok)
-                tok = tok->astOperand1();
-        } else if (scope.type == Scope::eDo)
-            tok = (scope.bodyEnd->tokAt(2)) ? scope.bodyEnd->tokAt(2)->astOperand2() : nullptr;
-
-        pointerArithBoolCond(tok);
-    }
+    const Scope *scope = tok->scope();
+    if (tok != scope->bodyStart)
+        return;
+    if (scope->type != Scope::eIf && scope->type != Scope::eWhile && scope->type != Scope::eDo && scope->type != Scope::eFor)
+        return;
+    const Token* cond = scope->classDef->next()->astOperand2();
+    if (scope->type == Scope::eFor) {
+        cond = Token::findsimplematch(scope->classDef->tokAt(2), ";");
+        if (cond)
+            cond = cond->astOperand2();
+        if (cond)
+            cond = cond->astOperand1();
+    } else if (scope->type == Scope::eDo)
+        cond = (scope->bodyEnd->tokAt(2)) ? scope->bodyEnd->tokAt(2)->astOperand2() : nullptr;
+
+    pointerArithBoolCond(cond);
 }
 
 void CheckBool::pointerArithBoolCond(const Token *tok)
@@ -427,26 +388,17 @@ void CheckBool::pointerArithBoolError(const Token *tok)
                 "Converting pointer arithmetic result to bool. The boolean result is always true unless there is pointer arithmetic overflow, and overflow is undefined behaviour. Probably a dereference is forgotten.", CWE571, false);
 }
 
-void CheckBool::checkAssignBoolToFloat()
+void CheckBool::checkAssignBoolToFloat(const Token *tok)
 {
-    if (!mTokenizer->isCPP())
-        return;
-    if (!mSettings->isEnabled(Settings::STYLE))
-        return;
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart; tok != scope->bodyEnd; tok = tok->next()) {
-            if (tok->str() == "=" && astIsBool(tok->astOperand2())) {
-                const Token *lhs = tok->astOperand1();
-                while (lhs && (lhs->str() == "." || lhs->str() == "::"))
-                    lhs = lhs->astOperand2();
-                if (!lhs || !lhs->variable())
-                    continue;
-                const Variable* var = lhs->variable();
-                if (var && var->isFloatingType() && !var->isArrayOrPointer())
-                    assignBoolToFloatError(tok->next());
-            }
-        }
+    if (tok->str() == "=" && astIsBool(tok->astOperand2())) {
+        const Token *lhs = tok->astOperand1();
+        while (lhs && (lhs->str() == "." || lhs->str() == "::"))
+            lhs = lhs->astOperand2();
+        if (!lhs || !lhs->variable())
+            return;
+        const Variable* var = lhs->variable();
+        if (var && var->isFloatingType() && !var->isArrayOrPointer())
+            assignBoolToFloatError(tok->next());
     }
 }
 
@@ -456,29 +408,25 @@ void CheckBool::assignBoolToFloatError(const Token *tok)
                 "Boolean value assigned to floating point variable.", CWE704, false);
 }
 
-void CheckBool::returnValueOfFunctionReturningBool(void)
+void CheckBool::returnValueOfFunctionReturningBool(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::STYLE))
+    const Scope *scope = tok->scope();
+    if (tok != scope->bodyStart || scope->type != Scope::eFunction)
+        return;
+    if (!(scope->function && Token::Match(scope->function->retDef, "bool|_Bool")))
         return;
 
-    const SymbolDatabase * const symbolDatabase = mTokenizer->getSymbolDatabase();
-
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        if (!(scope->function && Token::Match(scope->function->retDef, "bool|_Bool")))
-            continue;
-
-        for (const Token* tok = scope->bodyStart->next(); tok && (tok != scope->bodyEnd); tok = tok->next()) {
-            // Skip lambdas
-            const Token* tok2 = findLambdaEndToken(tok);
-            if (tok2)
-                tok = tok2;
-            else if (tok->scope() && tok->scope()->isClassOrStruct())
-                tok = tok->scope()->bodyEnd;
-            else if (Token::simpleMatch(tok, "return") && tok->astOperand1() &&
-                     (tok->astOperand1()->getValueGE(2, mSettings) || tok->astOperand1()->getValueLE(-1, mSettings)) &&
-                     !(tok->astOperand1()->astOperand1() && Token::Match(tok->astOperand1(), "&|%or%")))
-                returnValueBoolError(tok);
-        }
+    for (tok = scope->bodyStart->next(); tok && (tok != scope->bodyEnd); tok = tok->next()) {
+        // Skip lambdas
+        const Token* tok2 = findLambdaEndToken(tok);
+        if (tok2)
+            tok = tok2;
+        else if (tok->scope() && tok->scope()->isClassOrStruct())
+            tok = tok->scope()->bodyEnd;
+        else if (Token::simpleMatch(tok, "return") && tok->astOperand1() &&
+                 (tok->astOperand1()->getValueGE(2, mSettings) || tok->astOperand1()->getValueLE(-1, mSettings)) &&
+                 !(tok->astOperand1()->astOperand1() && Token::Match(tok->astOperand1(), "&|%or%")))
+            returnValueBoolError(tok);
     }
 }
 
@@ -41,63 +41,65 @@ class Tokenizer;
 class CPPCHECKLIB CheckBool : public Check {
 public:
     /** @brief This constructor is used when registering the CheckClass */
-    CheckBool() : Check(myName()) {
+    CheckBool() : Check(myName()), mBitwiseOnBooleanSkip(nullptr) {
     }
 
     /** @brief This constructor is used when running checks. */
     CheckBool(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
-        : Check(myName(), tokenizer, settings, errorLogger) {
+        : Check(myName(), tokenizer, settings, errorLogger), mBitwiseOnBooleanSkip(nullptr) {
     }
 
     /** @brief Run checks against the normal token list */
     void runChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) OVERRIDE {
-        CheckBool checkBool(tokenizer, settings, errorLogger);
-
-        // Checks
-        checkBool.checkComparisonOfBoolExpressionWithInt();
-        checkBool.checkComparisonOfBoolWithInt();
-        checkBool.checkAssignBoolToFloat();
-        checkBool.pointerArithBool();
-        checkBool.returnValueOfFunctionReturningBool();
-        checkBool.checkComparisonOfFuncReturningBool();
-        checkBool.checkComparisonOfBoolWithBool();
-        checkBool.checkIncrementBoolean();
-        checkBool.checkAssignBoolToPointer();
-        checkBool.checkBitwiseOnBoolean();
+        TokenDispatcher dispatcher;
+        if (subscribe(dispatcher, tokenizer, settings, errorLogger))
+            dispatcher.dispatch(tokenizer);
+    }
+
+    bool subscribe(TokenDispatcher &dispatcher, const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) OVERRIDE {
+        CheckBool *checkBool = dispatcher.add(new CheckBool(tokenizer, settings, errorLogger));
+        checkBool->subscribeChecks(dispatcher);
+        return true;
     }
 
     /** @brief %Check for comparison of function returning bool*/
-    void checkComparisonOfFuncReturningBool();
+    void checkComparisonOfFuncReturningBool(const Token *tok);
 
     /** @brief %Check for comparison of variable of type bool*/
-    void checkComparisonOfBoolWithBool();
+    void checkComparisonOfBoolWithBool(const Token *tok);
 
     /** @brief %Check for using postfix increment on bool */
-    void checkIncrementBoolean();
+    void checkIncrementBoolean(const Token *tok);
 
     /** @brief %Check for suspicious comparison of a bool and a non-zero (and non-one) value (e.g. "if (!x==4)") */
-    void checkComparisonOfBoolWithInt();
+    void checkComparisonOfBoolWithInt(const Token *tok);
 
     /** @brief assigning bool to pointer */
-    void checkAssignBoolToPointer();
+    void checkAssignBoolToPointer(const Token *tok);
 
     /** @brief assigning bool to float */
-    void checkAssignBoolToFloat();
+    void checkAssignBoolToFloat(const Token *tok);
 
     /** @brief %Check for using bool in bitwise expression */
-    void checkBitwiseOnBoolean();
+    void checkBitwiseOnBoolean(const Token *tok);
 
     /** @brief %Check for comparing a bool expression with an integer other than 0 or 1 */
-    void checkComparisonOfBoolExpressionWithInt();
+    void checkComparisonOfBoolExpressionWithInt(const Token *tok);
 
     /** @brief %Check for 'if (p+1)' etc. either somebody forgot to dereference, or else somebody uses pointer overflow */
-    void pointerArithBool();
+    void pointerArithBool(const Token *tok);
     void pointerArithBoolCond(const Token *tok);
 
     /** @brief %Check if a function returning bool returns an integer other than 0 or 1 */
-    void returnValueOfFunctionReturningBool();
+    void returnValueOfFunctionReturningBool(const Token *tok);
 
 private:
+    /** Subscribe the enabled checks */
+    void subscribeChecks(TokenDispatcher &dispatcher);
+
+    /** Last token that checkBitwiseOnBoolean() skips */
+    const Token *mBitwiseOnBooleanSkip;
+
     // Error messages..
     void comparisonOfFuncReturningBoolError(const Token *tok, const std::string &expression);
     void comparisonOfTwoFuncsReturningBoolError(const Token *tok, const std::string &expression1, const std::string &expression2);
@@ -64,7 +64,7 @@ static const CWE CWE_BUFFER_OVERRUN(788U);   // Access of Memory Location After
 
 static const ValueFlow::Value *getBufferSizeValue(const Token *tok)
 {
-    const std::list<ValueFlow::Value> &tokenValues = tok->values();
+    const ValueFlow::ValueList &tokenValues = tok->values();
     const auto it = std::find_if(tokenValues.begin(), tokenValues.end(), std::mem_fn(&ValueFlow::Value::isBufferSizeValue));
     return it == tokenValues.end() ? nullptr : &*it;
 }
@@ -223,6 +223,35 @@ static bool getDimensionsEtc(const Token * const arrayToken, const Settings *set
     return !dimensions->empty();
 }
 
+/** Largest int value or int range of index */
+static const ValueFlow::Value *getMaxIndexValue(const Token *indexToken, bool condition)
+{
+    const ValueFlow::Value *ret = indexToken->getMaxValue(condition);
+    for (const ValueFlow::Value &value : indexToken->values()) {
+        if (value.isIntRangeValue() && (value.condition != nullptr) == condition && (!ret || value.intvalueMax > ret->maxIntValue()))
+            ret = &value;
+    }
+    return ret;
+}
+
+/** Negative int value or int range of index */
+static const ValueFlow::Value *getNegativeIndexValue(const Token *indexToken, const Settings *settings)
+{
+    const ValueFlow::Value *ret = indexToken->getValueLE(-1, settings);
+    if (ret)
+        return ret;
+    for (const ValueFlow::Value &value : indexToken->values()) {
+        if (!value.isIntRangeValue() || value.intvalue >= 0)
+            continue;
+        if (value.isInconclusive() && !settings->inconclusive)
+            continue;
+        if (value.condition && !settings->isEnabled(Settings::WARNING))
+            continue;
+        return &value;
+    }
+    return nullptr;
+}
+
 static std::vector<const ValueFlow::Value *> getOverrunIndexValues(const Token *tok, const Token *arrayToken, const std::vector<Dimension> &dimensions, const std::vector<const Token *> &indexTokens)
 {
     const Token *array = arrayToken;
@@ -235,7 +264,7 @@ static std::vector<const ValueFlow::Value *> getOverrunIndexValues(const Token *
         bool allKnown = true;
         std::vector<const ValueFlow::Value *> indexValues;
         for (size_t i = 0; i < dimensions.size() && i < indexTokens.size(); ++i) {
-            const ValueFlow::Value *value = indexTokens[i]->getMaxValue(cond == 1);
+            const ValueFlow::Value *value = getMaxIndexValue(indexTokens[i], cond == 1);
             indexValues.push_back(value);
             if (!value)
                 continue;
@@ -246,9 +275,9 @@ static std::vector<const ValueFlow::Value *> getOverrunIndexValues(const Token *
             }
             if (array->variable()->isArray() && dimensions[i].num == 0)
                 continue;
-            if (value->intvalue == dimensions[i].num)
+            if (value->maxIntValue() == dimensions[i].num)
                 equal = true;
-            else if (value->intvalue > dimensions[i].num)
+            else if (value->maxIntValue() > dimensions[i].num)
                 overflow = true;
         }
         if (equal && tok->str() != "[")
@@ -314,7 +343,7 @@ void CheckBufferOverrun::arrayIndex()
         bool neg = false;
         std::vector<const ValueFlow::Value *> negativeIndexes;
         for (size_t i = 0; i < indexTokens.size(); ++i) {
-            const ValueFlow::Value *negativeValue = indexTokens[i]->getValueLE(-1, mSettings);
+            const ValueFlow::Value *negativeValue = getNegativeIndexValue(indexTokens[i], mSettings);
             negativeIndexes.emplace_back(negativeValue);
             if (negativeValue)
                 neg = true;
@@ -325,17 +354,18 @@ void CheckBufferOverrun::arrayIndex()
     }
 }
 
-static std::string stringifyIndexes(const std::string &array, const std::vector<const ValueFlow::Value *> &indexValues)
+static std::string stringifyIndexes(const std::string &array, const std::vector<const ValueFlow::Value *> &indexValues, bool negative)
 {
+    // for int ranges the bound that is out of bounds is written
     if (indexValues.size() == 1)
-        return MathLib::toString(indexValues[0]->intvalue);
+        return MathLib::toString(negative ? indexValues[0]->intvalue : indexValues[0]->maxIntValue());
 
     std::ostringstream ret;
     ret << array;
     for (const ValueFlow::Value *index : indexValues) {
         ret << "[";
         if (index)
-            ret << index->intvalue;
+            ret << (negative ? index->intvalue : index->maxIntValue());
         else
             ret << "*";
         ret << "]";
@@ -343,7 +373,7 @@ static std::string stringifyIndexes(const std::string &array, const std::vector<
     return ret.str();
 }
 
-static std::string arrayIndexMessage(const Token *tok, const std::vector<Dimension> &dimensions, const std::vector<const ValueFlow::Value *> &indexValues, const Token *condition)
+static std::string arrayIndexMessage(const Token *tok, const std::vector<Dimension> &dimensions, const std::vector<const ValueFlow::Value *> &indexValues, const Token *condition, bool negative)
 {
     auto add_dim = [](const std::string &s, const Dimension &dim) {
         return s + "[" + MathLib::toString(dim.num) + "]";
@@ -353,9 +383,9 @@ static std::string arrayIndexMessage(const Token *tok, const std::vector<Dimensi
     std::ostringstream errmsg;
     if (condition)
         errmsg << ValueFlow::eitherTheConditionIsRedundant(condition)
-               << " or the array '" + array + "' is accessed at index " << stringifyIndexes(tok->astOperand1()->expressionString(), indexValues) << ", which is out of bounds.";
+               << " or the array '" + array + "' is accessed at index " << stringifyIndexes(tok->astOperand1()->expressionString(), indexValues, negative) << ", which is out of bounds.";
     else
-        errmsg << "Array '" << array << "' accessed at index " << stringifyIndexes(tok->astOperand1()->expressionString(), indexValues) <<  ", which is out of bounds.";
+        errmsg << "Array '" << array << "' accessed at index " << stringifyIndexes(tok->astOperand1()->expressionString(), indexValues, negative) <<  ", which is out of bounds.";
 
     return errmsg.str();
 }
@@ -384,7 +414,7 @@ void CheckBufferOverrun::arrayIndexError(const Token *tok, const std::vector<Dim
     reportError(getErrorPath(tok, index, "Array index out of bounds"),
                 index->errorSeverity() ? Severity::error : Severity::warning,
                 index->condition ? "arrayIndexOutOfBoundsCond" : "arrayIndexOutOfBounds",
-                arrayIndexMessage(tok, dimensions, indexes, condition),
+                arrayIndexMessage(tok, dimensions, indexes, condition, false),
                 CWE_BUFFER_OVERRUN,
                 index->isInconclusive());
 }
@@ -412,7 +442,7 @@ void CheckBufferOverrun::negativeIndexError(const Token *tok, const std::vector<
     reportError(getErrorPath(tok, negativeValue, "Negative array index"),
                 negativeValue->errorSeverity() ? Severity::error : Severity::warning,
                 "negativeIndex",
-                arrayIndexMessage(tok, dimensions, indexes, condition),
+                arrayIndexMessage(tok, dimensions, indexes, condition, true),
                 CWE_BUFFER_UNDERRUN,
                 negativeValue->isInconclusive());
 }
@@ -479,7 +509,7 @@ void CheckBufferOverrun::pointerArithmeticError(const Token *tok, const Token *i
 
     std::string errmsg;
     if (indexValue->condition)
-        errmsg = "Undefined behaviour, when '" + indexToken->expressionString() + "' is " + MathLib::toString(indexValue->intvalue) + " the pointer arithmetic '" + tok->expressionString() + "' is out of bounds.";
+        errmsg = "Undefined behaviour, when '" + indexToken->expressionString() + "' is " + MathLib::toString(indexValue->maxIntValue()) + " the pointer arithmetic '" + tok->expressionString() + "' is out of bounds.";
     else
         errmsg = "Undefined behaviour, pointer arithmetic '" + tok->expressionString() + "' is out of bounds.";
 
@@ -37,7 +37,9 @@
 #include <ostream>
 #include <set>
 #include <stack>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 // CWE ids used
 static const struct CWE CWE398(398U);   // Indicator of Poor Code Quality
@@ -485,28 +487,63 @@ void CheckCondition::multiCondition()
 
     const SymbolDatabase* const symbolDatabase = mTokenizer->getSymbolDatabase();
 
+    // The conditions of each if/else if chain. Conditions with the same hash
+    // are the only candidates for being the same.
+    struct IfChain {
+        std::vector<const Token *> conditions;
+        std::unordered_map<std::size_t, std::vector<std::size_t>> sameHash;
+    };
+    std::list<IfChain> chains;
+    std::unordered_map<const Token *, std::pair<const IfChain *, std::size_t>> chainPosition;
+    ExpressionHasher hasher(mTokenizer->isCPP(), false);
+
     for (const Scope &scope : symbolDatabase->scopeList) {
         if (scope.type != Scope::eIf)
             continue;
 
         const Token * const cond1 = scope.classDef->next()->astOperand2();
 
-        const Token * tok2 = scope.classDef->next();
-        for (;;) {
-            tok2 = tok2->link();
-            if (!Token::simpleMatch(tok2, ") {"))
-                break;
-            tok2 = tok2->linkAt(1);
-            if (!Token::simpleMatch(tok2, "} else { if ("))
-                break;
-            tok2 = tok2->tokAt(4);
-
-            if (cond1 &&
-                tok2->astOperand2() &&
-                !cond1->hasKnownIntValue() &&
+        if (chainPosition.find(scope.classDef->next()) == chainPosition.end()) {
+            chains.emplace_back();
+            IfChain &chain = chains.back();
+            const Token * tok2 = scope.classDef->next();
+            for (;;) {
+                chainPosition[tok2] = std::make_pair(&chain, chain.conditions.size());
+                if (tok2->astOperand2())
+                    chain.sameHash[hasher.hash(tok2->astOperand2())].push_back(chain.conditions.size());
+                chain.conditions.push_back(tok2);
+                tok2 = tok2->link();
+                if (!Token::simpleMatch(tok2, ") {"))
+                    break;
+                tok2 = tok2->linkAt(1);
+                if (!Token::simpleMatch(tok2, "} else { if ("))
+                    break;
+                tok2 = tok2->tokAt(4);
+            }
+        }
+
+        if (!cond1 || cond1->hasKnownIntValue())
+            continue;
+
+        const IfChain &chain = *chainPosition[scope.classDef->next()].first;
+        const std::size_t position = chainPosition[scope.classDef->next()].second;
+        const auto check = [&](std::size_t i) {
+            const Token *tok2 = chain.conditions[i];
+            if (tok2->astOperand2() &&
                 !tok2->astOperand2()->hasKnownIntValue() &&
                 isOverlappingCond(cond1, tok2->astOperand2(), true))
                 multiConditionError(tok2, cond1->linenr());
+        };
+
+        if (cond1->str() == "&") {
+            // bitwise overlap, compare with all the following conditions
+            for (std::size_t i = position + 1; i < chain.conditions.size(); ++i)
+                check(i);
+        } else {
+            for (std::size_t i : chain.sameHash.at(hasher.hash(cond1))) {
+                if (i > position)
+                    check(i);
+            }
         }
     }
 }
@@ -549,6 +586,8 @@ void CheckCondition::multiCondition2()
 
     const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
 
+    ExpressionHasher hasher(mTokenizer->isCPP(), true);
+
     for (const Scope &scope : symbolDatabase->scopeList) {
         const Token *condTok = nullptr;
         if (scope.type == Scope::eIf || scope.type == Scope::eWhile)
@@ -661,7 +700,7 @@ void CheckCondition::multiCondition2()
                                 if (!isReturnVar && isOppositeCond(false, mTokenizer->isCPP(), firstCondition, cond2, mSettings->library, true, true, &errorPath)) {
                                     if (!isAliased(vars))
                                         oppositeInnerConditionError(firstCondition, cond2, errorPath);
-                                } else if (!isReturnVar && isSameExpression(mTokenizer->isCPP(), true, firstCondition, cond2, mSettings->library, true, true, &errorPath)) {
+                                } else if (!isReturnVar && hasher.maybeSame(firstCondition, cond2) && isSameExpression(mTokenizer->isCPP(), true, firstCondition, cond2, mSettings->library, true, true, &errorPath)) {
                                     identicalInnerConditionError(firstCondition, cond2, errorPath);
                                 }
                             }
@@ -678,6 +717,7 @@ void CheckCondition::multiCondition2()
                                 tokens2.push(secondCondition->astOperand1());
                                 tokens2.push(secondCondition->astOperand2());
                             } else if ((!cond1->hasKnownIntValue() || !secondCondition->hasKnownIntValue()) &&
+                                       hasher.maybeSame(cond1, secondCondition) &&
                                        isSameExpression(mTokenizer->isCPP(), true, cond1, secondCondition, mSettings->library, true, true, &errorPath)) {
                                 if (!isAliased(vars))
                                     identicalConditionAfterEarlyExitError(cond1, secondCondition, errorPath);
@@ -27,6 +27,7 @@
 #include "mathlib.h"
 
 #include <string>
+#include <vector>
 
 class ErrorLogger;
 class Settings;
@@ -68,6 +69,10 @@ public:
         checkCondition.checkModuloAlwaysTrueFalse();
     }
 
+    std::vector<Severity::SeverityType> severities() const OVERRIDE {
+        return {Severity::style, Severity::warning};
+    }
+
     /** mismatching assignment / comparison */
     void assignIf();
 
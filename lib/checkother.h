@@ -97,6 +97,11 @@ public:
         checkOther.checkAccessOfMovedVariable();
     }
 
+    int analysis(const Settings *settings) const OVERRIDE {
+        // checkAccessOfMovedVariable() reads the moved values
+        return settings->isEnabled(Settings::WARNING) ? Settings::MOVED_VALUES : 0;
+    }
+
     /** @brief Clarify calculation for ".. a * b ? .." */
     void clarifyCalculation();
 
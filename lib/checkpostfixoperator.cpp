@@ -43,32 +43,37 @@ namespace {
 static const struct CWE CWE398(398U);   // Indicator of Poor Code Quality
 
 
+void CheckPostfixOperator::subscribeChecks(TokenDispatcher &dispatcher)
+{
+    if (mSettings->isEnabled(Settings::PERFORMANCE))
+        dispatcher.subscribe(TokenDispatcher::INC_DEC, TokenDispatcher::FUNCTION_BODIES, this, &CheckPostfixOperator::postfixOperator);
+}
+
 void CheckPostfixOperator::postfixOperator()
 {
-    if (!mSettings->isEnabled(Settings::PERFORMANCE))
+    TokenDispatcher dispatcher;
+    subscribeChecks(dispatcher);
+    dispatcher.dispatch(mTokenizer);
+}
+
+void CheckPostfixOperator::postfixOperator(const Token *tok)
+{
+    const Token *varTok = tok->previous();
+    const Variable *var = varTok->variable();
+    if (!var || !Token::Match(varTok, "%var% ++|--"))
         return;
 
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            const Variable *var = tok->variable();
-            if (!var || !Token::Match(tok, "%var% ++|--"))
-                continue;
-
-            const Token* parent = tok->next()->astParent();
-            if (!parent || parent->str() == ";" || (parent->str() == "," && (!parent->astParent() || parent->astParent()->str() != "("))) {
-                if (var->isPointer() || var->isArray())
-                    continue;
-
-                if (Token::Match(var->nameToken()->previous(), "iterator|const_iterator|reverse_iterator|const_reverse_iterator")) {
-                    // the variable is an iterator
-                    postfixOperatorError(tok);
-                } else if (var->type()) {
-                    // the variable is an instance of class
-                    postfixOperatorError(tok);
-                }
-            }
+    const Token* parent = tok->astParent();
+    if (!parent || parent->str() == ";" || (parent->str() == "," && (!parent->astParent() || parent->astParent()->str() != "("))) {
+        if (var->isPointer() || var->isArray())
+            return;
+
+        if (Token::Match(var->nameToken()->previous(), "iterator|const_iterator|reverse_iterator|const_reverse_iterator")) {
+            // the variable is an iterator
+            postfixOperatorError(varTok);
+        } else if (var->type()) {
+            // the variable is an instance of class
+            postfixOperatorError(varTok);
         }
     }
 }
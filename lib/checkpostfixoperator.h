@@ -27,6 +27,7 @@
 #include "tokenize.h"
 
 #include <string>
+#include <vector>
 
 class ErrorLogger;
 class Settings;
@@ -51,17 +52,34 @@ public:
     }
 
     void runChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) OVERRIDE {
+        TokenDispatcher dispatcher;
+        if (subscribe(dispatcher, tokenizer, settings, errorLogger))
+            dispatcher.dispatch(tokenizer);
+    }
+
+    bool subscribe(TokenDispatcher &dispatcher, const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) OVERRIDE {
         if (tokenizer->isC())
-            return;
+            return true;
+
+        CheckPostfixOperator *checkPostfixOperator = dispatcher.add(new CheckPostfixOperator(tokenizer, settings, errorLogger));
+        checkPostfixOperator->subscribeChecks(dispatcher);
+        return true;
+    }
 
-        CheckPostfixOperator checkPostfixOperator(tokenizer, settings, errorLogger);
-        checkPostfixOperator.postfixOperator();
+    std::vector<Severity::SeverityType> severities() const OVERRIDE {
+        return {Severity::performance};
     }
 
     /** Check postfix operators */
     void postfixOperator();
 
 private:
+    /** Subscribe the enabled checks */
+    void subscribeChecks(TokenDispatcher &dispatcher);
+
+    /** Check postfix operator ++ or -- */
+    void postfixOperator(const Token *tok);
+
     /** Report Error */
     void postfixOperatorError(const Token *tok);
 
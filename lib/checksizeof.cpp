@@ -40,19 +40,33 @@ static const struct CWE CWE467(467U);   // Use of sizeof() on a Pointer Type
 static const struct CWE CWE682(682U);   // Incorrect Calculation
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
-void CheckSizeof::checkSizeofForNumericParameter()
+void CheckSizeof::subscribeChecks(TokenDispatcher &dispatcher)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
-        return;
+    if (mSettings->isEnabled(Settings::WARNING)) {
+        dispatcher.subscribe(TokenDispatcher::SIZEOF, TokenDispatcher::EVERYWHERE, this, &CheckSizeof::sizeofsizeof);
+        dispatcher.subscribe(TokenDispatcher::SIZEOF, TokenDispatcher::EVERYWHERE, this, &CheckSizeof::sizeofCalculation);
+        dispatcher.subscribe(TokenDispatcher::SIZEOF, TokenDispatcher::EVERYWHERE, this, &CheckSizeof::sizeofFunction);
+        if (mSettings->inconclusive)
+            dispatcher.subscribe(TokenDispatcher::SIZEOF, TokenDispatcher::EVERYWHERE, this, &CheckSizeof::suspiciousSizeofCalculation);
+        dispatcher.subscribe(TokenDispatcher::SIZEOF, TokenDispatcher::FUNCTION_BODIES, this, &CheckSizeof::checkSizeofForArrayParameter);
+        dispatcher.subscribe(TokenDispatcher::ANY, TokenDispatcher::FUNCTION_BODIES, this, &CheckSizeof::checkSizeofForPointerSize);
+        // "{ return malloc(..);" is found from the "{" of the function body
+        dispatcher.subscribe(TokenDispatcher::SCOPE_BEGIN, TokenDispatcher::EVERYWHERE, [this](const Token *tok) {
+            if (tok->scope()->type == Scope::eFunction && tok == tok->scope()->bodyStart)
+                checkSizeofForPointerSize(tok);
+        });
+        dispatcher.subscribe(TokenDispatcher::SIZEOF, TokenDispatcher::FUNCTION_BODIES, this, &CheckSizeof::checkSizeofForNumericParameter);
+    }
+    if (mSettings->isEnabled(Settings::PORTABILITY))
+        dispatcher.subscribe(TokenDispatcher::ANY, TokenDispatcher::EVERYWHERE, this, &CheckSizeof::sizeofVoid);
+}
 
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (Token::Match(tok, "sizeof ( %num% )") ||
-                Token::Match(tok, "sizeof %num%")) {
-                sizeofForNumericParameterError(tok);
-            }
-        }
+//---------------------------------------------------------------------------
+void CheckSizeof::checkSizeofForNumericParameter(const Token* tok)
+{
+    if (Token::Match(tok, "sizeof ( %num% )") ||
+        Token::Match(tok, "sizeof %num%")) {
+        sizeofForNumericParameterError(tok);
     }
 }
 
@@ -68,25 +82,18 @@ void CheckSizeof::sizeofForNumericParameterError(const Token *tok)
 
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
-void CheckSizeof::checkSizeofForArrayParameter()
+void CheckSizeof::checkSizeofForArrayParameter(const Token* tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
-        return;
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (Token::Match(tok, "sizeof ( %var% )") ||
-                Token::Match(tok, "sizeof %var% !![")) {
-                const Token* varTok = tok->next();
-                if (varTok->str() == "(") {
-                    varTok = varTok->next();
-                }
-
-                const Variable *var = varTok->variable();
-                if (var && var->isArray() && var->isArgument() && !var->isReference())
-                    sizeofForArrayParameterError(tok);
-            }
+    if (Token::Match(tok, "sizeof ( %var% )") ||
+        Token::Match(tok, "sizeof %var% !![")) {
+        const Token* varTok = tok->next();
+        if (varTok->str() == "(") {
+            varTok = varTok->next();
         }
+
+        const Variable *var = varTok->variable();
+        if (var && var->isArray() && var->isArgument() && !var->isReference())
+            sizeofForArrayParameterError(tok);
     }
 }
 
@@ -106,135 +113,127 @@ void CheckSizeof::sizeofForArrayParameterError(const Token *tok)
                );
 }
 
-void CheckSizeof::checkSizeofForPointerSize()
+void CheckSizeof::checkSizeofForPointerSize(const Token* tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
+    const Token* tokSize;
+    const Token* tokFunc;
+    const Token *variable = nullptr;
+    const Token *variable2 = nullptr;
+
+    // Find any function that may use sizeof on a pointer
+    // Once leaving those tests, it is mandatory to have:
+    // - variable matching the used pointer
+    // - tokVar pointing on the argument where sizeof may be used
+    if (Token::Match(tok->tokAt(2), "malloc|alloca|calloc (")) {
+        if (Token::Match(tok, "%var% ="))
+            variable = tok;
+        else if (tok->strAt(1) == ")" && Token::Match(tok->linkAt(1)->tokAt(-2), "%var% ="))
+            variable = tok->linkAt(1)->tokAt(-2);
+        else if (tok->link() && Token::Match(tok, "> ( malloc|alloca|calloc (") && Token::Match(tok->link()->tokAt(-3), "%var% ="))
+            variable = tok->link()->tokAt(-3);
+        tokSize = tok->tokAt(4);
+        tokFunc = tok->tokAt(2);
+    } else if (Token::simpleMatch(tok, "memset (") && tok->strAt(-1) != ".") {
+        variable = tok->tokAt(2);
+        tokSize = variable->nextArgument();
+        if (tokSize)
+            tokSize = tokSize->nextArgument();
+        tokFunc = tok;
+    } else if (Token::Match(tok, "memcpy|memcmp|memmove|strncpy|strncmp|strncat (") && tok->strAt(-1) != ".") {
+        variable = tok->tokAt(2);
+        variable2 = variable->nextArgument();
+        if (!variable2)
+            return;
+        tokSize = variable2->nextArgument();
+        tokFunc = tok;
+    } else {
         return;
+    }
 
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart; tok != scope->bodyEnd; tok = tok->next()) {
-            const Token* tokSize;
-            const Token* tokFunc;
-            const Token *variable = nullptr;
-            const Token *variable2 = nullptr;
-
-            // Find any function that may use sizeof on a pointer
-            // Once leaving those tests, it is mandatory to have:
-            // - variable matching the used pointer
-            // - tokVar pointing on the argument where sizeof may be used
-            if (Token::Match(tok->tokAt(2), "malloc|alloca|calloc (")) {
-                if (Token::Match(tok, "%var% ="))
-                    variable = tok;
-                else if (tok->strAt(1) == ")" && Token::Match(tok->linkAt(1)->tokAt(-2), "%var% ="))
-                    variable = tok->linkAt(1)->tokAt(-2);
-                else if (tok->link() && Token::Match(tok, "> ( malloc|alloca|calloc (") && Token::Match(tok->link()->tokAt(-3), "%var% ="))
-                    variable = tok->link()->tokAt(-3);
-                tokSize = tok->tokAt(4);
-                tokFunc = tok->tokAt(2);
-            } else if (Token::simpleMatch(tok, "memset (") && tok->strAt(-1) != ".") {
-                variable = tok->tokAt(2);
-                tokSize = variable->nextArgument();
-                if (tokSize)
-                    tokSize = tokSize->nextArgument();
-                tokFunc = tok;
-            } else if (Token::Match(tok, "memcpy|memcmp|memmove|strncpy|strncmp|strncat (") && tok->strAt(-1) != ".") {
-                variable = tok->tokAt(2);
-                variable2 = variable->nextArgument();
-                if (!variable2)
-                    continue;
-                tokSize = variable2->nextArgument();
-                tokFunc = tok;
-            } else {
-                continue;
-            }
-
-            if (tokSize && tokFunc->str() == "calloc")
-                tokSize = tokSize->nextArgument();
-
-            if (tokSize) {
-                const Token * const paramsListEndTok = tokFunc->linkAt(1);
-                for (const Token* tok2 = tokSize; tok2 != paramsListEndTok; tok2 = tok2->next()) {
-                    if (Token::simpleMatch(tok2, "/ sizeof")) {
-                        // Allow division with sizeof(char)
-                        if (Token::simpleMatch(tok2->next(), "sizeof (")) {
-                            const Token *sztok = tok2->tokAt(2)->astOperand2();
-                            const ValueType *vt = ((sztok != nullptr) ? sztok->valueType() : nullptr);
-                            if (vt && vt->type == ValueType::CHAR && vt->pointer == 0)
-                                continue;
-                        }
-
-                        divideBySizeofError(tok2, tokFunc->str());
-                    }
+    if (tokSize && tokFunc->str() == "calloc")
+        tokSize = tokSize->nextArgument();
+
+    if (tokSize) {
+        const Token * const paramsListEndTok = tokFunc->linkAt(1);
+        for (const Token* tok2 = tokSize; tok2 != paramsListEndTok; tok2 = tok2->next()) {
+            if (Token::simpleMatch(tok2, "/ sizeof")) {
+                // Allow division with sizeof(char)
+                if (Token::simpleMatch(tok2->next(), "sizeof (")) {
+                    const Token *sztok = tok2->tokAt(2)->astOperand2();
+                    const ValueType *vt = ((sztok != nullptr) ? sztok->valueType() : nullptr);
+                    if (vt && vt->type == ValueType::CHAR && vt->pointer == 0)
+                        continue;
                 }
-            }
 
-            if (!variable || !tokSize)
-                continue;
+                divideBySizeofError(tok2, tokFunc->str());
+            }
+        }
+    }
 
-            while (Token::Match(variable, "%var% ::|."))
-                variable = variable->tokAt(2);
+    if (!variable || !tokSize)
+        return;
 
-            while (Token::Match(variable2, "%var% ::|."))
-                variable2 = variable2->tokAt(2);
+    while (Token::Match(variable, "%var% ::|."))
+        variable = variable->tokAt(2);
 
-            // Ensure the variables are in the symbol database
-            // Also ensure the variables are pointers
-            // Only keep variables which are pointers
-            const Variable *var = variable->variable();
-            if (!var || !var->isPointer() || var->isArray()) {
-                variable = nullptr;
-            }
+    while (Token::Match(variable2, "%var% ::|."))
+        variable2 = variable2->tokAt(2);
 
-            if (variable2) {
-                var = variable2->variable();
-                if (!var || !var->isPointer() || var->isArray()) {
-                    variable2 = nullptr;
-                }
-            }
+    // Ensure the variables are in the symbol database
+    // Also ensure the variables are pointers
+    // Only keep variables which are pointers
+    const Variable *var = variable->variable();
+    if (!var || !var->isPointer() || var->isArray()) {
+        variable = nullptr;
+    }
 
-            // If there are no pointer variable at this point, there is
-            // no need to continue
-            if (variable == nullptr && variable2 == nullptr) {
-                continue;
-            }
+    if (variable2) {
+        var = variable2->variable();
+        if (!var || !var->isPointer() || var->isArray()) {
+            variable2 = nullptr;
+        }
+    }
 
-            // Jump to the next sizeof token in the function and in the parameter
-            // This is to allow generic operations with sizeof
-            for (; tokSize && tokSize->str() != ")" && tokSize->str() != "," && tokSize->str() != "sizeof"; tokSize = tokSize->next()) {}
+    // If there are no pointer variable at this point, there is
+    // no need to continue
+    if (variable == nullptr && variable2 == nullptr) {
+        return;
+    }
 
-            if (tokSize->str() != "sizeof")
-                continue;
+    // Jump to the next sizeof token in the function and in the parameter
+    // This is to allow generic operations with sizeof
+    for (; tokSize && tokSize->str() != ")" && tokSize->str() != "," && tokSize->str() != "sizeof"; tokSize = tokSize->next()) {}
 
-            // Now check for the sizeof usage: Does the level of pointer indirection match?
-            if (tokSize->linkAt(1)->strAt(-1) == "*") {
-                if (variable && variable->valueType() && variable->valueType()->pointer == 1 && variable->valueType()->type != ValueType::VOID)
-                    sizeofForPointerError(variable, variable->str());
-                else if (variable2 && variable2->valueType() && variable2->valueType()->pointer == 1 && variable2->valueType()->type != ValueType::VOID)
-                    sizeofForPointerError(variable2, variable2->str());
-            }
+    if (tokSize->str() != "sizeof")
+        return;
 
-            if (Token::simpleMatch(tokSize, "sizeof ( &"))
-                tokSize = tokSize->tokAt(3);
-            else if (Token::Match(tokSize, "sizeof (|&"))
-                tokSize = tokSize->tokAt(2);
-            else
-                tokSize = tokSize->next();
-
-            while (Token::Match(tokSize, "%var% ::|."))
-                tokSize = tokSize->tokAt(2);
-
-            if (Token::Match(tokSize, "%var% [|("))
-                continue;
-
-            // Now check for the sizeof usage again. Once here, everything using sizeof(varid) or sizeof(&varid)
-            // looks suspicious
-            if (variable && tokSize->varId() == variable->varId())
-                sizeofForPointerError(variable, variable->str());
-            if (variable2 && tokSize->varId() == variable2->varId())
-                sizeofForPointerError(variable2, variable2->str());
-        }
+    // Now check for the sizeof usage: Does the level of pointer indirection match?
+    if (tokSize->linkAt(1)->strAt(-1) == "*") {
+        if (variable && variable->valueType() && variable->valueType()->pointer == 1 && variable->valueType()->type != ValueType::VOID)
+            sizeofForPointerError(variable, variable->str());
+        else if (variable2 && variable2->valueType() && variable2->valueType()->pointer == 1 && variable2->valueType()->type != ValueType::VOID)
+            sizeofForPointerError(variable2, variable2->str());
     }
+
+    if (Token::simpleMatch(tokSize, "sizeof ( &"))
+        tokSize = tokSize->tokAt(3);
+    else if (Token::Match(tokSize, "sizeof (|&"))
+        tokSize = tokSize->tokAt(2);
+    else
+        tokSize = tokSize->next();
+
+    while (Token::Match(tokSize, "%var% ::|."))
+        tokSize = tokSize->tokAt(2);
+
+    if (Token::Match(tokSize, "%var% [|("))
+        return;
+
+    // Now check for the sizeof usage again. Once here, everything using sizeof(varid) or sizeof(&varid)
+    // looks suspicious
+    if (variable && tokSize->varId() == variable->varId())
+        sizeofForPointerError(variable, variable->str());
+    if (variable2 && tokSize->varId() == variable2->varId())
+        sizeofForPointerError(variable2, variable2->str());
 }
 
 void CheckSizeof::sizeofForPointerError(const Token *tok, const std::string &varname)
@@ -254,16 +253,17 @@ void CheckSizeof::divideBySizeofError(const Token *tok, const std::string &memfu
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-void CheckSizeof::sizeofsizeof()
+void CheckSizeof::sizeofsizeof(const Token* tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
-        return;
+    if (mSizeofsizeofSkip) {
+        if (tok->index() <= mSizeofsizeofSkip->index())
+            return;
+        mSizeofsizeofSkip = nullptr;
+    }
 
-    for (const Token *tok = mTokenizer->tokens(); tok; tok = tok->next()) {
-        if (Token::Match(tok, "sizeof (| sizeof")) {
-            sizeofsizeofError(tok);
-            tok = tok->next();
-        }
+    if (Token::Match(tok, "sizeof (| sizeof")) {
+        sizeofsizeofError(tok);
+        mSizeofsizeofSkip = tok->next();
     }
 }
 
@@ -278,40 +278,35 @@ void CheckSizeof::sizeofsizeofError(const Token *tok)
 
 //-----------------------------------------------------------------------------
 
-void CheckSizeof::sizeofCalculation()
+void CheckSizeof::sizeofCalculation(const Token* tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
-        return;
-
     const bool printInconclusive = mSettings->inconclusive;
 
-    for (const Token *tok = mTokenizer->tokens(); tok; tok = tok->next()) {
-        if (!Token::simpleMatch(tok, "sizeof ("))
-            continue;
+    if (!Token::simpleMatch(tok, "sizeof ("))
+        return;
 
-        // ignore if the `sizeof` result is cast to void inside a macro, i.e. the calculation is
-        // expected to be parsed but skipped, such as in a disabled custom ASSERT() macro
-        if (tok->isExpandedMacro() && tok->previous()) {
-            const Token *cast_end = (tok->previous()->str() == "(") ? tok->previous() : tok;
-            if (Token::simpleMatch(cast_end->tokAt(-3), "( void )") ||
-                Token::simpleMatch(cast_end->previous(), "static_cast<void>")) {
-                continue;
-            }
+    // ignore if the `sizeof` result is cast to void inside a macro, i.e. the calculation is
+    // expected to be parsed but skipped, such as in a disabled custom ASSERT() macro
+    if (tok->isExpandedMacro() && tok->previous()) {
+        const Token *cast_end = (tok->previous()->str() == "(") ? tok->previous() : tok;
+        if (Token::simpleMatch(cast_end->tokAt(-3), "( void )") ||
+            Token::simpleMatch(cast_end->previous(), "static_cast<void>")) {
+            return;
         }
+    }
 
-        const Token *argument = tok->next()->astOperand2();
-        if (!argument || !argument->isCalculation())
-            continue;
+    const Token *argument = tok->next()->astOperand2();
+    if (!argument || !argument->isCalculation())
+        return;
 
-        bool inconclusive = false;
-        if (argument->isExpandedMacro())
-            inconclusive = true;
-        else if (tok->next()->isExpandedMacro())
-            inconclusive = true;
+    bool inconclusive = false;
+    if (argument->isExpandedMacro())
+        inconclusive = true;
+    else if (tok->next()->isExpandedMacro())
+        inconclusive = true;
 
-        if (!inconclusive || printInconclusive)
-            sizeofCalculationError(argument, inconclusive);
-    }
+    if (!inconclusive || printInconclusive)
+        sizeofCalculationError(argument, inconclusive);
 }
 
 void CheckSizeof::sizeofCalculationError(const Token *tok, bool inconclusive)
@@ -322,33 +317,33 @@ void CheckSizeof::sizeofCalculationError(const Token *tok, bool inconclusive)
 
 //-----------------------------------------------------------------------------
 
-void CheckSizeof::sizeofFunction()
+void CheckSizeof::sizeofFunction(const Token* tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
+    if (mSizeofFunctionDone)
         return;
 
-    for (const Token *tok = mTokenizer->tokens(); tok; tok = tok->next()) {
-        if (Token::simpleMatch(tok, "sizeof (")) {
+    if (Token::simpleMatch(tok, "sizeof (")) {
 
-            // ignore if the `sizeof` result is cast to void inside a macro, i.e. the calculation is
-            // expected to be parsed but skipped, such as in a disabled custom ASSERT() macro
-            if (tok->isExpandedMacro() && tok->previous()) {
-                const Token *cast_end = (tok->previous()->str() == "(") ? tok->previous() : tok;
-                if (Token::simpleMatch(cast_end->tokAt(-3), "( void )") ||
-                    Token::simpleMatch(cast_end->previous(), "static_cast<void>")) {
-                    continue;
-                }
+        // ignore if the `sizeof` result is cast to void inside a macro, i.e. the calculation is
+        // expected to be parsed but skipped, such as in a disabled custom ASSERT() macro
+        if (tok->isExpandedMacro() && tok->previous()) {
+            const Token *cast_end = (tok->previous()->str() == "(") ? tok->previous() : tok;
+            if (Token::simpleMatch(cast_end->tokAt(-3), "( void )") ||
+                Token::simpleMatch(cast_end->previous(), "static_cast<void>")) {
+                return;
             }
+        }
 
-            if (const Token *argument = tok->next()->astOperand2()) {
-                const Token *checkToken = argument->previous();
-                if (checkToken->tokType() == Token::eName)
-                    break;
-                const Function * fun = checkToken->function();
-                // Don't report error if the function is overloaded
-                if (fun && fun->nestedIn->functionMap.count(checkToken->str()) == 1) {
-                    sizeofFunctionError(tok);
-                }
+        if (const Token *argument = tok->next()->astOperand2()) {
+            const Token *checkToken = argument->previous();
+            if (checkToken->tokType() == Token::eName) {
+                mSizeofFunctionDone = true;
+                return;
+            }
+            const Function * fun = checkToken->function();
+            // Don't report error if the function is overloaded
+            if (fun && fun->nestedIn->functionMap.count(checkToken->str()) == 1) {
+                sizeofFunctionError(tok);
             }
         }
     }
@@ -363,22 +358,17 @@ void CheckSizeof::sizeofFunctionError(const Token *tok)
 //-----------------------------------------------------------------------------
 // Check for code like sizeof()*sizeof() or sizeof(ptr)/value
 //-----------------------------------------------------------------------------
-void CheckSizeof::suspiciousSizeofCalculation()
+void CheckSizeof::suspiciousSizeofCalculation(const Token* tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING) || !mSettings->inconclusive)
-        return;
-
     // TODO: Use AST here. This should be possible as soon as sizeof without brackets is correctly parsed
-    for (const Token *tok = mTokenizer->tokens(); tok; tok = tok->next()) {
-        if (Token::simpleMatch(tok, "sizeof (")) {
-            const Token* const end = tok->linkAt(1);
-            const Variable* var = end->previous()->variable();
-            if (end->strAt(-1) == "*" || (var && var->isPointer() && !var->isArray())) {
-                if (end->strAt(1) == "/")
-                    divideSizeofError(tok);
-            } else if (Token::simpleMatch(end, ") * sizeof") && end->next()->astOperand1() == tok->next())
-                multiplySizeofError(tok);
-        }
+    if (Token::simpleMatch(tok, "sizeof (")) {
+        const Token* const end = tok->linkAt(1);
+        const Variable* var = end->previous()->variable();
+        if (end->strAt(-1) == "*" || (var && var->isPointer() && !var->isArray())) {
+            if (end->strAt(1) == "/")
+                divideSizeofError(tok);
+        } else if (Token::simpleMatch(end, ") * sizeof") && end->next()->astOperand1() == tok->next())
+            multiplySizeofError(tok);
     }
 }
 
@@ -396,39 +386,34 @@ void CheckSizeof::divideSizeofError(const Token *tok)
                 "not the size of the memory area it points to.", CWE682, true);
 }
 
-void CheckSizeof::sizeofVoid()
+void CheckSizeof::sizeofVoid(const Token* tok)
 {
-    if (!mSettings->isEnabled(Settings::PORTABILITY))
-        return;
-
-    for (const Token *tok = mTokenizer->tokens(); tok; tok = tok->next()) {
-        if (Token::simpleMatch(tok, "sizeof ( )")) { // "sizeof(void)" gets simplified to sizeof ( )
-            sizeofVoidError(tok);
-        } else if (Token::simpleMatch(tok, "sizeof (") && tok->next()->astOperand2()) {
-            const ValueType *vt = tok->next()->astOperand2()->valueType();
-            if (vt && vt->type == ValueType::Type::VOID && vt->pointer == 0U)
-                sizeofDereferencedVoidPointerError(tok, tok->strAt(3));
-        } else if (tok->str() == "-") {
-            // only warn for: 'void *' - 'integral'
-            const ValueType *vt1  = tok->astOperand1() ? tok->astOperand1()->valueType() : nullptr;
-            const ValueType *vt2  = tok->astOperand2() ? tok->astOperand2()->valueType() : nullptr;
-            const bool op1IsvoidPointer = (vt1 && vt1->type == ValueType::Type::VOID && vt1->pointer == 1U);
-            const bool op2IsIntegral    = (vt2 && vt2->isIntegral() && vt2->pointer == 0U);
-            if (op1IsvoidPointer && op2IsIntegral)
-                arithOperationsOnVoidPointerError(tok, tok->astOperand1()->expressionString(), vt1->str());
-        } else if (Token::Match(tok, "+|++|--|+=|-=")) { // Arithmetic operations on variable of type "void*"
-            const ValueType *vt1 = tok->astOperand1() ? tok->astOperand1()->valueType() : nullptr;
-            const ValueType *vt2 = tok->astOperand2() ? tok->astOperand2()->valueType() : nullptr;
-
-            const bool voidpointer1 = (vt1 && vt1->type == ValueType::Type::VOID && vt1->pointer == 1U);
-            const bool voidpointer2 = (vt2 && vt2->type == ValueType::Type::VOID && vt2->pointer == 1U);
-
-            if (voidpointer1)
-                arithOperationsOnVoidPointerError(tok, tok->astOperand1()->expressionString(), vt1->str());
-
-            if (!tok->isAssignmentOp() && voidpointer2)
-                arithOperationsOnVoidPointerError(tok, tok->astOperand2()->expressionString(), vt2->str());
-        }
+    if (Token::simpleMatch(tok, "sizeof ( )")) { // "sizeof(void)" gets simplified to sizeof ( )
+        sizeofVoidError(tok);
+    } else if (Token::simpleMatch(tok, "sizeof (") && tok->next()->astOperand2()) {
+        const ValueType *vt = tok->next()->astOperand2()->valueType();
+        if (vt && vt->type == ValueType::Type::VOID && vt->pointer == 0U)
+            sizeofDereferencedVoidPointerError(tok, tok->strAt(3));
+    } else if (tok->str() == "-") {
+        // only warn for: 'void *' - 'integral'
+        const ValueType *vt1  = tok->astOperand1() ? tok->astOperand1()->valueType() : nullptr;
+        const ValueType *vt2  = tok->astOperand2() ? tok->astOperand2()->valueType() : nullptr;
+        const bool op1IsvoidPointer = (vt1 && vt1->type == ValueType::Type::VOID && vt1->pointer == 1U);
+        const bool op2IsIntegral    = (vt2 && vt2->isIntegral() && vt2->pointer == 0U);
+        if (op1IsvoidPointer && op2IsIntegral)
+            arithOperationsOnVoidPointerError(tok, tok->astOperand1()->expressionString(), vt1->str());
+    } else if (Token::Match(tok, "+|++|--|+=|-=")) { // Arithmetic operations on variable of type "void*"
+        const ValueType *vt1 = tok->astOperand1() ? tok->astOperand1()->valueType() : nullptr;
+        const ValueType *vt2 = tok->astOperand2() ? tok->astOperand2()->valueType() : nullptr;
+
+        const bool voidpointer1 = (vt1 && vt1->type == ValueType::Type::VOID && vt1->pointer == 1U);
+        const bool voidpointer2 = (vt2 && vt2->type == ValueType::Type::VOID && vt2->pointer == 1U);
+
+        if (voidpointer1)
+            arithOperationsOnVoidPointerError(tok, tok->astOperand1()->expressionString(), vt1->str());
+
+        if (!tok->isAssignmentOp() && voidpointer2)
+            arithOperationsOnVoidPointerError(tok, tok->astOperand2()->expressionString(), vt2->str());
     }
 }
 
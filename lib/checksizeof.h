@@ -26,6 +26,7 @@
 #include "config.h"
 
 #include <string>
+#include <vector>
 
 class ErrorLogger;
 class Settings;
@@ -41,54 +42,64 @@ class Tokenizer;
 class CPPCHECKLIB CheckSizeof : public Check {
 public:
     /** @brief This constructor is used when registering the CheckClass */
-    CheckSizeof() : Check(myName()) {
+    CheckSizeof() : Check(myName()), mSizeofsizeofSkip(nullptr), mSizeofFunctionDone(false) {
     }
 
     /** @brief This constructor is used when running checks. */
     CheckSizeof(const Tokenizer* tokenizer, const Settings* settings, ErrorLogger* errorLogger)
-        : Check(myName(), tokenizer, settings, errorLogger) {
+        : Check(myName(), tokenizer, settings, errorLogger), mSizeofsizeofSkip(nullptr), mSizeofFunctionDone(false) {
     }
 
     /** @brief Run checks against the normal token list */
     void runChecks(const Tokenizer* tokenizer, const Settings* settings, ErrorLogger* errorLogger) OVERRIDE {
-        CheckSizeof checkSizeof(tokenizer, settings, errorLogger);
-
-        // Checks
-        checkSizeof.sizeofsizeof();
-        checkSizeof.sizeofCalculation();
-        checkSizeof.sizeofFunction();
-        checkSizeof.suspiciousSizeofCalculation();
-        checkSizeof.checkSizeofForArrayParameter();
-        checkSizeof.checkSizeofForPointerSize();
-        checkSizeof.checkSizeofForNumericParameter();
-        checkSizeof.sizeofVoid();
+        TokenDispatcher dispatcher;
+        if (subscribe(dispatcher, tokenizer, settings, errorLogger))
+            dispatcher.dispatch(tokenizer);
+    }
+
+    bool subscribe(TokenDispatcher &dispatcher, const Tokenizer* tokenizer, const Settings* settings, ErrorLogger* errorLogger) OVERRIDE {
+        CheckSizeof *checkSizeof = dispatcher.add(new CheckSizeof(tokenizer, settings, errorLogger));
+        checkSizeof->subscribeChecks(dispatcher);
+        return true;
+    }
+
+    std::vector<Severity::SeverityType> severities() const OVERRIDE {
+        return {Severity::warning, Severity::portability};
     }
 
     /** @brief %Check for 'sizeof sizeof ..' */
-    void sizeofsizeof();
+    void sizeofsizeof(const Token* tok);
 
     /** @brief %Check for calculations inside sizeof */
-    void sizeofCalculation();
+    void sizeofCalculation(const Token* tok);
 
     /** @brief %Check for function call inside sizeof */
-    void sizeofFunction();
+    void sizeofFunction(const Token* tok);
 
     /** @brief %Check for suspicious calculations with sizeof results */
-    void suspiciousSizeofCalculation();
+    void suspiciousSizeofCalculation(const Token* tok);
 
     /** @brief %Check for using sizeof with array given as function argument */
-    void checkSizeofForArrayParameter();
+    void checkSizeofForArrayParameter(const Token* tok);
 
     /** @brief %Check for using sizeof of a variable when allocating it */
-    void checkSizeofForPointerSize();
+    void checkSizeofForPointerSize(const Token* tok);
 
     /** @brief %Check for using sizeof with numeric given as function argument */
-    void checkSizeofForNumericParameter();
+    void checkSizeofForNumericParameter(const Token* tok);
 
     /** @brief %Check for using sizeof(void) */
-    void sizeofVoid();
+    void sizeofVoid(const Token* tok);
 
 private:
+    /** Subscribe the enabled checks */
+    void subscribeChecks(TokenDispatcher &dispatcher);
+
+    /** Last token that sizeofsizeof() skips */
+    const Token* mSizeofsizeofSkip;
+    /** sizeofFunction() has bailed out for the rest of the tokens */
+    bool mSizeofFunctionDone;
+
     // Error messages..
     void sizeofsizeofError(const Token* tok);
     void sizeofCalculationError(const Token* tok, bool inconclusive);
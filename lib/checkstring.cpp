@@ -50,25 +50,37 @@ static const struct CWE CWE628(628U);   // Function Call with Incorrectly Specif
 static const struct CWE CWE665(665U);   // Improper Initialization
 static const struct CWE CWE758(758U);   // Reliance on Undefined, Unspecified, or Implementation-Defined Behavior
 
+void CheckString::subscribeChecks(TokenDispatcher &dispatcher)
+{
+    const bool printWarning = mSettings->isEnabled(Settings::WARNING);
+
+    dispatcher.subscribe(TokenDispatcher::ANY, TokenDispatcher::FUNCTION_BODIES, this, &CheckString::strPlusChar);
+    if (printWarning)
+        dispatcher.subscribe(TokenDispatcher::COMPARISON, TokenDispatcher::FUNCTION_BODIES, this, &CheckString::checkSuspiciousStringCompare);
+    dispatcher.subscribe(TokenDispatcher::ANY, TokenDispatcher::FUNCTION_BODIES, this, &CheckString::stringLiteralWrite);
+    if (printWarning) {
+        dispatcher.subscribe(TokenDispatcher::ANY, TokenDispatcher::FUNCTION_BODIES, this, &CheckString::overlappingStrcmp);
+        dispatcher.subscribe(TokenDispatcher::ANY, TokenDispatcher::FUNCTION_BODIES, this, &CheckString::checkIncorrectStringCompare);
+    }
+    dispatcher.subscribe(TokenDispatcher::FUNCTION_CALL, TokenDispatcher::FUNCTION_BODIES, this, &CheckString::sprintfOverlappingData);
+    if (printWarning)
+        dispatcher.subscribe(TokenDispatcher::ANY, TokenDispatcher::EVERYWHERE, this, &CheckString::checkAlwaysTrueOrFalseStringCompare);
+}
+
 //---------------------------------------------------------------------------
 // Writing string literal is UB
 //---------------------------------------------------------------------------
-void CheckString::stringLiteralWrite()
+void CheckString::stringLiteralWrite(const Token *tok)
 {
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (!tok->variable() || !tok->variable()->isPointer())
-                continue;
-            const Token *str = tok->getValueTokenMinStrSize();
-            if (!str)
-                continue;
-            if (Token::Match(tok, "%var% [") && Token::simpleMatch(tok->linkAt(1), "] ="))
-                stringLiteralWriteError(tok, str);
-            else if (Token::Match(tok->previous(), "* %var% ="))
-                stringLiteralWriteError(tok, str);
-        }
-    }
+    if (!tok->variable() || !tok->variable()->isPointer())
+        return;
+    const Token *str = tok->getValueTokenMinStrSize();
+    if (!str)
+        return;
+    if (Token::Match(tok, "%var% [") && Token::simpleMatch(tok->linkAt(1), "] ="))
+        stringLiteralWriteError(tok, str);
+    else if (Token::Match(tok->previous(), "* %var% ="))
+        stringLiteralWriteError(tok, str);
 }
 
 void CheckString::stringLiteralWriteError(const Token *tok, const Token *strValue)
@@ -94,45 +106,50 @@ void CheckString::stringLiteralWriteError(const Token *tok, const Token *strValu
 // Check for string comparison involving two static strings.
 // if(strcmp("00FF00","00FF00")==0) // <- statement is always true
 //---------------------------------------------------------------------------
-void CheckString::checkAlwaysTrueOrFalseStringCompare()
+void CheckString::checkAlwaysTrueOrFalseStringCompare(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
-        return;
+    if (mAlwaysTrueOrFalseStringCompareSkip) {
+        if (tok->index() <= mAlwaysTrueOrFalseStringCompareSkip->index())
+            return;
+        mAlwaysTrueOrFalseStringCompareSkip = nullptr;
+    }
 
-    for (const Token* tok = mTokenizer->tokens(); tok; tok = tok->next()) {
-        if (tok->isName() && tok->strAt(1) == "(" && Token::Match(tok, "memcmp|strncmp|strcmp|stricmp|strverscmp|bcmp|strcmpi|strcasecmp|strncasecmp|strncasecmp_l|strcasecmp_l|wcsncasecmp|wcscasecmp|wmemcmp|wcscmp|wcscasecmp_l|wcsncasecmp_l|wcsncmp|_mbscmp|_memicmp|_memicmp_l|_stricmp|_wcsicmp|_mbsicmp|_stricmp_l|_wcsicmp_l|_mbsicmp_l")) {
-            if (Token::Match(tok->tokAt(2), "%str% , %str% ,|)")) {
-                const std::string &str1 = tok->strAt(2);
-                const std::string &str2 = tok->strAt(4);
-                if (!tok->isExpandedMacro() && !tok->tokAt(2)->isExpandedMacro() && !tok->tokAt(4)->isExpandedMacro())
-                    alwaysTrueFalseStringCompareError(tok, str1, str2);
-                tok = tok->tokAt(5);
-            } else if (Token::Match(tok->tokAt(2), "%name% , %name% ,|)")) {
-                const std::string &str1 = tok->strAt(2);
-                const std::string &str2 = tok->strAt(4);
-                if (str1 == str2)
-                    alwaysTrueStringVariableCompareError(tok, str1, str2);
-                tok = tok->tokAt(5);
-            } else if (Token::Match(tok->tokAt(2), "%name% . c_str ( ) , %name% . c_str ( ) ,|)")) {
-                const std::string &str1 = tok->strAt(2);
-                const std::string &str2 = tok->strAt(8);
-                if (str1 == str2)
-                    alwaysTrueStringVariableCompareError(tok, str1, str2);
-                tok = tok->tokAt(13);
-            }
-        } else if (tok->isName() && Token::Match(tok, "QString :: compare ( %str% , %str% )")) {
-            const std::string &str1 = tok->strAt(4);
-            const std::string &str2 = tok->strAt(6);
-            alwaysTrueFalseStringCompareError(tok, str1, str2);
-            tok = tok->tokAt(7);
-        } else if (Token::Match(tok, "!!+ %str% ==|!= %str% !!+")) {
-            const std::string &str1 = tok->strAt(1);
-            const std::string &str2 = tok->strAt(3);
-            alwaysTrueFalseStringCompareError(tok, str1, str2);
-            tok = tok->tokAt(5);
+    // number of tokens after tok that are skipped
+    int skip = 0;
+    if (tok->isName() && tok->strAt(1) == "(" && Token::Match(tok, "memcmp|strncmp|strcmp|stricmp|strverscmp|bcmp|strcmpi|strcasecmp|strncasecmp|strncasecmp_l|strcasecmp_l|wcsncasecmp|wcscasecmp|wmemcmp|wcscmp|wcscasecmp_l|wcsncasecmp_l|wcsncmp|_mbscmp|_memicmp|_memicmp_l|_stricmp|_wcsicmp|_mbsicmp|_stricmp_l|_wcsicmp_l|_mbsicmp_l")) {
+        if (Token::Match(tok->tokAt(2), "%str% , %str% ,|)")) {
+            const std::string &str1 = tok->strAt(2);
+            const std::string &str2 = tok->strAt(4);
+            if (!tok->isExpandedMacro() && !tok->tokAt(2)->isExpandedMacro() && !tok->tokAt(4)->isExpandedMacro())
+                alwaysTrueFalseStringCompareError(tok, str1, str2);
+            skip = 5;
+        } else if (Token::Match(tok->tokAt(2), "%name% , %name% ,|)")) {
+            const std::string &str1 = tok->strAt(2);
+            const std::string &str2 = tok->strAt(4);
+            if (str1 == str2)
+                alwaysTrueStringVariableCompareError(tok, str1, str2);
+            skip = 5;
+        } else if (Token::Match(tok->tokAt(2), "%name% . c_str ( ) , %name% . c_str ( ) ,|)")) {
+            const std::string &str1 = tok->strAt(2);
+            const std::string &str2 = tok->strAt(8);
+            if (str1 == str2)
+                alwaysTrueStringVariableCompareError(tok, str1, str2);
+            skip = 13;
         }
-        if (!tok)
-            break;
+    } else if (tok->isName() && Token::Match(tok, "QString :: compare ( %str% , %str% )")) {
+        const std::string &str1 = tok->strAt(4);
+        const std::string &str2 = tok->strAt(6);
+        alwaysTrueFalseStringCompareError(tok, str1, str2);
+        skip = 7;
+    } else if (Token::Match(tok, "!!+ %str% ==|!= %str% !!+")) {
+        const std::string &str1 = tok->strAt(1);
+        const std::string &str2 = tok->strAt(3);
+        alwaysTrueFalseStringCompareError(tok, str1, str2);
+        skip = 5;
+    }
+    if (skip > 0) {
+        const Token *last = tok->tokAt(skip);
+        mAlwaysTrueOrFalseStringCompareSkip = last ? last : mTokenizer->list.back();
     }
 }
 
@@ -161,63 +178,55 @@ void CheckString::alwaysTrueStringVariableCompareError(const Token *tok, const s
 // Detect "str == '\0'" where "*str == '\0'" is correct.
 // Comparing char* with each other instead of using strcmp()
 //-----------------------------------------------------------------------------
-void CheckString::checkSuspiciousStringCompare()
+void CheckString::checkSuspiciousStringCompare(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
+    if (!tok->isComparisonOp())
         return;
 
-    const SymbolDatabase* symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (!tok->isComparisonOp())
-                continue;
-
-            const Token* varTok = tok->astOperand1();
-            const Token* litTok = tok->astOperand2();
-            if (!varTok || !litTok)  // <- failed to create AST for comparison
-                continue;
-            if (Token::Match(varTok, "%char%|%num%|%str%"))
-                std::swap(varTok, litTok);
-            else if (!Token::Match(litTok, "%char%|%num%|%str%"))
-                continue;
+    const Token* varTok = tok->astOperand1();
+    const Token* litTok = tok->astOperand2();
+    if (!varTok || !litTok)  // <- failed to create AST for comparison
+        return;
+    if (Token::Match(varTok, "%char%|%num%|%str%"))
+        std::swap(varTok, litTok);
+    else if (!Token::Match(litTok, "%char%|%num%|%str%"))
+        return;
 
-            // Pointer addition?
-            if (varTok->str() == "+" && mTokenizer->isC()) {
-                const Token * const tokens[2] = { varTok->astOperand1(), varTok->astOperand2() };
-                for (int nr = 0; nr < 2; nr++) {
-                    const Token *t = tokens[nr];
-                    while (t && (t->str() == "." || t->str() == "::"))
-                        t = t->astOperand2();
-                    if (t && t->variable() && t->variable()->isPointer())
-                        varTok = t;
-                }
-            }
+    // Pointer addition?
+    if (varTok->str() == "+" && mTokenizer->isC()) {
+        const Token * const tokens[2] = { varTok->astOperand1(), varTok->astOperand2() };
+        for (int nr = 0; nr < 2; nr++) {
+            const Token *t = tokens[nr];
+            while (t && (t->str() == "." || t->str() == "::"))
+                t = t->astOperand2();
+            if (t && t->variable() && t->variable()->isPointer())
+                varTok = t;
+        }
+    }
 
-            if (varTok->str() == "*") {
-                if (!mTokenizer->isC() || varTok->astOperand2() != nullptr || litTok->tokType() != Token::eString)
-                    continue;
-                varTok = varTok->astOperand1();
-            }
+    if (varTok->str() == "*") {
+        if (!mTokenizer->isC() || varTok->astOperand2() != nullptr || litTok->tokType() != Token::eString)
+            return;
+        varTok = varTok->astOperand1();
+    }
 
-            while (varTok && (varTok->str() == "." || varTok->str() == "::"))
-                varTok = varTok->astOperand2();
-            if (!varTok || !varTok->isName())
-                continue;
+    while (varTok && (varTok->str() == "." || varTok->str() == "::"))
+        varTok = varTok->astOperand2();
+    if (!varTok || !varTok->isName())
+        return;
 
-            const Variable *var = varTok->variable();
+    const Variable *var = varTok->variable();
 
-            while (Token::Match(varTok->astParent(), "[.*]"))
-                varTok = varTok->astParent();
-            const std::string varname = varTok->expressionString();
+    while (Token::Match(varTok->astParent(), "[.*]"))
+        varTok = varTok->astParent();
+    const std::string varname = varTok->expressionString();
 
-            const bool ischar(litTok->tokType() == Token::eChar);
-            if (litTok->tokType() == Token::eString) {
-                if (mTokenizer->isC() || (var && var->isArrayOrPointer()))
-                    suspiciousStringCompareError(tok, varname, litTok->isLong());
-            } else if (ischar && var && var->isPointer()) {
-                suspiciousStringCompareError_char(tok, varname);
-            }
-        }
+    const bool ischar(litTok->tokType() == Token::eChar);
+    if (litTok->tokType() == Token::eString) {
+        if (mTokenizer->isC() || (var && var->isArrayOrPointer()))
+            suspiciousStringCompareError(tok, varname, litTok->isLong());
+    } else if (ischar && var && var->isPointer()) {
+        suspiciousStringCompareError_char(tok, varname);
     }
 }
 
@@ -244,17 +253,12 @@ static bool isChar(const Variable* var)
     return (var && !var->isPointer() && !var->isArray() && (var->typeStartToken()->str() == "char" || var->typeStartToken()->str() == "wchar_t"));
 }
 
-void CheckString::strPlusChar()
+void CheckString::strPlusChar(const Token *tok)
 {
-    const SymbolDatabase* symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (tok->str() == "+") {
-                if (tok->astOperand1() && (tok->astOperand1()->tokType() == Token::eString)) { // string literal...
-                    if (tok->astOperand2() && (tok->astOperand2()->tokType() == Token::eChar || isChar(tok->astOperand2()->variable()))) // added to char variable or char constant
-                        strPlusCharError(tok);
-                }
-            }
+    if (tok->str() == "+") {
+        if (tok->astOperand1() && (tok->astOperand1()->tokType() == Token::eString)) { // string literal...
+            if (tok->astOperand2() && (tok->astOperand2()->tokType() == Token::eChar || isChar(tok->astOperand2()->variable()))) // added to char variable or char constant
+                strPlusCharError(tok);
         }
     }
 }
@@ -273,52 +277,50 @@ void CheckString::strPlusCharError(const Token *tok)
 // Implicit casts of string literals to bool
 // Comparing string literal with strlen() with wrong length
 //---------------------------------------------------------------------------
-void CheckString::checkIncorrectStringCompare()
+void CheckString::checkIncorrectStringCompare(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
-        return;
+    if (mIncorrectStringCompareSkip) {
+        if (tok->index() <= mIncorrectStringCompareSkip->index())
+            return;
+        mIncorrectStringCompareSkip = nullptr;
+    }
 
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            // skip "assert(str && ..)" and "assert(.. && str)"
-            if ((endsWith(tok->str(), "assert", 6) || endsWith(tok->str(), "ASSERT", 6)) &&
-                Token::Match(tok, "%name% (") &&
-                (Token::Match(tok->tokAt(2), "%str% &&") || Token::Match(tok->next()->link()->tokAt(-2), "&& %str% )")))
-                tok = tok->next()->link();
-
-            if (Token::simpleMatch(tok, ". substr (") && Token::Match(tok->tokAt(3)->nextArgument(), "%num% )")) {
-                const MathLib::biguint clen = MathLib::toULongNumber(tok->linkAt(2)->strAt(-1));
-                const Token* begin = tok->previous();
-                for (;;) { // Find start of statement
-                    while (begin->link() && Token::Match(begin, "]|)|>"))
-                        begin = begin->link()->previous();
-                    if (Token::Match(begin->previous(), ".|::"))
-                        begin = begin->tokAt(-2);
-                    else
-                        break;
-                }
-                begin = begin->previous();
-                const Token* end = tok->linkAt(2)->next();
-                if (Token::Match(begin->previous(), "%str% ==|!=") && begin->strAt(-2) != "+") {
-                    const std::size_t slen = Token::getStrLength(begin->previous());
-                    if (clen != slen) {
-                        incorrectStringCompareError(tok->next(), "substr", begin->strAt(-1));
-                    }
-                } else if (Token::Match(end, "==|!= %str% !!+")) {
-                    const std::size_t slen = Token::getStrLength(end->next());
-                    if (clen != slen) {
-                        incorrectStringCompareError(tok->next(), "substr", end->strAt(1));
-                    }
-                }
-            } else if (Token::Match(tok, "&&|%oror%|( %str%|%char% &&|%oror%|)") && !Token::Match(tok, "( %str%|%char% )")) {
-                incorrectStringBooleanError(tok->next(), tok->strAt(1));
-            } else if (Token::Match(tok, "if|while ( %str%|%char% )") && !tok->tokAt(2)->getValue(0)) {
-                incorrectStringBooleanError(tok->tokAt(2), tok->strAt(2));
-            } else if (tok->str() == "?" && Token::Match(tok->astOperand1(), "%str%|%char%"))
-                incorrectStringBooleanError(tok->astOperand1(), tok->astOperand1()->str());
+    // skip "assert(str && ..)" and "assert(.. && str)"
+    if ((endsWith(tok->str(), "assert", 6) || endsWith(tok->str(), "ASSERT", 6)) &&
+        Token::Match(tok, "%name% (") &&
+        (Token::Match(tok->tokAt(2), "%str% &&") || Token::Match(tok->next()->link()->tokAt(-2), "&& %str% )")))
+        mIncorrectStringCompareSkip = tok = tok->next()->link();
+
+    if (Token::simpleMatch(tok, ". substr (") && Token::Match(tok->tokAt(3)->nextArgument(), "%num% )")) {
+        const MathLib::biguint clen = MathLib::toULongNumber(tok->linkAt(2)->strAt(-1));
+        const Token* begin = tok->previous();
+        for (;;) { // Find start of statement
+            while (begin->link() && Token::Match(begin, "]|)|>"))
+                begin = begin->link()->previous();
+            if (Token::Match(begin->previous(), ".|::"))
+                begin = begin->tokAt(-2);
+            else
+                break;
         }
-    }
+        begin = begin->previous();
+        const Token* end = tok->linkAt(2)->next();
+        if (Token::Match(begin->previous(), "%str% ==|!=") && begin->strAt(-2) != "+") {
+            const std::size_t slen = Token::getStrLength(begin->previous());
+            if (clen != slen) {
+                incorrectStringCompareError(tok->next(), "substr", begin->strAt(-1));
+            }
+        } else if (Token::Match(end, "==|!= %str% !!+")) {
+            const std::size_t slen = Token::getStrLength(end->next());
+            if (clen != slen) {
+                incorrectStringCompareError(tok->next(), "substr", end->strAt(1));
+            }
+        }
+    } else if (Token::Match(tok, "&&|%oror%|( %str%|%char% &&|%oror%|)") && !Token::Match(tok, "( %str%|%char% )")) {
+        incorrectStringBooleanError(tok->next(), tok->strAt(1));
+    } else if (Token::Match(tok, "if|while ( %str%|%char% )") && !tok->tokAt(2)->getValue(0)) {
+        incorrectStringBooleanError(tok->tokAt(2), tok->strAt(2));
+    } else if (tok->str() == "?" && Token::Match(tok->astOperand1(), "%str%|%char%"))
+        incorrectStringBooleanError(tok->astOperand1(), tok->astOperand1()->str());
 }
 
 void CheckString::incorrectStringCompareError(const Token *tok, const std::string& func, const std::string &string)
@@ -341,67 +343,59 @@ void CheckString::incorrectStringBooleanError(const Token *tok, const std::strin
 // always true: strcmp(str,"a")==0 || strcmp(str,"b")
 // TODO: Library configuration for string comparison functions
 //---------------------------------------------------------------------------
-void CheckString::overlappingStrcmp()
+void CheckString::overlappingStrcmp(const Token *tok)
 {
-    if (!mSettings->isEnabled(Settings::WARNING))
+    if (tok->str() != "||")
         return;
+    std::list<const Token *> equals0;
+    std::list<const Token *> notEquals0;
+    std::stack<const Token *> tokens;
+    tokens.push(tok);
+    while (!tokens.empty()) {
+        const Token * const t = tokens.top();
+        tokens.pop();
+        if (!t)
+            continue;
+        if (t->str() == "||") {
+            tokens.push(t->astOperand1());
+            tokens.push(t->astOperand2());
+            continue;
+        }
+        if (t->str() == "==") {
+            if (Token::simpleMatch(t->astOperand1(), "(") && Token::simpleMatch(t->astOperand2(), "0"))
+                equals0.push_back(t->astOperand1());
+            else if (Token::simpleMatch(t->astOperand2(), "(") && Token::simpleMatch(t->astOperand1(), "0"))
+                equals0.push_back(t->astOperand2());
+            continue;
+        }
+        if (t->str() == "!=") {
+            if (Token::simpleMatch(t->astOperand1(), "(") && Token::simpleMatch(t->astOperand2(), "0"))
+                notEquals0.push_back(t->astOperand1());
+            else if (Token::simpleMatch(t->astOperand2(), "(") && Token::simpleMatch(t->astOperand1(), "0"))
+                notEquals0.push_back(t->astOperand2());
+            continue;
+        }
+        if (t->str() == "!" && Token::simpleMatch(t->astOperand1(), "("))
+            equals0.push_back(t->astOperand1());
+        else if (t->str() == "(")
+            notEquals0.push_back(t);
+    }
 
-    const SymbolDatabase *symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (tok->str() != "||")
+    for (const Token *eq0 : equals0) {
+        for (const Token * ne0 : notEquals0) {
+            if (!Token::Match(eq0->previous(), "strcmp|wcscmp ("))
                 continue;
-            std::list<const Token *> equals0;
-            std::list<const Token *> notEquals0;
-            std::stack<const Token *> tokens;
-            tokens.push(tok);
-            while (!tokens.empty()) {
-                const Token * const t = tokens.top();
-                tokens.pop();
-                if (!t)
-                    continue;
-                if (t->str() == "||") {
-                    tokens.push(t->astOperand1());
-                    tokens.push(t->astOperand2());
-                    continue;
-                }
-                if (t->str() == "==") {
-                    if (Token::simpleMatch(t->astOperand1(), "(") && Token::simpleMatch(t->astOperand2(), "0"))
-                        equals0.push_back(t->astOperand1());
-                    else if (Token::simpleMatch(t->astOperand2(), "(") && Token::simpleMatch(t->astOperand1(), "0"))
-                        equals0.push_back(t->astOperand2());
-                    continue;
-                }
-                if (t->str() == "!=") {
-                    if (Token::simpleMatch(t->astOperand1(), "(") && Token::simpleMatch(t->astOperand2(), "0"))
-                        notEquals0.push_back(t->astOperand1());
-                    else if (Token::simpleMatch(t->astOperand2(), "(") && Token::simpleMatch(t->astOperand1(), "0"))
-                        notEquals0.push_back(t->astOperand2());
-                    continue;
-                }
-                if (t->str() == "!" && Token::simpleMatch(t->astOperand1(), "("))
-                    equals0.push_back(t->astOperand1());
-                else if (t->str() == "(")
-                    notEquals0.push_back(t);
-            }
-
-            for (const Token *eq0 : equals0) {
-                for (const Token * ne0 : notEquals0) {
-                    if (!Token::Match(eq0->previous(), "strcmp|wcscmp ("))
-                        continue;
-                    if (!Token::Match(ne0->previous(), "strcmp|wcscmp ("))
-                        continue;
-                    const std::vector<const Token *> args1 = getArguments(eq0->previous());
-                    const std::vector<const Token *> args2 = getArguments(ne0->previous());
-                    if (args1.size() != 2 || args2.size() != 2)
-                        continue;
-                    if (args1[1]->isLiteral() &&
-                        args2[1]->isLiteral() &&
-                        args1[1]->str() != args2[1]->str() &&
-                        isSameExpression(mTokenizer->isCPP(), true, args1[0], args2[0], mSettings->library, true, false))
-                        overlappingStrcmpError(eq0, ne0);
-                }
-            }
+            if (!Token::Match(ne0->previous(), "strcmp|wcscmp ("))
+                continue;
+            const std::vector<const Token *> args1 = getArguments(eq0->previous());
+            const std::vector<const Token *> args2 = getArguments(ne0->previous());
+            if (args1.size() != 2 || args2.size() != 2)
+                continue;
+            if (args1[1]->isLiteral() &&
+                args2[1]->isLiteral() &&
+                args1[1]->str() != args2[1]->str() &&
+                isSameExpression(mTokenizer->isCPP(), true, args1[0], args2[0], mSettings->library, true, false))
+                overlappingStrcmpError(eq0, ne0);
         }
     }
 }
@@ -423,38 +417,33 @@ void CheckString::overlappingStrcmpError(const Token *eq0, const Token *ne0)
 // Overlapping source and destination passed to sprintf().
 // TODO: Library configuration for overlapping arguments
 //---------------------------------------------------------------------------
-void CheckString::sprintfOverlappingData()
+void CheckString::sprintfOverlappingData(const Token *tok)
 {
-    const SymbolDatabase* symbolDatabase = mTokenizer->getSymbolDatabase();
-    for (const Scope * scope : symbolDatabase->functionScopes) {
-        for (const Token* tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
-            if (!Token::Match(tok, "sprintf|snprintf|swprintf ("))
-                continue;
+    if (!Token::Match(tok, "sprintf|snprintf|swprintf ("))
+        return;
 
-            const std::vector<const Token *> args = getArguments(tok);
-
-            const int formatString = Token::simpleMatch(tok, "sprintf") ? 1 : 2;
-            for (unsigned int argnr = formatString + 1; argnr < args.size(); ++argnr) {
-                const Token *dest = args[0];
-                if (dest->isCast())
-                    dest = dest->astOperand2() ? dest->astOperand2() : dest->astOperand1();
-                const Token *arg = args[argnr];
-                if (!arg->valueType() || arg->valueType()->pointer != 1)
-                    continue;
-                if (arg->isCast())
-                    arg = arg->astOperand2() ? arg->astOperand2() : arg->astOperand1();
-
-                const bool same = isSameExpression(mTokenizer->isCPP(),
-                                                   false,
-                                                   dest,
-                                                   arg,
-                                                   mSettings->library,
-                                                   true,
-                                                   false);
-                if (same) {
-                    sprintfOverlappingDataError(tok, args[argnr], args[argnr]->expressionString());
-                }
-            }
+    const std::vector<const Token *> args = getArguments(tok);
+
+    const int formatString = Token::simpleMatch(tok, "sprintf") ? 1 : 2;
+    for (unsigned int argnr = formatString + 1; argnr < args.size(); ++argnr) {
+        const Token *dest = args[0];
+        if (dest->isCast())
+            dest = dest->astOperand2() ? dest->astOperand2() : dest->astOperand1();
+        const Token *arg = args[argnr];
+        if (!arg->valueType() || arg->valueType()->pointer != 1)
+            continue;
+        if (arg->isCast())
+            arg = arg->astOperand2() ? arg->astOperand2() : arg->astOperand1();
+
+        const bool same = isSameExpression(mTokenizer->isCPP(),
+                                           false,
+                                           dest,
+                                           arg,
+                                           mSettings->library,
+                                           true,
+                                           false);
+        if (same) {
+            sprintfOverlappingDataError(tok, args[argnr], args[argnr]->expressionString());
         }
     }
 }
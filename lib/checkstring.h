@@ -41,50 +41,57 @@ class Tokenizer;
 class CPPCHECKLIB CheckString : public Check {
 public:
     /** @brief This constructor is used when registering the CheckClass */
-    CheckString() : Check(myName()) {
+    CheckString() : Check(myName()), mIncorrectStringCompareSkip(nullptr), mAlwaysTrueOrFalseStringCompareSkip(nullptr) {
     }
 
     /** @brief This constructor is used when running checks. */
     CheckString(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
-        : Check(myName(), tokenizer, settings, errorLogger) {
+        : Check(myName(), tokenizer, settings, errorLogger), mIncorrectStringCompareSkip(nullptr), mAlwaysTrueOrFalseStringCompareSkip(nullptr) {
     }
 
     /** @brief Run checks against the normal token list */
     void runChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) OVERRIDE {
-        CheckString checkString(tokenizer, settings, errorLogger);
-
-        // Checks
-        checkString.strPlusChar();
-        checkString.checkSuspiciousStringCompare();
-        checkString.stringLiteralWrite();
-        checkString.overlappingStrcmp();
-        checkString.checkIncorrectStringCompare();
-        checkString.sprintfOverlappingData();
-        checkString.checkAlwaysTrueOrFalseStringCompare();
+        TokenDispatcher dispatcher;
+        if (subscribe(dispatcher, tokenizer, settings, errorLogger))
+            dispatcher.dispatch(tokenizer);
+    }
+
+    bool subscribe(TokenDispatcher &dispatcher, const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) OVERRIDE {
+        CheckString *checkString = dispatcher.add(new CheckString(tokenizer, settings, errorLogger));
+        checkString->subscribeChecks(dispatcher);
+        return true;
     }
 
     /** @brief undefined behaviour, writing string literal */
-    void stringLiteralWrite();
+    void stringLiteralWrite(const Token *tok);
 
     /** @brief str plus char (unusual pointer arithmetic) */
-    void strPlusChar();
+    void strPlusChar(const Token *tok);
 
     /** @brief %Check for using bad usage of strncmp and substr */
-    void checkIncorrectStringCompare();
+    void checkIncorrectStringCompare(const Token *tok);
 
     /** @brief %Check for comparison of a string literal with a char* variable */
-    void checkSuspiciousStringCompare();
+    void checkSuspiciousStringCompare(const Token *tok);
 
     /** @brief %Check for suspicious code that compares string literals for equality */
-    void checkAlwaysTrueOrFalseStringCompare();
+    void checkAlwaysTrueOrFalseStringCompare(const Token *tok);
 
     /** @brief %Check for overlapping strcmp() */
-    void overlappingStrcmp();
+    void overlappingStrcmp(const Token *tok);
 
     /** @brief %Check for overlapping source and destination passed to sprintf() */
-    void sprintfOverlappingData();
+    void sprintfOverlappingData(const Token *tok);
 
 private:
+    /** Subscribe the enabled checks */
+    void subscribeChecks(TokenDispatcher &dispatcher);
+
+    /** Last token that checkIncorrectStringCompare() skips */
+    const Token *mIncorrectStringCompareSkip;
+    /** Last token that checkAlwaysTrueOrFalseStringCompare() skips */
+    const Token *mAlwaysTrueOrFalseStringCompareSkip;
+
     void stringLiteralWriteError(const Token *tok, const Token *strValue);
     void sprintfOverlappingDataError(const Token *funcTok, const Token *tok, const std::string &varname);
     void strPlusCharError(const Token *tok);
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 class ErrorLogger;
 class Scope;
@@ -61,6 +62,10 @@ public:
         checkUnusedVar.checkFunctionVariableUsage();
     }
 
+    std::vector<Severity::SeverityType> severities() const OVERRIDE {
+        return {Severity::style};
+    }
+
     /** @brief %Check for unused function variables */
     void checkFunctionVariableUsage_iterateScopes(const Scope* const scope, Variables& variables);
     void checkFunctionVariableUsage();
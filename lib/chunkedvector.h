@@ -0,0 +1,261 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef chunkedvectorH
+#define chunkedvectorH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Sequence container with stable element addresses
+ *
+ * Elements are stored in chunks of contiguous memory. The first chunk
+ * holds FIRST_CHUNK elements and every further chunk twice as many as
+ * the one before. A chunk is never reallocated, so pointers and
+ * references to elements stay valid until the element is removed, just
+ * like in a std::list, while neighbouring elements share cache lines.
+ */
+template<class T>
+class ChunkedVector {
+    typedef std::vector<std::vector<T>> Chunks;
+
+    template<class V, class C>
+    class Iterator {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef V value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V *pointer;
+        typedef V &reference;
+
+        Iterator() : mChunks(nullptr), mChunk(0), mOffset(0) {}
+        Iterator(C *chunks, std::size_t chunk, std::size_t offset) : mChunks(chunks), mChunk(chunk), mOffset(offset) {}
+
+        /** iterator to const_iterator conversion */
+        template<class V2, class C2>
+        Iterator(const Iterator<V2, C2> &other) : mChunks(other.mChunks), mChunk(other.mChunk), mOffset(other.mOffset) {}
+
+        reference operator*() const {
+            return (*mChunks)[mChunk][mOffset];
+        }
+        pointer operator->() const {
+            return &(*mChunks)[mChunk][mOffset];
+        }
+
+        Iterator &operator++() {
+            // The end iterator points past the last element of the last chunk
+            if (++mOffset == (*mChunks)[mChunk].size() && mChunk + 1 < mChunks->size()) {
+                ++mChunk;
+                mOffset = 0;
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator it(*this);
+            ++*this;
+            return it;
+        }
+        Iterator &operator--() {
+            if (mOffset == 0) {
+                --mChunk;
+                mOffset = (*mChunks)[mChunk].size();
+            }
+            --mOffset;
+            return *this;
+        }
+        Iterator operator--(int) {
+            Iterator it(*this);
+            --*this;
+            return it;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return mChunk == other.mChunk && mOffset == other.mOffset;
+        }
+        bool operator!=(const Iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        template<class V2, class C2> friend class Iterator;
+
+        C *mChunks;
+        std::size_t mChunk;
+        std::size_t mOffset;
+    };
+
+public:
+    typedef T value_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef std::size_t size_type;
+    typedef Iterator<T, Chunks> iterator;
+    typedef Iterator<const T, const Chunks> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    enum { FIRST_CHUNK = 4 };
+
+    ChunkedVector() : mSize(0) {}
+
+    ChunkedVector(const ChunkedVector &other) : mSize(0) {
+        for (const T &t : other)
+            push_back(t);
+    }
+
+    ChunkedVector(ChunkedVector &&other) : mChunks(std::move(other.mChunks)), mSize(other.mSize) {
+        other.mChunks.clear();
+        other.mSize = 0;
+    }
+
+    ChunkedVector &operator=(ChunkedVector other) {
+        mChunks.swap(other.mChunks);
+        std::swap(mSize, other.mSize);
+        return *this;
+    }
+
+    iterator begin() {
+        return iterator(&mChunks, 0, 0);
+    }
+    const_iterator begin() const {
+        return const_iterator(&mChunks, 0, 0);
+    }
+    iterator end() {
+        return mChunks.empty() ? begin() : iterator(&mChunks, mChunks.size() - 1, mChunks.back().size());
+    }
+    const_iterator end() const {
+        return mChunks.empty() ? begin() : const_iterator(&mChunks, mChunks.size() - 1, mChunks.back().size());
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    std::size_t size() const {
+        return mSize;
+    }
+    bool empty() const {
+        return mSize == 0;
+    }
+
+    T &front() {
+        return mChunks.front().front();
+    }
+    const T &front() const {
+        return mChunks.front().front();
+    }
+    T &back() {
+        return mChunks.back().back();
+    }
+    const T &back() const {
+        return mChunks.back().back();
+    }
+
+    /** Element access by index, the index of an element never changes */
+    T &operator[](std::size_t index) {
+        std::size_t chunk, offset;
+        locate(index, &chunk, &offset);
+        return mChunks[chunk][offset];
+    }
+    const T &operator[](std::size_t index) const {
+        std::size_t chunk, offset;
+        locate(index, &chunk, &offset);
+        return mChunks[chunk][offset];
+    }
+
+    void push_back(const T &t) {
+        chunkForInsert().push_back(t);
+        ++mSize;
+    }
+    void push_back(T &&t) {
+        chunkForInsert().push_back(std::move(t));
+        ++mSize;
+    }
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+        chunkForInsert().emplace_back(std::forward<Args>(args)...);
+        ++mSize;
+    }
+
+    void pop_back() {
+        mChunks.back().pop_back();
+        if (mChunks.back().empty())
+            mChunks.pop_back();
+        --mSize;
+    }
+
+    void clear() {
+        mChunks.clear();
+        mSize = 0;
+    }
+
+private:
+    /** Last chunk, a new one is added when it is full. */
+    std::vector<T> &chunkForInsert() {
+        if (mChunks.empty() || mChunks.back().size() == chunkCapacity(mChunks.size() - 1)) {
+            mChunks.emplace_back();
+            mChunks.back().reserve(chunkCapacity(mChunks.size() - 1));
+        }
+        return mChunks.back();
+    }
+
+    static std::size_t chunkCapacity(std::size_t chunk) {
+        return static_cast<std::size_t>(FIRST_CHUNK) << chunk;
+    }
+
+    static void locate(std::size_t index, std::size_t *chunk, std::size_t *offset) {
+        std::size_t capacity = FIRST_CHUNK;
+        *chunk = 0;
+        while (index >= capacity) {
+            index -= capacity;
+            capacity <<= 1;
+            ++*chunk;
+        }
+        *offset = index;
+    }
+
+    /** Chunk n has room for FIRST_CHUNK << n elements. Only the last chunk is not full. */
+    Chunks mChunks;
+    std::size_t mSize;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // chunkedvectorH
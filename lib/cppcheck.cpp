@@ -27,6 +27,7 @@
 #include "preprocessor.h" // Preprocessor
 #include "suppressions.h"
 #include "timer.h"
+#include "tokencache.h"
 #include "token.h"
 #include "tokenize.h" // Tokenizer
 #include "tokenlist.h"
@@ -37,10 +38,17 @@
 #include <simplecpp.h>
 #include <tinyxml2.h>
 #include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <ctime>
+#include <exception>
+#include <map>
+#include <mutex>
 #include <new>
 #include <set>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <iostream> // <- TEMPORARY
@@ -126,6 +134,41 @@ namespace {
             return getAddonInfo(obj["script"].get<std::string>(), exename);
         }
     };
+
+    /** Keeps the messages of a check until the messages of the checks before it are reported */
+    class DelayedErrorLogger : public ErrorLogger {
+    public:
+        explicit DelayedErrorLogger(ErrorLogger &errorLogger) : mErrorLogger(errorLogger) {}
+
+        void reportOut(const std::string &outmsg) OVERRIDE {
+            mMessages.emplace_back(true, outmsg, ErrorLogger::ErrorMessage());
+        }
+
+        void reportErr(const ErrorLogger::ErrorMessage &msg) OVERRIDE {
+            mMessages.emplace_back(false, emptyString, msg);
+        }
+
+        void flush() {
+            for (const Message &message : mMessages) {
+                if (message.out)
+                    mErrorLogger.reportOut(message.outmsg);
+                else
+                    mErrorLogger.reportErr(message.msg);
+            }
+            mMessages.clear();
+        }
+
+    private:
+        struct Message {
+            Message(bool o, const std::string &s, const ErrorLogger::ErrorMessage &m) : out(o), outmsg(s), msg(m) {}
+            bool out;
+            std::string outmsg;
+            ErrorLogger::ErrorMessage msg;
+        };
+
+        ErrorLogger &mErrorLogger;
+        std::vector<Message> mMessages;
+    };
 }
 
 static std::string executeAddon(const AddonInfo &addonInfo, const std::string &dumpFile)
@@ -160,6 +203,139 @@ static std::vector<std::string> split(const std::string &str, const std::string
     return ret;
 }
 
+/** Configuration that is checked, the -D defines are always included */
+static std::string getCurrentConfig(const std::string &userDefines, const std::string &currCfg)
+{
+    if (userDefines.empty())
+        return currCfg;
+
+    std::string currentConfig = userDefines;
+    const std::vector<std::string> v1(split(userDefines, ";"));
+    for (const std::string &cfg: split(currCfg, ";")) {
+        if (std::find(v1.begin(), v1.end(), cfg) == v1.end()) {
+            currentConfig += ";" + cfg;
+        }
+    }
+    return currentConfig;
+}
+
+/** Tool version and settings that affect the results in the build dir */
+static std::string getToolInfo(const Settings &settings)
+{
+    std::ostringstream toolinfo;
+    toolinfo << CPPCHECK_VERSION_STRING;
+    toolinfo << (settings.isEnabled(Settings::WARNING) ? 'w' : ' ');
+    toolinfo << (settings.isEnabled(Settings::STYLE) ? 's' : ' ');
+    toolinfo << (settings.isEnabled(Settings::PERFORMANCE) ? 'p' : ' ');
+    toolinfo << (settings.isEnabled(Settings::PORTABILITY) ? 'p' : ' ');
+    toolinfo << (settings.isEnabled(Settings::INFORMATION) ? 'i' : ' ');
+    toolinfo << (settings.isEnabled(Settings::MISSING_INCLUDE) ? 'm' : ' ');
+    toolinfo << settings.userDefines;
+    // Preprocessing
+    for (const std::string &U : settings.userUndefs)
+        toolinfo << " -U" << U;
+    for (const std::string &I : settings.includePaths)
+        toolinfo << " -I" << I;
+    for (const std::string &include : settings.userIncludes)
+        toolinfo << " --include=" << include;
+    toolinfo << ' ' << static_cast<int>(settings.standards.c) << static_cast<int>(settings.standards.cpp) << static_cast<int>(settings.enforcedLang);
+    const unsigned int platformSizes[] = {
+        settings.char_bit, settings.sizeof_bool, settings.sizeof_short, settings.sizeof_int, settings.sizeof_long,
+        settings.sizeof_long_long, settings.sizeof_float, settings.sizeof_double, settings.sizeof_long_double,
+        settings.sizeof_wchar_t, settings.sizeof_size_t, settings.sizeof_pointer
+    };
+    toolinfo << ' ' << static_cast<int>(settings.platformType);
+    for (const unsigned int size : platformSizes)
+        toolinfo << ',' << size;
+    toolinfo << ',' << static_cast<int>(settings.defaultSign);
+    // Analysis
+    for (const std::string &library : settings.libraries)
+        toolinfo << " --library=" << library;
+    toolinfo << ' ' << settings.inconclusive << settings.experimental << settings.force << settings.checkHeaders
+             << settings.checkUnusedTemplates << settings.checkLibrary << settings.debugwarnings
+             << ',' << settings.maxConfigs << ',' << settings.maxCtuDepth;
+    for (const Settings::Rule &rule : settings.rules)
+        toolinfo << " --rule=" << rule.id << ':' << rule.tokenlist << ':' << rule.pattern;
+    settings.nomsg.dump(toolinfo);
+    return toolinfo.str();
+}
+
+static ErrorLogger::ErrorMessage internalErrorMessage(const InternalError &e, const Tokenizer &tokenizer, const std::string &filename)
+{
+    std::list<ErrorLogger::ErrorMessage::FileLocation> locationList;
+    ErrorLogger::ErrorMessage::FileLocation loc;
+    if (e.token) {
+        loc.line = e.token->linenr();
+        loc.col = e.token->col();
+        const std::string fixedpath = Path::toNativeSeparators(tokenizer.list.file(e.token));
+        loc.setfile(fixedpath);
+    } else {
+        ErrorLogger::ErrorMessage::FileLocation loc2;
+        loc2.setfile(Path::toNativeSeparators(filename));
+        locationList.push_back(loc2);
+        loc.setfile(tokenizer.list.getSourceFilePath());
+    }
+    locationList.push_back(loc);
+    return ErrorLogger::ErrorMessage(locationList,
+                                     tokenizer.list.getSourceFilePath(),
+                                     Severity::error,
+                                     e.errorMessage,
+                                     e.id,
+                                     false);
+}
+
+namespace {
+    /** What is reported while a configuration is checked on a worker thread, see CppCheck::checkConfigurations() */
+    class ConfigurationResult : public ErrorLogger {
+    public:
+        enum Stage { PENDING, PREPROCESSED, SIMPLIFIED, DONE };
+
+        ConfigurationResult() : stage(PENDING), valid(false), skipped(false), hasChecksum(false), checksum(0), purged(false), checked(false) {}
+
+        void reportOut(const std::string &outmsg) OVERRIDE {
+            messages.emplace_back(Message::OUT, outmsg, ErrorLogger::ErrorMessage());
+        }
+
+        void reportErr(const ErrorLogger::ErrorMessage &msg) OVERRIDE {
+            messages.emplace_back(Message::ERR, emptyString, msg);
+        }
+
+        void reportInfo(const ErrorLogger::ErrorMessage &msg) OVERRIDE {
+            messages.emplace_back(Message::INFO, emptyString, msg);
+        }
+
+        struct Message {
+            enum Type { OUT, ERR, INFO };
+            Message(Type t, const std::string &o, const ErrorLogger::ErrorMessage &m) : type(t), outmsg(o), msg(m) {}
+            Type type;
+            std::string outmsg;
+            ErrorLogger::ErrorMessage msg;
+        };
+        std::list<Message> messages;
+
+        /** How far the configuration is checked, protected by the mutex of the configurations */
+        Stage stage;
+
+        /** The configuration could be preprocessed */
+        bool valid;
+        std::string configurationError;
+
+        /** Not checked because of --max-configs */
+        bool skipped;
+
+        bool hasChecksum;
+        unsigned long long checksum;
+
+        /** Same simplified tokens as a previous configuration */
+        bool purged;
+
+        /** The checks were run, the tokens are used for whole program analysis */
+        bool checked;
+
+        std::exception_ptr error;
+    };
+}
+
 CppCheck::CppCheck(ErrorLogger &errorLogger, bool useGlobalSuppressions)
     : mErrorLogger(errorLogger), mExitCode(0), mSuppressInternalErrorFound(false), mUseGlobalSuppressions(useGlobalSuppressions), mTooManyConfigs(false), mSimplify(true)
 {
@@ -187,13 +363,13 @@ const char * CppCheck::extraVersion()
 unsigned int CppCheck::check(const std::string &path)
 {
     std::ifstream fin(path);
-    return checkFile(Path::simplifyPath(path), emptyString, fin);
+    return checkFile(Path::simplifyPath(path), emptyString, fin, true);
 }
 
 unsigned int CppCheck::check(const std::string &path, const std::string &content)
 {
     std::istringstream iss(content);
-    return checkFile(Path::simplifyPath(path), emptyString, iss);
+    return checkFile(Path::simplifyPath(path), emptyString, iss, false);
 }
 
 unsigned int CppCheck::check(const ImportProject::FileSettings &fs)
@@ -209,10 +385,10 @@ unsigned int CppCheck::check(const ImportProject::FileSettings &fs)
         temp.mSettings.platform(fs.platformType);
     }
     std::ifstream fin(fs.filename);
-    return temp.checkFile(Path::simplifyPath(fs.filename), fs.cfg, fin);
+    return temp.checkFile(Path::simplifyPath(fs.filename), fs.cfg, fin, true);
 }
 
-unsigned int CppCheck::checkFile(const std::string& filename, const std::string &cfgname, std::istream& fileStream)
+unsigned int CppCheck::checkFile(const std::string& filename, const std::string &cfgname, std::istream& fileStream, bool fileOnDisk)
 {
     mExitCode = 0;
     mSuppressInternalErrorFound = false;
@@ -221,6 +397,15 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
     if (!Path::acceptFile(filename))
         mSettings.debugwarnings = false;
 
+    // Only compute the analysis results that the checks that run read
+    mSettings.analysis = 0;
+    for (const Check *check : Check::instances()) {
+        if (check->canReport(&mSettings))
+            mSettings.analysis |= check->analysis(&mSettings);
+    }
+    if (mSettings.dump || !mSettings.addons.empty() || mSettings.debugnormal)
+        mSettings.analysis = Settings::MOVED_VALUES;
+
     if (mSettings.terminated())
         return mExitCode;
 
@@ -251,6 +436,20 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
         plistFile.close();
     }
 
+    // Reuse the results of the previous run if no dependency is changed. Inline
+    // suppressions are added to the settings when the file is tokenized, so
+    // files are always tokenized when they are enabled.
+    if (fileOnDisk && !mSettings.buildDir.empty() && !mSettings.inlineSuppressions && !mSettings.dump && mSettings.addons.empty() && mSettings.plistOutput.empty()) {
+        std::list<ErrorLogger::ErrorMessage> errors;
+        if (AnalyzerInformation::reuseResults(mSettings.buildDir, filename, cfgname, getToolInfo(mSettings), &errors)) {
+            while (!errors.empty()) {
+                reportErr(errors.front());
+                errors.pop_front();
+            }
+            return mExitCode;  // known results => no need to reanalyze file
+        }
+    }
+
     CheckUnusedFunctions checkUnusedFunctions(nullptr, nullptr, nullptr);
 
     try {
@@ -259,7 +458,13 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
 
         simplecpp::OutputList outputList;
         std::vector<std::string> files;
-        simplecpp::TokenList tokens1(fileStream, files, filename, &outputList);   // 以xml 树的形式解析所有 token
+        simplecpp::TokenList tokens1(files);
+
+        // Stamp of the source file as it is read, for the dependencies in the build dir
+        const std::time_t readTime = std::time(nullptr);
+        TokenCache::FileStamp sourceStamp;
+        const bool stamped = fileOnDisk && !mSettings.buildDir.empty() && sourceStamp.stat(filename);
+        TokenCache::readfile(mSettings.buildDir, fileStream, files, filename, tokens1, &outputList, stamped ? &sourceStamp : nullptr);   // 以xml 树的形式解析所有 token
 
         // If there is a syntax error, report it and stop
         for (const simplecpp::Output &output : outputList) {
@@ -355,20 +560,26 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
 
         if (!mSettings.buildDir.empty()) {
             // Get toolinfo
-            std::ostringstream toolinfo;
-            toolinfo << CPPCHECK_VERSION_STRING;
-            toolinfo << (mSettings.isEnabled(Settings::WARNING) ? 'w' : ' ');
-            toolinfo << (mSettings.isEnabled(Settings::STYLE) ? 's' : ' ');
-            toolinfo << (mSettings.isEnabled(Settings::PERFORMANCE) ? 'p' : ' ');
-            toolinfo << (mSettings.isEnabled(Settings::PORTABILITY) ? 'p' : ' ');
-            toolinfo << (mSettings.isEnabled(Settings::INFORMATION) ? 'i' : ' ');
-            toolinfo << mSettings.userDefines;
-            mSettings.nomsg.dump(toolinfo);
+            const std::string toolinfo = getToolInfo(mSettings);
 
             // Calculate checksum so it can be compared with old checksum / future checksums
-            const unsigned int checksum = preprocessor.calculateChecksum(tokens1, toolinfo.str());
+            const unsigned long long checksum = preprocessor.calculateChecksum(tokens1, toolinfo);
+
+            // Files and directories for the fast check in the next run
+            std::string dependencies;
+            if (stamped) {
+                std::map<std::string, TokenCache::FileStamp> dependencyFiles(preprocessor.getFileStamps());
+                dependencyFiles[filename] = sourceStamp;
+                std::set<std::string> dependencyDirs(mSettings.includePaths.begin(), mSettings.includePaths.end());
+                for (const std::string &f : files) {
+                    const std::string dir = Path::getPathFromFilename(f);
+                    dependencyDirs.insert(dir.empty() ? "." : dir);
+                }
+                dependencies = AnalyzerInformation::getDependencies(toolinfo, dependencyFiles, dependencyDirs, readTime);
+            }
+
             std::list<ErrorLogger::ErrorMessage> errors;
-            if (!mAnalyzerInformation.analyzeFile(mSettings.buildDir, filename, cfgname, checksum, &errors)) {
+            if (!mAnalyzerInformation.analyzeFile(mSettings.buildDir, filename, cfgname, checksum, &errors, dependencies)) {
                 while (!errors.empty()) {
                     reportErr(errors.front());
                     errors.pop_front();
@@ -428,9 +639,16 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
         unsigned int checkCount = 0;
         bool hasValidConfig = false;
         std::list<std::string> configurationError;
+
+        // Dump files and rules need the configurations one by one
+        const bool checkConcurrently = mSettings.configJobs > 1 && configurations.size() > 1 &&
+                                       !mSettings.preprocessOnly && !mSettings.dump && mSettings.addons.empty() && mSettings.rules.empty();
+        if (checkConcurrently)
+            checkConfigurations(filename, configurations, preprocessor, tokens1, files, checkUnusedFunctions, hasValidConfig, configurationError);
+
         for (const std::string &currCfg : configurations) {
-            // bail out if terminated
-            if (mSettings.terminated())
+            // bail out if terminated or if the configurations are already checked
+            if (mSettings.terminated() || checkConcurrently)
                 break;
 
             // Check only a few configurations (default 12), after that bail out, unless --force
@@ -438,17 +656,7 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
             if (!mSettings.force && ++checkCount > mSettings.maxConfigs)
                 break;
 
-            if (!mSettings.userDefines.empty()) {
-                mCurrentConfig = mSettings.userDefines;
-                const std::vector<std::string> v1(split(mSettings.userDefines, ";"));
-                for (const std::string &cfg: split(currCfg, ";")) {
-                    if (std::find(v1.begin(), v1.end(), cfg) == v1.end()) {
-                        mCurrentConfig += ";" + cfg;
-                    }
-                }
-            } else {
-                mCurrentConfig = currCfg;
-            }
+            mCurrentConfig = getCurrentConfig(mSettings.userDefines, currCfg);
 
             if (mSettings.preprocessOnly) {
                 Timer t("Preprocessor::getcode", mSettings.showtime, &S_timerResults);
@@ -558,27 +766,7 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
                 continue;
 
             } catch (const InternalError &e) {
-                std::list<ErrorLogger::ErrorMessage::FileLocation> locationList;
-                ErrorLogger::ErrorMessage::FileLocation loc;
-                if (e.token) {
-                    loc.line = e.token->linenr();
-                    loc.col = e.token->col();
-                    const std::string fixedpath = Path::toNativeSeparators(mTokenizer.list.file(e.token));
-                    loc.setfile(fixedpath);
-                } else {
-                    ErrorLogger::ErrorMessage::FileLocation loc2;
-                    loc2.setfile(Path::toNativeSeparators(filename));
-                    locationList.push_back(loc2);
-                    loc.setfile(mTokenizer.list.getSourceFilePath());
-                }
-                locationList.push_back(loc);
-                ErrorLogger::ErrorMessage errmsg(locationList,
-                                                 mTokenizer.list.getSourceFilePath(),
-                                                 Severity::error,
-                                                 e.errorMessage,
-                                                 e.id,
-                                                 false);
-
+                const ErrorLogger::ErrorMessage errmsg = internalErrorMessage(e, mTokenizer, filename);
                 if (errmsg._severity == Severity::error || mSettings.isEnabled(errmsg._severity))
                     reportErr(errmsg);
             }
@@ -680,6 +868,192 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
     return mExitCode;
 }
 
+void CppCheck::checkConfigurations(const std::string &filename, const std::set<std::string> &configurations, Preprocessor &preprocessor, const simplecpp::TokenList &tokens1, std::vector<std::string> &files, CheckUnusedFunctions &checkUnusedFunctions, bool &hasValidConfig, std::list<std::string> &configurationError)
+{
+    // A configuration is checked in stages. Decisions that depend on the
+    // previous configurations (--max-configs, purging of configurations
+    // with the same simplified tokens, reporting) wait until all the
+    // previous configurations have reached the stage. Configurations are
+    // taken in order so there is no deadlock.
+    const std::vector<std::string> configs(configurations.begin(), configurations.end());
+    std::vector<ConfigurationResult> results(configs.size());
+    std::mutex sync;
+    std::condition_variable stageChanged;
+    std::size_t nextConfig = 0;
+    bool stop = false;
+    std::exception_ptr error;
+
+    // simplecpp may load headers and add file names while preprocessing
+    std::mutex preprocessSync;
+
+    const auto setStage = [&](ConfigurationResult &result, ConfigurationResult::Stage stage) {
+        {
+            std::lock_guard<std::mutex> lock(sync);
+            if (result.stage < stage)
+                result.stage = stage;
+        }
+        stageChanged.notify_all();
+    };
+
+    const auto waitForPrevious = [&](std::size_t cfgIndex, ConfigurationResult::Stage stage) {
+        std::unique_lock<std::mutex> lock(sync);
+        stageChanged.wait(lock, [&]() {
+            for (std::size_t i = 0; i < cfgIndex; ++i) {
+                if (results[i].stage < stage)
+                    return false;
+            }
+            return true;
+        });
+    };
+
+    const auto checkConfiguration = [&](std::size_t cfgIndex, Tokenizer &tokenizer) {
+        ConfigurationResult &result = results[cfgIndex];
+        const std::string currentConfig = getCurrentConfig(mSettings.userDefines, configs[cfgIndex]);
+
+        bool empty;
+        try {
+            std::lock_guard<std::mutex> lock(preprocessSync);
+            Timer timer("Tokenizer::createTokens", mSettings.showtime, &S_timerResults);
+            preprocessor.setErrorLogger(&result);
+            const simplecpp::TokenList tokensP = preprocessor.preprocess(tokens1, currentConfig, files, true);
+            tokenizer.createTokens(&tokensP);
+            empty = tokensP.empty();
+        } catch (const simplecpp::Output &o) {
+            // #error etc during preprocessing
+            result.configurationError = (currentConfig.empty() ? "\'\'" : currentConfig) + " : [" + o.location.file() + ':' + MathLib::toString(o.location.line) + "] " + o.msg;
+            return;
+        }
+        result.valid = true;
+        setStage(result, ConfigurationResult::PREPROCESSED);
+
+        // Check only a few configurations (default 12), after that bail out, unless --force
+        // was used. Invalid configurations are not counted.
+        waitForPrevious(cfgIndex, ConfigurationResult::PREPROCESSED);
+        unsigned int checkCount = 1;
+        for (std::size_t i = 0; i < cfgIndex; ++i) {
+            if (results[i].valid)
+                ++checkCount;
+        }
+        if (!mSettings.force && checkCount > mSettings.maxConfigs) {
+            result.skipped = true;
+            result.messages.clear();
+            std::lock_guard<std::mutex> lock(sync);
+            stop = true;
+            return;
+        }
+
+        // If only errors are printed, print filename after the check
+        if (!mSettings.quiet && (!currentConfig.empty() || checkCount > 1)) {
+            std::string fixedpath = Path::simplifyPath(filename);
+            fixedpath = Path::toNativeSeparators(fixedpath);
+            result.reportOut("Checking " + fixedpath + ": " + currentConfig + "...");
+        }
+
+        if (empty)
+            return;
+
+        // Simplify tokens into normal form, skip rest if failed
+        Timer timer2("Tokenizer::simplifyTokens1", mSettings.showtime, &S_timerResults);
+        const bool simplified = tokenizer.simplifyTokens1(currentConfig);
+        timer2.Stop();
+        if (!simplified)
+            return;
+
+        // Skip if a previous configuration has the same simplified token list
+        if (mSettings.force || mSettings.maxConfigs > 1) {
+            result.checksum = tokenizer.list.calculateChecksum();
+            result.hasChecksum = true;
+            setStage(result, ConfigurationResult::SIMPLIFIED);
+            waitForPrevious(cfgIndex, ConfigurationResult::SIMPLIFIED);
+            for (std::size_t i = 0; i < cfgIndex; ++i) {
+                if (results[i].hasChecksum && results[i].checksum == result.checksum) {
+                    result.purged = true;
+                    return;
+                }
+            }
+        }
+
+        runChecks(tokenizer, result);
+        result.checked = true;
+    };
+
+    const auto worker = [&]() {
+        for (;;) {
+            std::size_t cfgIndex;
+            {
+                std::lock_guard<std::mutex> lock(sync);
+                if (stop || nextConfig >= configs.size() || mSettings.terminated())
+                    return;
+                cfgIndex = nextConfig++;
+            }
+
+            ConfigurationResult &result = results[cfgIndex];
+            Tokenizer tokenizer(&mSettings, &result);
+            if (mSettings.showtime != SHOWTIME_NONE)
+                tokenizer.setTimerResults(&S_timerResults);
+
+            try {
+                checkConfiguration(cfgIndex, tokenizer);
+            } catch (const InternalError &e) {
+                const ErrorLogger::ErrorMessage errmsg = internalErrorMessage(e, tokenizer, filename);
+                if (errmsg._severity == Severity::error || mSettings.isEnabled(errmsg._severity))
+                    result.reportErr(errmsg);
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+            setStage(result, ConfigurationResult::SIMPLIFIED);
+
+            // Report in configuration order, whole program analysis info also depends on the order
+            waitForPrevious(cfgIndex, ConfigurationResult::DONE);
+            if (!error) {
+                if (result.error) {
+                    std::lock_guard<std::mutex> lock(sync);
+                    error = result.error;
+                    stop = true;
+                } else {
+                    if (result.valid && !result.skipped)
+                        hasValidConfig = true;
+                    else if (!result.configurationError.empty())
+                        configurationError.push_back(result.configurationError);
+
+                    for (const ConfigurationResult::Message &message : result.messages) {
+                        if (message.type == ConfigurationResult::Message::OUT)
+                            reportOut(message.outmsg);
+                        else if (message.type == ConfigurationResult::Message::ERR)
+                            reportErr(message.msg);
+                        else
+                            reportInfo(message.msg);
+                    }
+                    result.messages.clear();
+
+                    if (result.purged && mSettings.debugwarnings)
+                        purgedConfigurationMessage(filename, getCurrentConfig(mSettings.userDefines, configs[cfgIndex]));
+
+                    if (result.checked) {
+                        getFileInfo(tokenizer);
+                        if (!mSettings.buildDir.empty())
+                            checkUnusedFunctions.parseTokens(tokenizer, filename.c_str(), &mSettings);
+                    }
+                }
+            }
+            setStage(result, ConfigurationResult::DONE);
+        }
+    };
+
+    const std::size_t jobs = std::min<std::size_t>(mSettings.configJobs, configs.size());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < jobs; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread &t : threads)
+        t.join();
+
+    preprocessor.setErrorLogger(this);
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
 void CppCheck::internalError(const std::string &filename, const std::string &msg)
 {
     const std::string fixedpath = Path::toNativeSeparators(filename);
@@ -718,21 +1092,59 @@ void CppCheck::checkRawTokens(const Tokenizer &tokenizer)
 
 void CppCheck::checkNormalTokens(const Tokenizer &tokenizer)
 {
+    runChecks(tokenizer, *this);
+
+    // Analyse the tokens..
+    getFileInfo(tokenizer);
+
+    executeRules("normal", tokenizer);
+}
+
+void CppCheck::runChecks(const Tokenizer &tokenizer, ErrorLogger &errorLogger)
+{
+    // Checks that subscribe to tokens are run together in one walk over the tokens
+    TokenDispatcher dispatcher;
+
+    // The messages of the checks from the first subscribed check on are
+    // kept until the tokens are walked, so they are reported in the order
+    // of the checks.
+    std::list<DelayedErrorLogger> delayed;
+
     // call all "runChecks" in all registered Check classes
     for (Check *check : Check::instances()) {
         std::cout << check->name() << std::endl;
         if (mSettings.terminated())
-            return;
+            break;
 
         if (tokenizer.isMaxTime())
-            return;
+            break;
+
+        // Skip checks that can't report anything with the enabled severities
+        if (!check->canReport(&mSettings))
+            continue;
 
         Timer timerRunChecks(check->name() + "::runChecks", mSettings.showtime, &S_timerResults);
-        check->runChecks(&tokenizer, &mSettings, this);         // ++++ 这里面执行检查, 重载函数
+        delayed.emplace_back(errorLogger);
+        if (check->subscribe(dispatcher, &tokenizer, &mSettings, &delayed.back()))
+            continue;
+        if (delayed.size() == 1U) {
+            delayed.pop_back();
+            check->runChecks(&tokenizer, &mSettings, &errorLogger);         // ++++ 这里面执行检查, 重载函数
+        } else
+            check->runChecks(&tokenizer, &mSettings, &delayed.back());
     }
 
-    // Analyse the tokens..
+    if (!mSettings.terminated() && !tokenizer.isMaxTime()) {
+        Timer timerDispatch("TokenDispatcher::dispatch", mSettings.showtime, &S_timerResults);
+        dispatcher.dispatch(&tokenizer);
+    }
+
+    for (DelayedErrorLogger &logger : delayed)
+        logger.flush();
+}
 
+void CppCheck::getFileInfo(const Tokenizer &tokenizer)
+{
     CTU::FileInfo *fi1 = CTU::getFileInfo(&tokenizer);
     if (fi1) {
         mFileInfo.push_back(fi1);
@@ -746,8 +1158,6 @@ void CppCheck::checkNormalTokens(const Tokenizer &tokenizer)
             mAnalyzerInformation.setFileInfo(check->name(), fi->toString());
         }
     }
-
-    executeRules("normal", tokenizer);
 }
 
 //---------------------------------------------------------------------------
@@ -32,9 +32,16 @@
 #include <istream>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
+class CheckUnusedFunctions;
+class Preprocessor;
 class Tokenizer;
+namespace simplecpp {
+    class TokenList;
+}
 
 /// @addtogroup Core
 /// @{
@@ -156,9 +163,27 @@ private:
      * @param filename file name
      * @param cfgname  cfg name
      * @param fileStream stream the file content can be read from
+     * @param fileOnDisk the stream reads the file, so the dependencies in the build dir can be compared with the file
      * @return number of errors found
      */
-    unsigned int checkFile(const std::string& filename, const std::string &cfgname, std::istream& fileStream);
+    unsigned int checkFile(const std::string& filename, const std::string &cfgname, std::istream& fileStream, bool fileOnDisk);
+
+    /**
+     * @brief Check the configurations of a file on worker threads (--config-jobs)
+     *
+     * What is reported for a configuration is held back until all the
+     * configurations before it are done, so the result is the same as
+     * when they are checked one by one.
+     * @param filename file name
+     * @param configurations configurations to check
+     * @param preprocessor preprocessor with the loaded headers
+     * @param tokens1 raw tokens of the file
+     * @param files file names of the raw tokens
+     * @param checkUnusedFunctions collects analyzer info when there is a build dir
+     * @param hasValidConfig set to true if some configuration could be checked
+     * @param configurationError preprocessor errors of invalid configurations
+     */
+    void checkConfigurations(const std::string &filename, const std::set<std::string> &configurations, Preprocessor &preprocessor, const simplecpp::TokenList &tokens1, std::vector<std::string> &files, CheckUnusedFunctions &checkUnusedFunctions, bool &hasValidConfig, std::list<std::string> &configurationError);
 
     /**
      * @brief Check raw tokens
@@ -172,6 +197,19 @@ private:
      */
     void checkNormalTokens(const Tokenizer &tokenizer);
 
+    /**
+     * @brief Run all registered checks on normal tokens
+     * @param tokenizer tokenizer instance
+     * @param errorLogger the checks report their errors here
+     */
+    void runChecks(const Tokenizer &tokenizer, ErrorLogger &errorLogger);
+
+    /**
+     * @brief Get whole program analysis info from normal tokens
+     * @param tokenizer tokenizer instance
+     */
+    void getFileInfo(const Tokenizer &tokenizer);
+
     /**
      * @brief Execute rules, if any
      * @param tokenlist token list to use (normal / simple)
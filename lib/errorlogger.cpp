@@ -204,6 +204,13 @@ void ErrorLogger::ErrorMessage::setmsg(const std::string &msg)
     }
 }
 
+void ErrorLogger::ErrorMessage::setmsg(const std::string &shortMessage, const std::string &verboseMessage, const std::string &symbolNames)
+{
+    mShortMessage = shortMessage;
+    mVerboseMessage = verboseMessage;
+    mSymbolNames = symbolNames;
+}
+
 Suppressions::ErrorMessage ErrorLogger::ErrorMessage::toSuppressionsErrorMessage() const
 {
     Suppressions::ErrorMessage ret;
@@ -284,6 +284,9 @@ public:
         /** set short and verbose messages */
         void setmsg(const std::string &msg);
 
+        /** set short and verbose messages and symbol names as they are, without $symbol replacement */
+        void setmsg(const std::string &shortMessage, const std::string &verboseMessage, const std::string &symbolNames);
+
         /** Short message (single line short message) */
         const std::string &shortMessage() const {
             return mShortMessage;
@@ -32,6 +32,7 @@ HEADERS += $${PWD}/check.h \
            $${PWD}/checkunusedfunctions.h \
            $${PWD}/checkunusedvar.h \
            $${PWD}/checkvaarg.h \
+           $${PWD}/chunkedvector.h \
            $${PWD}/cppcheck.h \
            $${PWD}/ctu.h \
            $${PWD}/errorlogger.h \
@@ -48,6 +49,7 @@ HEADERS += $${PWD}/check.h \
            $${PWD}/templatesimplifier.h \
            $${PWD}/timer.h \
            $${PWD}/token.h \
+           $${PWD}/tokencache.h \
            $${PWD}/tokenize.h \
            $${PWD}/tokenlist.h \
            $${PWD}/valueflow.h \
@@ -97,6 +99,7 @@ SOURCES += $${PWD}/analyzerinfo.cpp \
            $${PWD}/templatesimplifier.cpp \
            $${PWD}/timer.cpp \
            $${PWD}/token.cpp \
+           $${PWD}/tokencache.cpp \
            $${PWD}/tokenize.cpp \
            $${PWD}/tokenlist.cpp \
            $${PWD}/valueflow.cpp
@@ -22,13 +22,18 @@
 //---------------------------------------------------------------------------
 
 #include "config.h"
+#include "tokencache.h"
 
 #include <simplecpp.h>
+#include <cstddef>
 #include <istream>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 class ErrorLogger;
@@ -61,6 +66,46 @@ public:
 /// @addtogroup Core
 /// @{
 
+/**
+ * @brief Tokens of the header files, shared by all translation units that are
+ * checked in this process. A header is tokenized again if its modification
+ * time or size has changed. When the cached headers are larger than the
+ * limit, the least recently used headers are removed.
+ */
+class CPPCHECKLIB HeaderCache {
+public:
+    /** Default limit. The tokens take many times the memory of the header source. */
+    enum { DEFAULT_MAX_BYTES = 16 * 1024 * 1024 };
+
+    /** @param maxBytes limit for the summed source size of the cached headers */
+    explicit HeaderCache(std::size_t maxBytes = DEFAULT_MAX_BYTES);
+
+    /**
+     * Load tokens of header
+     * @param stamps if not null, the stamp of the header as it was read is added
+     */
+    simplecpp::TokenList *load(std::istream &istr, std::vector<std::string> &filenames, const std::string &filename, simplecpp::OutputList *outputList, const std::string &buildDir, std::map<std::string, TokenCache::FileStamp> *stamps = nullptr);
+
+    /** Number of cached headers */
+    std::size_t size() const;
+
+    /** Summed source size of the cached headers */
+    std::size_t bytes() const;
+
+private:
+    struct Entry;
+    typedef std::list<std::string> Recent;
+
+    void insert(const std::string &filename, const std::shared_ptr<const Entry> &entry);
+
+    const std::size_t mMaxBytes;
+    std::size_t mBytes;
+    mutable std::mutex mSync;
+    /** Cached headers, the most recently used first */
+    Recent mRecent;
+    std::map<std::string, std::pair<std::shared_ptr<const Entry>, Recent::iterator> > mEntries;
+};
+
 /**
  * @brief The cppcheck preprocessor.
  * The preprocessor has special functionality for extracting the various ifdef
@@ -100,10 +145,20 @@ public:
 
     void loadFiles(const simplecpp::TokenList &rawtokens, std::vector<std::string> &files);
 
+    /** Modification time, size and content hash of the headers loaded by loadFiles(), as they were read */
+    const std::map<std::string, TokenCache::FileStamp> &getFileStamps() const {
+        return mFileStamps;
+    }
+
     void removeComments();
 
     void setPlatformInfo(simplecpp::TokenList *tokens) const;
 
+    /** Set where errors are reported */
+    void setErrorLogger(ErrorLogger *errorLogger) {
+        mErrorLogger = errorLogger;
+    }
+
     /**
      * Extract the code for each configuration
      * @param istr The (file/string) stream to read from.
@@ -164,13 +219,13 @@ public:
     void validateCfgError(const std::string &file, const unsigned int line, const std::string &cfg, const std::string &macro);
 
     /**
-     * Calculate CRC32 checksum. Using toolinfo, tokens1, filedata.
+     * Calculate 64-bit FNV-1a checksum. Using toolinfo, tokens1, filedata.
      *
      * @param tokens1    Sourcefile tokens
      * @param toolinfo   Arbitrary extra toolinfo
-     * @return CRC32 checksum
+     * @return checksum
      */
-    unsigned int calculateChecksum(const simplecpp::TokenList &tokens1, const std::string &toolinfo) const;
+    unsigned long long calculateChecksum(const simplecpp::TokenList &tokens1, const std::string &toolinfo) const;
 
     void simplifyPragmaAsm(simplecpp::TokenList *tokenList);
 
@@ -214,6 +269,8 @@ private:
 
     std::map<std::string, simplecpp::TokenList *> mTokenLists;
 
+    std::map<std::string, TokenCache::FileStamp> mFileStamps;
+
     /** filename for cpp/c file - useful when reporting errors */
     std::string mFile0;
 };
@@ -24,17 +24,22 @@ bool Settings::mTerminated;
 
 Settings::Settings()
     : mEnabled(0),
+      analysis(MOVED_VALUES),
       checkConfiguration(false),
       checkLibrary(false),
       checkHeaders(true),
       checkUnusedTemplates(false),
+      configJobs(1),
       debugSimplified(false),
       debugnormal(false),
       debugwarnings(false),
       debugtemplate(false),
+      distributedRole(DISTRIBUTED_NONE),
+      distributedTimeout(30),
       dump(false),
       enforcedLang(None),
       exceptionHandling(false),
+      executor(EXECUTOR_PROCESS),
       exitCode(0),
       experimental(false),
       force(false),
@@ -51,6 +56,8 @@ Settings::Settings()
       reportProgress(false),
       showtime(SHOWTIME_NONE),
       verbose(false),
+      valueFlowMaxTime(10),
+      valueFlowJobs(1),
       xml(false),
       xml_version(2)
 {
@@ -60,6 +60,12 @@ public:
         INTERNAL = 0x80
     };
 
+    /** @brief Optional analysis results that are computed before the checks run */
+    enum Analysis {
+        /** Values of moved and forwarded variables */
+        MOVED_VALUES = 0x1
+    };
+
 private:
     /** @brief enable extra checks by id */
     int mEnabled;
@@ -72,6 +78,10 @@ public:
 
     std::list<std::string> addons;
 
+    /** @brief Optional analysis results to compute, Analysis flags. CppCheck
+        only keeps the results that the checks that run read. Default is all. */
+    int analysis;
+
     /** @brief Paths used as base for conversion to relative paths. */
     std::vector<std::string> basePaths;
 
@@ -95,6 +105,10 @@ public:
     /** @brief include paths excluded from checking the configuration */
     std::set<std::string> configExcludePaths;
 
+    /** @brief How many preprocessor configurations of a file are checked
+        at the same time. Default is 1. (--config-jobs=N) */
+    unsigned int configJobs;
+
     /** @brief Is --debug-simplified given? */
     bool debugSimplified;
 
@@ -107,6 +121,22 @@ public:
     /** @brief Is --debug-template given? */
     bool debugtemplate;
 
+    enum DistributedRole {
+        DISTRIBUTED_NONE, DISTRIBUTED_COORDINATOR, DISTRIBUTED_WORKER
+    };
+
+    /** @brief Role in distributed analysis (--coordinator, --worker) */
+    DistributedRole distributedRole;
+
+    /** @brief Address of the coordinator, given with --coordinator or --worker */
+    std::string distributedAddress;
+
+    /** @brief Seconds that a busy worker may be silent before its file is given to another worker (--distributed-timeout) */
+    unsigned int distributedTimeout;
+
+    /** @brief Shared secret of the coordinator and its workers, read from the file given with --distributed-token-file */
+    std::string distributedToken;
+
     /** @brief Is --dump given? */
     bool dump;
     std::string dumpFile;
@@ -121,6 +151,15 @@ public:
     /** @brief Is --exception-handling given */
     bool exceptionHandling;
 
+    enum ExecutorType {
+        EXECUTOR_THREAD, EXECUTOR_PROCESS
+    };
+
+    /** @brief How -j jobs are executed, in-process worker threads or forked
+        child processes (--executor=thread|process). Default is processes,
+        a crash in one file does not stop the checking of the other files. */
+    ExecutorType executor;
+
     // argv[0]
     std::string exename;
 
@@ -247,6 +286,13 @@ public:
     /** @brief Is --verbose given? */
     bool verbose;
 
+    /** @brief Maximum number of seconds that ValueFlow analysis repeats its passes, 0 => no limit. Default is 10. (--valueflow-max-time=N) */
+    unsigned int valueFlowMaxTime;
+
+    /** @brief How many function scopes are analysed by the ValueFlow passes
+        at the same time. Default is 1. (--valueflow-jobs=N) */
+    unsigned int valueFlowJobs;
+
     /** @brief write XML results (--xml) */
     bool xml;
 
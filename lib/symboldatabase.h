@@ -21,6 +21,7 @@
 #define symboldatabaseH
 //---------------------------------------------------------------------------
 
+#include "chunkedvector.h"
 #include "config.h"
 #include "library.h"
 #include "mathlib.h"
@@ -32,6 +33,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -841,7 +843,7 @@ public:
     const ::Type *retType;            ///< function return type
     const Scope *functionScope;       ///< scope of function body
     const Scope* nestedIn;            ///< Scope the function is declared in
-    std::list<Variable> argumentList; ///< argument list
+    ChunkedVector<Variable> argumentList; ///< argument list
     unsigned int initArgCount;        ///< number of args with default values
     Type type;                        ///< constructor, destructor, ...
     AccessControl access;             ///< public/protected/private
@@ -951,11 +953,15 @@ public:
     const Token *classDef;   ///< class/struct/union/namespace token
     const Token *bodyStart;  ///< '{' token
     const Token *bodyEnd;    ///< '}' token
-    std::list<Function> functionList;
+    ChunkedVector<Function> functionList;
     std::multimap<std::string, const Function *> functionMap;
-    std::list<Variable> varlist;
+    ChunkedVector<Variable> varlist;
     const Scope *nestedIn;
-    std::list<Scope *> nestedList;
+    std::vector<Scope *> nestedList;
+    /** nestedList by className, in the same order */
+    std::unordered_map<std::string, std::vector<Scope *>> nestedMap;
+    /** First enumerator of each name in the enums of nestedList */
+    std::unordered_map<std::string, const Enumerator *> nestedEnumeratorMap;
     unsigned int numConstructors;
     unsigned int numCopyOrMoveConstructors;
     std::list<UsingInfo> usingList;
@@ -972,13 +978,18 @@ public:
     bool enumClass;
 
     std::vector<Enumerator> enumeratorList;
+    /** First enumerator of each name in enumeratorList */
+    std::unordered_map<std::string, const Enumerator *> enumeratorMap;
 
     const Enumerator * findEnumerator(const std::string & name) const {
-        for (std::size_t i = 0, end = enumeratorList.size(); i < end; ++i) {
-            if (enumeratorList[i].name->str() == name)
-                return &enumeratorList[i];
-        }
-        return nullptr;
+        const std::unordered_map<std::string, const Enumerator *>::const_iterator it = enumeratorMap.find(name);
+        return it == enumeratorMap.end() ? nullptr : it->second;
+    }
+
+    /** Enumerator of an enum in nestedList */
+    const Enumerator * findNestedEnumerator(const std::string & name) const {
+        const std::unordered_map<std::string, const Enumerator *>::const_iterator it = nestedEnumeratorMap.find(name);
+        return it == nestedEnumeratorMap.end() ? nullptr : it->second;
     }
 
     bool isNestedIn(const Scope * outer) const {
@@ -1067,6 +1078,13 @@ public:
         functionMap.insert(make_pair(back->tokenDef->str(), back));
     }
 
+    void addNestedScope(Scope *scope) {
+        nestedList.push_back(scope);
+        nestedMap[scope->className].push_back(scope);
+        for (const Enumerator &enumerator : scope->enumeratorList)
+            nestedEnumeratorMap.emplace(enumerator.name->str(), &enumerator);
+    }
+
     bool hasDefaultConstructor() const;
 
     AccessControl defaultAccess() const;
@@ -1155,7 +1173,7 @@ public:
     ~SymbolDatabase();
 
     /** @brief Information about all namespaces/classes/structrues */
-    std::list<Scope> scopeList;
+    ChunkedVector<Scope> scopeList;
 
     /** @brief Fast access to function scopes */
     std::vector<const Scope *> functionScopes;
@@ -1164,7 +1182,7 @@ public:
     std::vector<const Scope *> classAndStructScopes;
 
     /** @brief Fast access to types */
-    std::list<Type> typeList;
+    ChunkedVector<Type> typeList;
 
     /**
      * @brief find a variable type if it's a user defined type
@@ -1288,7 +1306,10 @@ private:
     std::vector<const Variable *> mVariableList;
 
     /** list for missing types */
-    std::list<Type> mBlankTypes;
+    ChunkedVector<Type> mBlankTypes;
+
+    /** First scope of each name in scopeList */
+    std::unordered_map<std::string, const Scope *> mScopeByName;
 
     bool mIsCpp;
     ValueType::Sign mDefaultSignedness;
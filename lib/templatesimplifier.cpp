@@ -28,8 +28,10 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <stack>
+#include <unordered_map>
 #include <utility>
 
 namespace {
@@ -43,25 +45,6 @@ namespace {
         const Token * const mToken;
     };
 
-    class FindName {
-    public:
-        explicit FindName(const std::string &name) : mName(name) {}
-        bool operator()(const TemplateSimplifier::TokenAndName &tokenAndName) const {
-            return tokenAndName.name == mName;
-        }
-    private:
-        const std::string mName;
-    };
-
-    class FindFullName {
-    public:
-        explicit FindFullName(const std::string &fullName) : mFullName(fullName) {}
-        bool operator()(const TemplateSimplifier::TokenAndName &tokenAndName) const {
-            return tokenAndName.fullName == mFullName;
-        }
-    private:
-        const std::string mFullName;
-    };
 }
 
 TemplateSimplifier::TokenAndName::TokenAndName(Token *tok, const std::string &s) :
@@ -762,7 +745,7 @@ bool TemplateSimplifier::getTemplateDeclarations()
                         mTemplateForwardDeclarations.emplace_back(decl);
                     } else {
                         // Implementation => add to mTemplateDeclarations
-                        mTemplateDeclarations.emplace_back(decl);
+                        addDeclaration(decl);
                     }
                     break;
                 }
@@ -777,6 +760,36 @@ void TemplateSimplifier::addInstantiation(Token *token, const std::string &scope
     simplifyTemplateArgs(token->tokAt(2), token->next()->findClosingBracket());
 
     mTemplateInstantiations.emplace_back(token, scope);
+    mTemplateInstantiationsByName[mTemplateInstantiations.back().name].push_back(std::prev(mTemplateInstantiations.end()));
+}
+
+void TemplateSimplifier::addDeclaration(const TokenAndName &declaration)
+{
+    mTemplateDeclarations.emplace_back(declaration);
+    mTemplateDeclarationsByFullName[declaration.fullName].push_back(std::prev(mTemplateDeclarations.end()));
+}
+
+std::list<TemplateSimplifier::TokenAndName>::iterator TemplateSimplifier::eraseInstantiation(std::list<TokenAndName>::iterator it)
+{
+    // keep the (possibly empty) entry, simplifyTemplateInstantiations() may be iterating it
+    std::list<std::list<TokenAndName>::iterator> &instantiations = mTemplateInstantiationsByName[it->name];
+    instantiations.erase(std::find(instantiations.begin(), instantiations.end(), it));
+    return mTemplateInstantiations.erase(it);
+}
+
+std::list<TemplateSimplifier::TokenAndName>::iterator TemplateSimplifier::eraseDeclaration(std::list<TokenAndName>::iterator it)
+{
+    std::vector<std::list<TokenAndName>::iterator> &declarations = mTemplateDeclarationsByFullName[it->fullName];
+    declarations.erase(std::find(declarations.begin(), declarations.end(), it));
+    return mTemplateDeclarations.erase(it);
+}
+
+std::list<TemplateSimplifier::TokenAndName>::iterator TemplateSimplifier::findDeclaration(const std::string &fullName)
+{
+    const std::unordered_map<std::string, std::vector<std::list<TokenAndName>::iterator>>::const_iterator it = mTemplateDeclarationsByFullName.find(fullName);
+    if (it == mTemplateDeclarationsByFullName.end() || it->second.empty())
+        return mTemplateDeclarations.end();
+    return it->second.front();
 }
 
 void TemplateSimplifier::getTemplateInstantiations()
@@ -962,7 +975,7 @@ void TemplateSimplifier::getTemplateInstantiations()
                 while (true) {
                     const std::string fullName = scopeName + (scopeName.empty()?"":" :: ") +
                                                  qualification + (qualification.empty()?"":" :: ") + tok->str();
-                    const std::list<TokenAndName>::const_iterator it = std::find_if(mTemplateDeclarations.begin(), mTemplateDeclarations.end(), FindFullName(fullName));
+                    const std::list<TokenAndName>::const_iterator it = findDeclaration(fullName);
                     if (it != mTemplateDeclarations.end()) {
                         // full name matches
                         addInstantiation(tok, it->scope);
@@ -974,7 +987,7 @@ void TemplateSimplifier::getTemplateInstantiations()
                             std::string fullNameSpace = scopeName + (scopeName.empty()?"":" :: ") +
                                                         nameSpace + (qualification.empty()?"":" :: ") + qualification;
                             std::string newFullName = fullNameSpace + " :: " + tok->str();
-                            const std::list<TokenAndName>::const_iterator it1 = std::find_if(mTemplateDeclarations.begin(), mTemplateDeclarations.end(), FindFullName(newFullName));
+                            const std::list<TokenAndName>::const_iterator it1 = findDeclaration(newFullName);
                             if (it1 != mTemplateDeclarations.end()) {
                                 // insert using namespace into token stream
                                 std::string::size_type offset = 0;
@@ -1186,7 +1199,7 @@ void TemplateSimplifier::useDefaultArgumentValues(TokenAndName &declaration)
                                                        mTemplateInstantiations.end(),
                                                        FindToken(tok2));
                 if (ti != mTemplateInstantiations.end())
-                    mTemplateInstantiations.erase(ti);
+                    eraseInstantiation(ti);
                 ++indentlevel;
             } else if (indentlevel > 0 && tok2->str() == ">")
                 --indentlevel;
@@ -1201,11 +1214,7 @@ void TemplateSimplifier::useDefaultArgumentValues(TokenAndName &declaration)
             continue;
 
         // don't strip args from uninstantiated templates
-        std::list<TokenAndName>::iterator ti2 = std::find_if(mTemplateInstantiations.begin(),
-                                                mTemplateInstantiations.end(),
-                                                FindName(declaration.name));
-
-        if (ti2 == mTemplateInstantiations.end())
+        if (mTemplateInstantiationsByName[declaration.name].empty())
             continue;
 
         eraseTokens(eqtok, tok2);
@@ -1235,8 +1244,9 @@ void TemplateSimplifier::simplifyTemplateAliases()
 
         // Look for alias usages..
         bool found = false;
-        for (std::list<TokenAndName>::iterator it2 = mTemplateInstantiations.begin(); it2 != mTemplateInstantiations.end();) {
-            TokenAndName &aliasUsage = *it2;
+        std::list<std::list<TokenAndName>::iterator> &aliasUsages = mTemplateInstantiationsByName[aliasDeclaration.name];
+        for (std::list<std::list<TokenAndName>::iterator>::iterator it2 = aliasUsages.begin(); it2 != aliasUsages.end();) {
+            TokenAndName &aliasUsage = **it2;
             if (!aliasUsage.token || aliasUsage.fullName != aliasDeclaration.fullName) {
                 ++it2;
                 continue;
@@ -1313,7 +1323,7 @@ void TemplateSimplifier::simplifyTemplateAliases()
             found = true;
 
             // erase this instantiation
-            it2 = mTemplateInstantiations.erase(it2);
+            eraseInstantiation(*it2++);
         }
 
         if (found) {
@@ -1328,7 +1338,7 @@ void TemplateSimplifier::simplifyTemplateAliases()
             }
 
             // remove declaration
-            it1 = mTemplateDeclarations.erase(it1);
+            it1 = eraseDeclaration(it1);
         } else
             ++it1;
     }
@@ -1538,7 +1548,6 @@ void TemplateSimplifier::expandTemplate(
     const std::string &newName,
     bool copy)
 {
-    std::list<ScopeInfo2> scopeInfo;
     bool inTemplateDefinition = false;
     const Token *startOfTemplateDeclaration = nullptr;
     const Token *endOfTemplateDefinition = nullptr;
@@ -1753,10 +1762,8 @@ void TemplateSimplifier::expandTemplate(
     }
 
     for (Token *tok3 = mTokenList.front(); tok3; tok3 = tok3 ? tok3->next() : nullptr) {
-        if (Token::Match(tok3, "{|}|namespace|class|struct|union")) {
-            setScopeInfo(tok3, &scopeInfo);
+        if (Token::Match(tok3, "{|}|namespace|class|struct|union"))
             continue;
-        }
         if (inTemplateDefinition) {
             if (!endOfTemplateDefinition) {
                 if (isVariable) {
@@ -2762,7 +2769,11 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
 
     bool instantiated = false;
 
-    for (const TokenAndName &instantiation : mTemplateInstantiations) {
+    // only instantiations with the same name can match, see below
+    const std::list<std::list<TokenAndName>::iterator> &instantiations = mTemplateInstantiationsByName[templateDeclaration.name];
+
+    for (const std::list<TokenAndName>::iterator &it : instantiations) {
+        const TokenAndName &instantiation = *it;
         if (numberOfTemplateInstantiations != mTemplateInstantiations.size()) {
             numberOfTemplateInstantiations = mTemplateInstantiations.size();
             ++recursiveCount;
@@ -2936,15 +2947,10 @@ void TemplateSimplifier::replaceTemplateUsage(
     const std::list<std::string> &typeStringsUsedInTemplateInstantiation,
     const std::string &newName)
 {
-    std::list<ScopeInfo2> scopeInfo;
     std::list< std::pair<Token *, Token *> > removeTokens;
     for (Token *nameTok = mTokenList.front(); nameTok; nameTok = nameTok->next()) {
-        if (Token::Match(nameTok, "{|}|namespace|class|struct|union")) {
-            setScopeInfo(nameTok, &scopeInfo);
-            continue;
-        }
         if (!Token::Match(nameTok, "%name% <") ||
-            Token::Match(nameTok, "template|const_cast|dynamic_cast|reinterpret_cast|static_cast"))
+            Token::Match(nameTok, "template|const_cast|dynamic_cast|reinterpret_cast|static_cast|namespace|class|struct|union"))
             continue;
 
         std::set<TemplateSimplifier::TokenAndName*> & pointers = nameTok->templateSimplifierPointers();
@@ -3013,7 +3019,7 @@ void TemplateSimplifier::replaceTemplateUsage(
                     std::list<TokenAndName>::iterator ti;
                     for (ti = mTemplateInstantiations.begin(); ti != mTemplateInstantiations.end();) {
                         if (ti->token == tok) {
-                            mTemplateInstantiations.erase(ti++);
+                            eraseInstantiation(ti);
                             break;
                         } else {
                             ++ti;
@@ -3381,11 +3387,13 @@ void TemplateSimplifier::simplifyTemplates(
 
             mChanged = usingChanged;
             mTemplateDeclarations.clear();
+            mTemplateDeclarationsByFullName.clear();
             mTemplateForwardDeclarations.clear();
             mTemplateForwardDeclarationsMap.clear();
             mTemplateSpecializationMap.clear();
             mTemplatePartialSpecializationMap.clear();
             mTemplateInstantiations.clear();
+            mTemplateInstantiationsByName.clear();
             mInstantiatedTemplates.clear();
             mExplicitInstantiationsToDelete.clear();
             mTemplateNamePos.clear();
@@ -3422,23 +3430,20 @@ void TemplateSimplifier::simplifyTemplates(
 
         std::set<std::string> expandedtemplates;
 
+        // specializations by full name, in declaration order
+        std::unordered_map<std::string, std::list<const Token *>> specializations;
+        for (const TokenAndName &decl : mTemplateDeclarations) {
+            if (!decl.isAlias())
+                specializations[decl.fullName].push_back(decl.nameToken);
+        }
+
         for (std::list<TokenAndName>::reverse_iterator iter1 = mTemplateDeclarations.rbegin(); iter1 != mTemplateDeclarations.rend(); ++iter1) {
             if (iter1->isAlias())
                 continue;
 
-            // get specializations..
-            std::list<const Token *> specializations;
-            for (std::list<TokenAndName>::const_iterator iter2 = mTemplateDeclarations.begin(); iter2 != mTemplateDeclarations.end(); ++iter2) {
-                if (iter2->isAlias())
-                    continue;
-
-                if (iter1->fullName == iter2->fullName)
-                    specializations.push_back(iter2->nameToken);
-            }
-
             const bool instantiated = simplifyTemplateInstantiations(
                                           *iter1,
-                                          specializations,
+                                          specializations[iter1->fullName],
                                           maxtime,
                                           expandedtemplates);
             if (instantiated)
@@ -3464,7 +3469,7 @@ void TemplateSimplifier::simplifyTemplates(
                         removeTemplate(it1->second);
                     removeTemplate(it->token);
                 }
-                mTemplateDeclarations.erase(decl);
+                eraseDeclaration(decl);
             }
         }
 
@@ -3476,7 +3481,7 @@ void TemplateSimplifier::simplifyTemplates(
             // multiple functions can share the same declaration so make sure it hasn't already been deleted
             if (it != mTemplateDeclarations.end()) {
                 removeTemplate(it->token);
-                mTemplateDeclarations.erase(it);
+                eraseDeclaration(it);
             }
             mMemberFunctionsToDelete.erase(mMemberFunctionsToDelete.begin());
         }
@@ -312,6 +312,29 @@ private:
      */
     void addInstantiation(Token *token, const std::string &scope);
 
+    /** Add template declaration.
+     * @param declaration template declaration
+     */
+    void addDeclaration(const TokenAndName &declaration);
+
+    /** Remove template instantiation.
+     * @param it instantiation to remove
+     * @return instantiation following the removed one
+     */
+    std::list<TokenAndName>::iterator eraseInstantiation(std::list<TokenAndName>::iterator it);
+
+    /** Remove template declaration.
+     * @param it declaration to remove
+     * @return declaration following the removed one
+     */
+    std::list<TokenAndName>::iterator eraseDeclaration(std::list<TokenAndName>::iterator it);
+
+    /** Find the first template declaration with the given full name.
+     * @param fullName full name of declaration
+     * @return declaration or end of mTemplateDeclarations
+     */
+    std::list<TokenAndName>::iterator findDeclaration(const std::string &fullName);
+
     /**
      * Get template instantiations
      */
@@ -473,6 +496,10 @@ private:
     std::map<Token *, Token *> mTemplateSpecializationMap;
     std::map<Token *, Token *> mTemplatePartialSpecializationMap;
     std::list<TokenAndName> mTemplateInstantiations;
+    /** mTemplateDeclarations by full name, in list order */
+    std::unordered_map<std::string, std::vector<std::list<TokenAndName>::iterator>> mTemplateDeclarationsByFullName;
+    /** mTemplateInstantiations by name, in list order */
+    std::unordered_map<std::string, std::list<std::list<TokenAndName>::iterator>> mTemplateInstantiationsByName;
     std::list<TokenAndName> mInstantiatedTemplates;
     std::list<TokenAndName> mMemberFunctionsToDelete;
     std::vector<TokenAndName> mExplicitInstantiationsToDelete;
@@ -47,7 +47,11 @@ void TimerResults::ShowResults(SHOWTIME_MODES mode) const
     std::cout << std::endl;
     TimerResultsData overallData;
 
-    std::vector<dataElementType> data(mResults.begin(), mResults.end());
+    std::vector<dataElementType> data;
+    {
+        std::lock_guard<std::mutex> lock(mResultsSync);
+        data.assign(mResults.begin(), mResults.end());
+    }
     std::sort(data.begin(), data.end(), more_second_sec);
 
     size_t ordinal = 1; // maybe it would be nice to have an ordinal in output later!
@@ -67,6 +71,7 @@ void TimerResults::ShowResults(SHOWTIME_MODES mode) const
 
 void TimerResults::AddResults(const std::string& str, std::clock_t clocks)
 {
+    std::lock_guard<std::mutex> lock(mResultsSync);
     mResults[str].mClocks += clocks;
     mResults[str].mNumberOfResults++;
 }
@@ -24,6 +24,7 @@
 
 #include <ctime>
 #include <map>
+#include <mutex>
 #include <string>
 
 enum SHOWTIME_MODES {
@@ -65,6 +66,9 @@ public:
 
 private:
     std::map<std::string, struct TimerResultsData> mResults;
+
+    /** Results are added from several threads with -j and --config-jobs */
+    mutable std::mutex mResultsSync;
 };
 
 class CPPCHECKLIB Timer {
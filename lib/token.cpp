@@ -25,11 +25,15 @@
 #include "symboldatabase.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <bitset>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
 #include <stack>
 #include <utility>
@@ -50,7 +54,113 @@ static bool isStringCharLiteral(const std::string &str, char q)
     }
     return false;
 }
-const std::list<ValueFlow::Value> TokenImpl::mEmptyValueList;
+const ValueFlow::ValueList TokenImpl::mEmptyValueList;
+
+// The header before each object holds its pool. The header size keeps the alignment of the objects.
+static const std::size_t poolHeaderSize = alignof(Token) > alignof(TokenImpl) ? alignof(Token) : alignof(TokenImpl);
+static_assert(poolHeaderSize >= sizeof(void *), "pool header can't hold a pointer");
+
+// Approximate size of the chunks that pools allocate
+static const std::size_t poolChunkSize = 64 * 1024;
+
+TokenArena::Pool::Pool(std::size_t objectSize) :
+    mBlockSize(poolHeaderSize + (objectSize + poolHeaderSize - 1U) / poolHeaderSize * poolHeaderSize),
+    mChunkPos(nullptr),
+    mChunkEnd(nullptr),
+    mFreeList(nullptr),
+    mCount(0)
+{
+}
+
+TokenArena::Pool::~Pool()
+{
+    for (char *chunk : mChunks)
+        ::operator delete(chunk);
+}
+
+void *TokenArena::Pool::allocate(Pool *pool, std::size_t size)
+{
+    void *block;
+    if (!pool) {
+        block = ::operator new(poolHeaderSize + size);
+    } else {
+        assert(poolHeaderSize + size <= pool->mBlockSize);
+        if (pool->mFreeList) {
+            block = pool->mFreeList;
+            pool->mFreeList = *static_cast<void **>(block);
+        } else {
+            if (pool->mChunkPos == pool->mChunkEnd) {
+                const std::size_t blocks = std::max<std::size_t>(poolChunkSize / pool->mBlockSize, 1U);
+                pool->mChunks.reserve(pool->mChunks.size() + 1U);
+                pool->mChunkPos = static_cast<char *>(::operator new(blocks * pool->mBlockSize));
+                pool->mChunkEnd = pool->mChunkPos + blocks * pool->mBlockSize;
+                pool->mChunks.push_back(pool->mChunkPos);
+            }
+            block = pool->mChunkPos;
+            pool->mChunkPos += pool->mBlockSize;
+        }
+        ++pool->mCount;
+    }
+    *static_cast<Pool **>(block) = pool;
+    return static_cast<char *>(block) + poolHeaderSize;
+}
+
+void TokenArena::Pool::deallocate(void *p)
+{
+    if (!p)
+        return;
+    void *block = static_cast<char *>(p) - poolHeaderSize;
+    Pool *pool = *static_cast<Pool **>(block);
+    if (!pool) {
+        ::operator delete(block);
+        return;
+    }
+    *static_cast<void **>(block) = pool->mFreeList;
+    pool->mFreeList = block;
+    --pool->mCount;
+}
+
+void TokenArena::Pool::release()
+{
+    if (mCount > 0)
+        return;
+    for (char *chunk : mChunks)
+        ::operator delete(chunk);
+    mChunks.clear();
+    mChunkPos = mChunkEnd = nullptr;
+    mFreeList = nullptr;
+}
+
+TokenArena::TokenArena() :
+    mTokens(sizeof(Token)),
+    mImpls(sizeof(TokenImpl))
+{
+}
+
+TokenArena::~TokenArena()
+{
+}
+
+void TokenArena::release()
+{
+    mTokens.release();
+    mImpls.release();
+}
+
+void *TokenImpl::operator new(std::size_t size, TokenArena *arena)
+{
+    return TokenArena::Pool::allocate(arena ? &arena->mImpls : nullptr, size);
+}
+
+void TokenImpl::operator delete(void *p, TokenArena *)
+{
+    TokenArena::Pool::deallocate(p);
+}
+
+void TokenImpl::operator delete(void *p)
+{
+    TokenArena::Pool::deallocate(p);
+}
 
 Token::Token(TokensFrontBack *tokensFrontBack) :
     mTokensFrontBack(tokensFrontBack),
@@ -60,14 +170,37 @@ Token::Token(TokensFrontBack *tokensFrontBack) :
     mTokType(eNone),
     mFlags(0)
 {
-    mImpl = new TokenImpl();
+    mImpl = new (tokensFrontBack ? tokensFrontBack->arena : nullptr) TokenImpl();
+    resetDefUseIndex();
 }
 
 Token::~Token()
 {
+    resetDefUseIndex();
     delete mImpl;
 }
 
+void *Token::operator new(std::size_t size)
+{
+    return TokenArena::Pool::allocate(nullptr, size);
+}
+
+void *Token::operator new(std::size_t size, TokensFrontBack *tokensFrontBack)
+{
+    TokenArena *arena = tokensFrontBack ? tokensFrontBack->arena : nullptr;
+    return TokenArena::Pool::allocate(arena ? &arena->mTokens : nullptr, size);
+}
+
+void Token::operator delete(void *p, TokensFrontBack *)
+{
+    TokenArena::Pool::deallocate(p);
+}
+
+void Token::operator delete(void *p)
+{
+    TokenArena::Pool::deallocate(p);
+}
+
 static const std::set<std::string> controlFlowKeywords = {
     "goto",
     "do",
@@ -262,6 +395,7 @@ void Token::deletePrevious(unsigned long index)
 
 void Token::swapWithNext()
 {
+    resetDefUseIndex();
     if (mNext) {
         std::swap(mStr, mNext->mStr);
         std::swap(mTokType, mNext->mTokType);
@@ -321,6 +455,7 @@ void Token::deleteThis()
 
 void Token::replace(Token *replaceThis, Token *start, Token *end)
 {
+    replaceThis->resetDefUseIndex();
     // Fix the whole in the old location of start and end
     if (start->previous())
         start->previous()->next(end->next());
@@ -571,7 +706,7 @@ int Token::multiCompare(const Token *tok, const char *haystack, unsigned int var
     return -1;
 }
 
-bool Token::simpleMatch(const Token *tok, const char pattern[])
+bool Token::simpleMatchRuntime(const Token *tok, const char pattern[])
 {
     if (!tok)
         return false; // shortcut
@@ -626,7 +761,7 @@ const char *Token::chrInFirstWord(const char *str, char c)
     }
 }
 
-bool Token::Match(const Token *tok, const char pattern[], unsigned int varid)
+bool Token::matchRuntime(const Token *tok, const char pattern[], unsigned int varid)
 {
     const char *p = pattern;
     while (*p) {
@@ -713,6 +848,377 @@ bool Token::Match(const Token *tok, const char pattern[], unsigned int varid)
     return true;
 }
 
+namespace {
+    /**
+     * Pattern of Match() that has been parsed. Each word of the
+     * pattern is an element that is matched against one token.
+     */
+    class MatchProgram {
+    public:
+        enum Result { NO_MATCH, MATCH, RUNTIME };
+
+        /**
+         * Parse pattern
+         * @return false if the pattern has syntax that is only handled by Token::matchRuntime()
+         */
+        bool compile(const char pattern[]);
+
+        /**
+         * Match tokens
+         * @return RUNTIME if the result of Token::matchRuntime() can differ for these tokens
+         */
+        Result match(const Token *tok, unsigned int varid) const;
+
+    private:
+        enum Command { LITERAL, ANY, ASSIGN, BOOL, CHAR, COMP, COP, NAME, NUM, OP, OR, OROR, TYPE, STR, VAR, VARID };
+
+        struct Alternative {
+            Command command;
+            std::string str;
+        };
+
+        enum Kind { CHARS, NOT, ALTERNATIVES };
+
+        struct Element {
+            Kind kind;
+            /** "[abc]": allowed characters */
+            std::bitset<256> chars;
+            /** "!!else": the token that is not allowed */
+            std::string str;
+            /** "int|%name%|": alternatives, the empty alternative is removed */
+            std::vector<Alternative> alternatives;
+            /** The word has an empty alternative at the end, so the token is optional */
+            bool optional;
+        };
+
+        std::vector<Element> mElements;
+
+        static bool matchCommand(const Token *tok, Command command, unsigned int varid);
+    };
+
+    /** Pattern of simpleMatch() that has been parsed */
+    class SimpleMatchProgram {
+    public:
+        bool compile(const char pattern[]);
+        bool match(const Token *tok) const;
+
+    private:
+        std::vector<std::string> mWords;
+    };
+
+    /**
+     * Parsed patterns of the current thread, found by the address of the
+     * pattern. The pattern is compared too, a local array or a buffer may
+     * have another pattern at the same address in a later call. The table
+     * grows instead of replacing entries, patterns with the same hash are
+     * both kept.
+     */
+    template<class Program>
+    class PatternCache {
+    public:
+        PatternCache() : mEntries(1024), mCount(0) {
+        }
+
+        /** @return parsed pattern, or nullptr if pattern can't be parsed */
+        const Program *get(const char pattern[], std::size_t size) {
+            Entry *entry = find(pattern);
+            if (!entry->address)
+                add(entry, pattern, size);
+            else if (entry->pattern.size() != size || std::memcmp(entry->pattern.data(), pattern, size) != 0)
+                parse(entry, pattern, size);
+            return entry->program.get();
+        }
+
+    private:
+        struct Entry {
+            Entry() : address(nullptr) {
+            }
+            const char *address;
+            std::string pattern;
+            std::unique_ptr<Program> program;
+        };
+
+        /** The entry of the pattern, or the empty entry where it is added */
+        Entry *find(const char pattern[]) {
+            std::uintptr_t hash = reinterpret_cast<std::uintptr_t>(pattern);
+            hash ^= hash >> 12;
+            const std::size_t mask = mEntries.size() - 1U;
+            for (std::size_t index = hash & mask;; index = (index + 1) & mask) {
+                Entry &entry = mEntries[index];
+                if (entry.address == pattern || !entry.address)
+                    return &entry;
+            }
+        }
+
+        void add(Entry *&entry, const char pattern[], std::size_t size) {
+            if (2 * (mCount + 1) > mEntries.size()) {
+                grow();
+                entry = find(pattern);
+            }
+            ++mCount;
+            entry->address = pattern;
+            parse(entry, pattern, size);
+        }
+
+        static void parse(Entry *entry, const char pattern[], std::size_t size) {
+            entry->pattern.assign(pattern, size);
+            // the pattern is parsed until the first null character
+            entry->program.reset(new Program);
+            if (!entry->program->compile(entry->pattern.c_str()))
+                entry->program.reset();
+        }
+
+        void grow() {
+            std::vector<Entry> entries(2 * mEntries.size());
+            entries.swap(mEntries);
+            for (Entry &entry : entries) {
+                if (entry.address)
+                    *find(entry.address) = std::move(entry);
+            }
+        }
+
+        /** Open addressing with linear probing, the size is a power of two */
+        std::vector<Entry> mEntries;
+        std::size_t mCount;
+    };
+}
+
+bool MatchProgram::compile(const char pattern[])
+{
+    static const struct {
+        const char *name;
+        Command command;
+    } commands[] = {
+        { "%any%", ANY }, { "%assign%", ASSIGN }, { "%bool%", BOOL }, { "%char%", CHAR },
+        { "%comp%", COMP }, { "%cop%", COP }, { "%name%", NAME }, { "%num%", NUM },
+        { "%op%", OP }, { "%or%", OR }, { "%oror%", OROR }, { "%type%", TYPE },
+        { "%str%", STR }, { "%var%", VAR }, { "%varid%", VARID }
+    };
+
+    const char *p = pattern;
+    while (*p) {
+        while (*p == ' ')
+            ++p;
+        if (*p == '\0')
+            break;
+        const char *end = p;
+        while (*end && *end != ' ')
+            ++end;
+        const std::string word(p, end);
+        p = end;
+
+        Element element;
+        element.optional = false;
+        if (word[0] == '[' && word.find(']') != std::string::npos) {
+            element.kind = CHARS;
+            unsigned int count = 0;
+            for (std::string::size_type i = 1; i < word.size(); ++i) {
+                if (word[i] == ']')
+                    ++count;
+                else
+                    element.chars.set(static_cast<unsigned char>(word[i]));
+            }
+            if (count > 1)
+                element.chars.set(static_cast<unsigned char>(']'));
+        } else if (word.compare(0, 2, "!!") == 0) {
+            if (word.size() == 2)
+                return false;
+            element.kind = NOT;
+            element.str = word.substr(2);
+        } else {
+            element.kind = ALTERNATIVES;
+            std::string::size_type pos = 0;
+            for (;;) {
+                const std::string::size_type bar = word.find('|', pos);
+                const std::string alternative = word.substr(pos, bar == std::string::npos ? std::string::npos : bar - pos);
+                if (bar == std::string::npos && alternative.empty()) {
+                    element.optional = true;
+                } else if (alternative.size() > 1 && alternative[0] == '%') {
+                    bool known = false;
+                    for (const auto &command : commands) {
+                        if (alternative == command.name) {
+                            const Alternative a = { command.command, emptyString };
+                            element.alternatives.push_back(a);
+                            known = true;
+                            break;
+                        }
+                    }
+                    if (!known)
+                        return false;
+                } else if (!alternative.empty()) {
+                    // An empty alternative that is not the last one only matches a token with an empty string
+                    const Alternative a = { LITERAL, alternative };
+                    element.alternatives.push_back(a);
+                }
+                if (bar == std::string::npos)
+                    break;
+                pos = bar + 1;
+            }
+        }
+        mElements.push_back(element);
+    }
+    return true;
+}
+
+bool MatchProgram::matchCommand(const Token *tok, Command command, unsigned int varid)
+{
+    switch (command) {
+    case LITERAL:
+        break;
+    case ANY:
+        return true;
+    case ASSIGN:
+        return tok->isAssignmentOp();
+    case BOOL:
+        return tok->isBoolean();
+    case CHAR:
+        return tok->tokType() == Token::eChar;
+    case COMP:
+        return tok->isComparisonOp();
+    case COP:
+        return tok->isConstOp();
+    case NAME:
+        return tok->isName();
+    case NUM:
+        return tok->isNumber();
+    case OP:
+        return tok->isOp();
+    case OR:
+        return tok->tokType() == Token::eBitOp && tok->str() == "|";
+    case OROR:
+        return tok->tokType() == Token::eLogicalOp && tok->str() == "||";
+    case TYPE:
+        return tok->isName() && tok->varId() == 0 && !tok->isKeyword();
+    case STR:
+        return tok->tokType() == Token::eString;
+    case VAR:
+        return tok->varId() != 0;
+    case VARID:
+        if (varid == 0)
+            throw InternalError(tok, "Internal error. Token::Match called with varid 0. Please report this to Cppcheck developers");
+        return tok->varId() == varid;
+    }
+    return false;
+}
+
+/** Is str a prefix of the token followed by a space. Token::matchRuntime() then continues comparing with the next word of the pattern */
+static bool isWordPrefix(const std::string &str, const std::string &tokStr)
+{
+    return tokStr.size() > str.size() && tokStr[str.size()] == ' ' && tokStr.compare(0, str.size(), str) == 0;
+}
+
+MatchProgram::Result MatchProgram::match(const Token *tok, unsigned int varid) const
+{
+    for (const Element &element : mElements) {
+        if (!tok) {
+            // If we have no tokens, pattern "!!else" matches
+            if (element.kind == NOT)
+                continue;
+            return NO_MATCH;
+        }
+
+        const std::string &str = tok->str();
+        switch (element.kind) {
+        case CHARS:
+            if (str.size() != 1 || !element.chars.test(static_cast<unsigned char>(str[0])))
+                return NO_MATCH;
+            break;
+        case NOT:
+            if (str == element.str)
+                return NO_MATCH;
+            if (isWordPrefix(element.str, str))
+                return RUNTIME;
+            break;
+        case ALTERNATIVES: {
+            if (str.empty())
+                return RUNTIME;
+            bool found = false;
+            for (const Alternative &alternative : element.alternatives) {
+                if (alternative.command != LITERAL)
+                    found = matchCommand(tok, alternative.command, varid);
+                else if (str.size() == alternative.str.size())
+                    found = (str == alternative.str);
+                else if (isWordPrefix(alternative.str, str))
+                    return RUNTIME;
+                if (found)
+                    break;
+            }
+            if (!found) {
+                if (!element.optional)
+                    return NO_MATCH;
+                // Empty alternative matches, use the same token for next element
+                continue;
+            }
+            break;
+        }
+        }
+        tok = tok->next();
+    }
+    return MATCH;
+}
+
+bool SimpleMatchProgram::compile(const char pattern[])
+{
+    // Split the pattern like Token::simpleMatchRuntime(), consecutive spaces give an empty word
+    const char *current = pattern;
+    const char *next = std::strchr(pattern, ' ');
+    if (!next)
+        next = pattern + std::strlen(pattern);
+    while (*current) {
+        mWords.emplace_back(current, next);
+        current = next;
+        if (*next) {
+            next = std::strchr(++current, ' ');
+            if (!next)
+                next = current + std::strlen(current);
+        }
+    }
+    return true;
+}
+
+bool SimpleMatchProgram::match(const Token *tok) const
+{
+    if (!tok)
+        return false;
+    for (const std::string &word : mWords) {
+        if (!tok || tok->str() != word)
+            return false;
+        tok = tok->next();
+    }
+    return true;
+}
+
+/** Match with a parsed pattern, RUNTIME if the pattern could not be parsed */
+static MatchProgram::Result matchParsed(const MatchProgram *program, const Token *tok, unsigned int varid)
+{
+    return program ? program->match(tok, varid) : MatchProgram::RUNTIME;
+}
+
+static PatternCache<MatchProgram> &matchPatterns()
+{
+    static thread_local PatternCache<MatchProgram> cache;
+    return cache;
+}
+
+static PatternCache<SimpleMatchProgram> &simpleMatchPatterns()
+{
+    static thread_local PatternCache<SimpleMatchProgram> cache;
+    return cache;
+}
+
+bool Token::matchCompiled(const Token *tok, const char pattern[], std::size_t size, unsigned int varid)
+{
+    const MatchProgram::Result result = matchParsed(matchPatterns().get(pattern, size), tok, varid);
+    if (result != MatchProgram::RUNTIME)
+        return result == MatchProgram::MATCH;
+    return matchRuntime(tok, pattern, varid);
+}
+
+bool Token::simpleMatchCompiled(const Token *tok, const char pattern[], std::size_t size)
+{
+    return simpleMatchPatterns().get(pattern, size)->match(tok);
+}
+
 std::size_t Token::getStrLength(const Token *tok)
 {
     assert(tok != nullptr);
@@ -789,6 +1295,8 @@ void Token::move(Token *srcStart, Token *srcEnd, Token *newLocation)
 {
     /**[newLocation] -> b -> c -> [srcStart] -> [srcEnd] -> f */
 
+    newLocation->resetDefUseIndex();
+
     // Fix the gap, which tokens to be moved will leave
     srcStart->previous()->next(srcEnd->next());
     srcEnd->next()->previous(srcStart->previous());
@@ -919,10 +1427,13 @@ Token * Token::findOpeningBracket()
 
 //---------------------------------------------------------------------------
 
+// The pattern may be built at runtime, so it is compared once for the search
+
 const Token *Token::findsimplematch(const Token * const startTok, const char pattern[])
 {
+    const SimpleMatchProgram *program = simpleMatchPatterns().get(pattern, std::strlen(pattern) + 1U);
     for (const Token* tok = startTok; tok; tok = tok->next()) {
-        if (Token::simpleMatch(tok, pattern))
+        if (program->match(tok))
             return tok;
     }
     return nullptr;
@@ -930,8 +1441,9 @@ const Token *Token::findsimplematch(const Token * const startTok, const char pat
 
 const Token *Token::findsimplematch(const Token * const startTok, const char pattern[], const Token * const end)
 {
+    const SimpleMatchProgram *program = simpleMatchPatterns().get(pattern, std::strlen(pattern) + 1U);
     for (const Token* tok = startTok; tok && tok != end; tok = tok->next()) {
-        if (Token::simpleMatch(tok, pattern))
+        if (program->match(tok))
             return tok;
     }
     return nullptr;
@@ -939,8 +1451,10 @@ const Token *Token::findsimplematch(const Token * const startTok, const char pat
 
 const Token *Token::findmatch(const Token * const startTok, const char pattern[], const unsigned int varId)
 {
+    const MatchProgram *program = matchPatterns().get(pattern, std::strlen(pattern) + 1U);
     for (const Token* tok = startTok; tok; tok = tok->next()) {
-        if (Token::Match(tok, pattern, varId))
+        const MatchProgram::Result result = matchParsed(program, tok, varId);
+        if (result == MatchProgram::MATCH || (result == MatchProgram::RUNTIME && matchRuntime(tok, pattern, varId)))
             return tok;
     }
     return nullptr;
@@ -948,8 +1462,10 @@ const Token *Token::findmatch(const Token * const startTok, const char pattern[]
 
 const Token *Token::findmatch(const Token * const startTok, const char pattern[], const Token * const end, const unsigned int varId)
 {
+    const MatchProgram *program = matchPatterns().get(pattern, std::strlen(pattern) + 1U);
     for (const Token* tok = startTok; tok && tok != end; tok = tok->next()) {
-        if (Token::Match(tok, pattern, varId))
+        const MatchProgram::Result result = matchParsed(program, tok, varId);
+        if (result == MatchProgram::MATCH || (result == MatchProgram::RUNTIME && matchRuntime(tok, pattern, varId)))
             return tok;
     }
     return nullptr;
@@ -961,7 +1477,7 @@ void Token::insertToken(const std::string &tokenStr, const std::string &original
     if (mStr.empty())
         newToken = this;
     else
-        newToken = new Token(mTokensFrontBack);
+        newToken = new (mTokensFrontBack) Token(mTokensFrontBack);
     newToken->str(tokenStr);
     if (!originalNameStr.empty())
         newToken->originalName(originalNameStr);
@@ -1136,6 +1652,7 @@ std::string Token::stringifyList(bool varid) const
 
 void Token::astOperand1(Token *tok)
 {
+    resetDefUseIndex();
     if (mImpl->mAstOperand1)
         mImpl->mAstOperand1->mImpl->mAstParent = nullptr;
     // goto parent operator
@@ -1153,6 +1670,7 @@ void Token::astOperand1(Token *tok)
 
 void Token::astOperand2(Token *tok)
 {
+    resetDefUseIndex();
     if (mImpl->mAstOperand2)
         mImpl->mAstOperand2->mImpl->mAstParent = nullptr;
     // goto parent operator
@@ -1448,6 +1966,9 @@ void Token::printValueFlow(bool xml, std::ostream &out) const
                     else
                         out << "intvalue=\"" << value.intvalue << '\"';
                     break;
+                case ValueFlow::Value::INT_RANGE:
+                    out << "range-min=\"" << value.intvalue << "\" range-max=\"" << value.intvalueMax << '\"';
+                    break;
                 case ValueFlow::Value::TOK:
                     out << "tokvalue=\"" << value.tokvalue << '\"';
                     break;
@@ -1491,6 +2012,9 @@ void Token::printValueFlow(bool xml, std::ostream &out) const
                     else
                         out << value.intvalue;
                     break;
+                case ValueFlow::Value::INT_RANGE:
+                    out << value.intvalue << ".." << value.intvalueMax;
+                    break;
                 case ValueFlow::Value::TOK:
                     out << value.tokvalue->str();
                     break;
@@ -1529,7 +2053,7 @@ const ValueFlow::Value * Token::getValueLE(const MathLib::bigint val, const Sett
     if (!mImpl->mValues)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mImpl->mValues->begin(); it != mImpl->mValues->end(); ++it) {
         if (it->isIntValue() && it->intvalue <= val) {
             if (!ret || ret->isInconclusive() || (ret->condition && !it->isInconclusive()))
@@ -1552,7 +2076,7 @@ const ValueFlow::Value * Token::getValueGE(const MathLib::bigint val, const Sett
     if (!mImpl->mValues)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mImpl->mValues->begin(); it != mImpl->mValues->end(); ++it) {
         if (it->isIntValue() && it->intvalue >= val) {
             if (!ret || ret->isInconclusive() || (ret->condition && !it->isInconclusive()))
@@ -1575,7 +2099,7 @@ const ValueFlow::Value * Token::getInvalidValue(const Token *ftok, unsigned int
     if (!mImpl->mValues || !settings)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mImpl->mValues->begin(); it != mImpl->mValues->end(); ++it) {
         if ((it->isIntValue() && !settings->library.isIntArgValid(ftok, argnr, it->intvalue)) ||
             (it->isFloatValue() && !settings->library.isFloatArgValid(ftok, argnr, it->floatValue))) {
@@ -1600,7 +2124,7 @@ const Token *Token::getValueTokenMinStrSize() const
         return nullptr;
     const Token *ret = nullptr;
     std::size_t minsize = ~0U;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mImpl->mValues->begin(); it != mImpl->mValues->end(); ++it) {
         if (it->isTokValue() && it->tokvalue && it->tokvalue->tokType() == Token::eString) {
             const std::size_t size = getStrSize(it->tokvalue);
@@ -1619,7 +2143,7 @@ const Token *Token::getValueTokenMaxStrLength() const
         return nullptr;
     const Token *ret = nullptr;
     std::size_t maxlength = 0U;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mImpl->mValues->begin(); it != mImpl->mValues->end(); ++it) {
         if (it->isTokValue() && it->tokvalue && it->tokvalue->tokType() == Token::eString) {
             const std::size_t length = getStrLength(it->tokvalue);
@@ -1643,7 +2167,7 @@ const Token *Token::getValueTokenDeadPointer() const
 {
     const Scope * const functionscope = getfunctionscope(this->scope());
 
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = values().begin(); it != values().end(); ++it) {
         // Is this a pointer alias?
         if (!it->isTokValue() || (it->tokvalue && it->tokvalue->str() != "&"))
@@ -1672,26 +2196,65 @@ const Token *Token::getValueTokenDeadPointer() const
     return nullptr;
 }
 
+/** Can the int values be merged into the same range? */
+static bool isSameIntRangeKind(const ValueFlow::Value &value1, const ValueFlow::Value &value2)
+{
+    return value1.valueKind == value2.valueKind &&
+           !value1.condition == !value2.condition &&
+           value1.conditional == value2.conditional &&
+           value1.defaultArg == value2.defaultArg;
+}
+
 bool Token::addValue(const ValueFlow::Value &value)
 {
     if (value.isKnown() && mImpl->mValues) {
         // Clear all other values of the same type since value is known
         mImpl->mValues->remove_if([&](const ValueFlow::Value & x) {
-            return x.valueType == value.valueType;
+            return x.valueType == value.valueType || (value.isIntValue() && x.isIntRangeValue());
         });
     }
 
     if (mImpl->mValues) {
-        // Don't handle more than 10 values for performance reasons
+        // Int values that are kept are not merged into a range when they are added again
+        const bool hasIntValue = value.isIntValue() && std::any_of(mImpl->mValues->begin(), mImpl->mValues->end(), [&](const ValueFlow::Value &v) {
+            return v.isIntValue() && v.intvalue == value.intvalue;
+        });
+
+        if ((value.isIntValue() || value.isIntRangeValue()) && !hasIntValue) {
+            for (ValueFlow::Value &range : *mImpl->mValues) {
+                if (!range.isIntRangeValue() || !isSameIntRangeKind(range, value))
+                    continue;
+                // Most checks don't look at ranges, keep int values while there is room
+                if (value.isIntValue() && mImpl->mValues->size() < 10U)
+                    continue;
+                // value is already in the range
+                if (range.intvalue <= value.intvalue && value.maxIntValue() <= range.intvalueMax)
+                    return false;
+                if (mImpl->mValues->size() >= 10U)
+                    return range.mergeIntRange(value);
+            }
+        }
+
+        // Don't handle more than 10 values for performance reasons. Int
+        // values that don't fit are merged into a range.
         // TODO: add setting?
-        if (mImpl->mValues->size() >= 10U)
-            return false;
+        if (mImpl->mValues->size() >= 10U && !hasIntValue) {
+            if ((!value.isIntValue() && !value.isIntRangeValue()) || mImpl->mValues->size() >= 12U)
+                return false;
+            ValueFlow::Value v(value);
+            v.valueType = ValueFlow::Value::INT_RANGE;
+            v.intvalueMax = value.maxIntValue();
+            if (v.varId == 0)
+                v.varId = mImpl->mVarId;
+            mImpl->mValues->push_back(v);
+            return true;
+        }
 
         // if value already exists, don't add it again
-        std::list<ValueFlow::Value>::iterator it;
+        ValueFlow::ValueList::iterator it;
         for (it = mImpl->mValues->begin(); it != mImpl->mValues->end(); ++it) {
             // different intvalue => continue
-            if (it->intvalue != value.intvalue)
+            if (it->intvalue != value.intvalue || (value.isIntRangeValue() && it->intvalueMax != value.intvalueMax))
                 continue;
 
             // different types => continue
@@ -1726,7 +2289,8 @@ bool Token::addValue(const ValueFlow::Value &value)
         ValueFlow::Value v(value);
         if (v.varId == 0)
             v.varId = mImpl->mVarId;
-        mImpl->mValues = new std::list<ValueFlow::Value>(1, v);
+        mImpl->mValues = new ValueFlow::ValueList;
+        mImpl->mValues->push_back(v);
     }
 
     return true;
@@ -1751,6 +2315,7 @@ void Token::assignIndexes()
 
 void Token::setValueType(ValueType *vt)
 {
+    resetDefUseIndex();
     if (vt != mImpl->mValueType) {
         delete mImpl->mValueType;
         mImpl->mValueType = vt;
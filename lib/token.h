@@ -32,6 +32,7 @@
 #include <list>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 class Enumerator;
@@ -42,12 +43,75 @@ class Type;
 class ValueType;
 class Variable;
 
+class DefUseIndex;
+class TokenArena;
+
 /**
  * @brief This struct stores pointers to the front and back tokens of the list this token is in.
  */
 struct TokensFrontBack {
     Token *front;
     Token *back;
+    /** Memory for the tokens of the list. If this is nullptr the tokens are allocated on the heap. */
+    TokenArena *arena;
+    /** Uses of the variables of the list. It is reset when tokens are added, removed or moved, or when the AST, variables, functions or value types change. */
+    const DefUseIndex *defUseIndex;
+};
+
+/**
+ * @brief Memory for the tokens of a token list.
+ *
+ * Token and TokenImpl objects are allocated from large chunks instead of
+ * one heap allocation each. The memory of a deleted object is reused for
+ * the next object of the same type.
+ */
+class CPPCHECKLIB TokenArena {
+public:
+    TokenArena();
+    ~TokenArena();
+
+    /** Release the chunks of the arena if none of its objects is alive */
+    void release();
+
+private:
+    friend class Token;
+    friend struct TokenImpl;
+
+    /** Objects of one size. Each object is preceded by the pool it was allocated from. */
+    class Pool {
+    public:
+        explicit Pool(std::size_t objectSize);
+        ~Pool();
+
+        /** Allocate an object from given pool, or from the heap if pool is nullptr */
+        static void *allocate(Pool *pool, std::size_t size);
+
+        /** Deallocate an object that was allocated by allocate() */
+        static void deallocate(void *p);
+
+        void release();
+
+    private:
+        // Not implemented..
+        Pool(const Pool &);
+        Pool &operator=(const Pool &);
+
+        const std::size_t mBlockSize;
+        std::vector<char *> mChunks;
+        char *mChunkPos;
+        char *mChunkEnd;
+        /** Deallocated blocks, each block holds the pointer to the next one */
+        void *mFreeList;
+        /** Number of allocated objects */
+        std::size_t mCount;
+    };
+
+    // Not implemented..
+    TokenArena(const TokenArena &);
+    TokenArena &operator=(const TokenArena &);
+
+    Pool mTokens;
+    Pool mImpls;
 };
 
 struct TokenImpl {
@@ -88,8 +152,8 @@ struct TokenImpl {
     ValueType *mValueType;
 
     // ValueFlow
-    std::list<ValueFlow::Value>* mValues;
-    static const std::list<ValueFlow::Value> mEmptyValueList;
+    ValueFlow::ValueList* mValues;
+    static const ValueFlow::ValueList mEmptyValueList;
 
     /** Bitfield bit count. */
     unsigned char mBits;
@@ -117,6 +181,11 @@ struct TokenImpl {
     {}
 
     ~TokenImpl();
+
+    /** Allocate from the arena of a token list, or from the heap if arena is nullptr */
+    static void *operator new(std::size_t size, TokenArena *arena);
+    static void operator delete(void *p, TokenArena *arena);
+    static void operator delete(void *p);
 };
 
 /// @addtogroup Core
@@ -136,6 +205,12 @@ class CPPCHECKLIB Token {
 private:
     TokensFrontBack* mTokensFrontBack;
 
+    /** Patterns that are not character arrays are parsed in every call of Match() and simpleMatch() */
+    template<typename T>
+    struct IsRuntimePattern {
+        static const bool value = std::is_convertible<T, const char *>::value && !std::is_array<T>::value;
+    };
+
     // Not implemented..
     Token(const Token &);
     Token operator=(const Token &);
@@ -153,6 +228,14 @@ public:
     explicit Token(TokensFrontBack *tokensFrontBack = nullptr);
     ~Token();
 
+    /** Allocate a token on the heap */
+    static void *operator new(std::size_t size);
+
+    /** Allocate a token from the arena of a token list. Use as: new (tokensFrontBack) Token(tokensFrontBack) */
+    static void *operator new(std::size_t size, TokensFrontBack *tokensFrontBack);
+    static void operator delete(void *p, TokensFrontBack *tokensFrontBack);
+    static void operator delete(void *p);
+
     template<typename T>
     void str(T&& s) {
         mStr = s;
@@ -224,13 +307,33 @@ public:
      * is "void" and token after that is '{'. If even one of the tokens does
      * not match its pattern, false is returned.
      *
+     * A pattern given as a constant character array, e.g. a string
+     * literal, is parsed once and the parsed pattern is reused in later
+     * calls. It is found by its address and compared, so an array that
+     * has another pattern in a later call is parsed again. Other patterns
+     * are parsed in every call.
+     *
      * @param tok List of tokens to be compared to the pattern
      * @param pattern The pattern against which the tokens are compared,
      * e.g. "const" or ") void {".
      * @return true if given token matches with given pattern
      *         false if given token does not match with given pattern
      */
-    static bool simpleMatch(const Token *tok, const char pattern[]);
+    template<std::size_t N>
+    static bool simpleMatch(const Token *tok, const char (&pattern)[N]) {
+        return simpleMatchCompiled(tok, pattern, N);
+    }
+
+    template<std::size_t N>
+    static bool simpleMatch(const Token *tok, char (&pattern)[N]) {
+        return simpleMatchRuntime(tok, pattern);
+    }
+
+    template<typename T>
+    static typename std::enable_if<IsRuntimePattern<T>::value, bool>::type
+    simpleMatch(const Token *tok, const T &pattern) {
+        return simpleMatchRuntime(tok, pattern);
+    }
 
     /**
      * Match given token (or list of tokens) to a pattern list.
@@ -267,6 +370,12 @@ public:
      * "const" or "void" and token after that is '{'. If even one of the tokens does not
      * match its pattern, false is returned.
      *
+     * A pattern given as a constant character array, e.g. a string
+     * literal, is parsed once and the parsed pattern is reused in later
+     * calls. It is found by its address and compared, so an array that
+     * has another pattern in a later call is parsed again. Other patterns
+     * are parsed in every call.
+     *
      * @param tok List of tokens to be compared to the pattern
      * @param pattern The pattern against which the tokens are compared,
      * e.g. "const" or ") const|volatile| {".
@@ -275,7 +384,21 @@ public:
      * @return true if given token matches with given pattern
      *         false if given token does not match with given pattern
      */
-    static bool Match(const Token *tok, const char pattern[], unsigned int varid = 0);
+    template<std::size_t N>
+    static bool Match(const Token *tok, const char (&pattern)[N], unsigned int varid = 0) {
+        return matchCompiled(tok, pattern, N, varid);
+    }
+
+    template<std::size_t N>
+    static bool Match(const Token *tok, char (&pattern)[N], unsigned int varid = 0) {
+        return matchRuntime(tok, pattern, varid);
+    }
+
+    template<typename T>
+    static typename std::enable_if<IsRuntimePattern<T>::value, bool>::type
+    Match(const Token *tok, const T &pattern, unsigned int varid = 0) {
+        return matchRuntime(tok, pattern, varid);
+    }
 
     /**
      * @return length of C-string.
@@ -653,6 +776,7 @@ public:
     }
     void varId(unsigned int id) {
         mImpl->mVarId = id;
+        resetDefUseIndex();
         if (id != 0) {
             tokType(eVariable);
             isStandardType(false);
@@ -766,6 +890,7 @@ public:
      * @param f Function to be associated
      */
     void function(const Function *f) {
+        resetDefUseIndex();
         mImpl->mFunction = f;
         if (f)
             tokType(eFunction);
@@ -785,6 +910,7 @@ public:
      * @param v Variable to be associated
      */
     void variable(const Variable *v) {
+        resetDefUseIndex();
         mImpl->mVariable = v;
         if (v || mImpl->mVarId)
             tokType(eVariable);
@@ -906,7 +1032,7 @@ public:
         return mImpl->mOriginalName ? *mImpl->mOriginalName : emptyString;
     }
 
-    const std::list<ValueFlow::Value>& values() const {
+    const ValueFlow::ValueList& values() const {
         return mImpl->mValues ? *mImpl->mValues : mImpl->mEmptyValueList;
     }
 
@@ -997,10 +1123,20 @@ public:
         return mImpl->mIndex;
     }
 
+    /** Uses of the variables in the list of this token, nullptr if the list is changed after it was created */
+    const DefUseIndex *defUseIndex() const {
+        return mTokensFrontBack ? mTokensFrontBack->defUseIndex : nullptr;
+    }
+
     void assignIndexes();
 
 private:
 
+    void resetDefUseIndex() {
+        if (mTokensFrontBack)
+            mTokensFrontBack->defUseIndex = nullptr;
+    }
+
     void next(Token *nextToken) {
         mNext = nextToken;
     }
@@ -1025,6 +1161,18 @@ private:
      */
     static const char *chrInFirstWord(const char *str, char c);
 
+    /** Match() for patterns that are parsed in every call */
+    static bool matchRuntime(const Token *tok, const char pattern[], unsigned int varid);
+
+    /** Match() for a character array of given size, the parsed pattern is cached */
+    static bool matchCompiled(const Token *tok, const char pattern[], std::size_t size, unsigned int varid);
+
+    /** simpleMatch() for patterns that are parsed in every call */
+    static bool simpleMatchRuntime(const Token *tok, const char pattern[]);
+
+    /** simpleMatch() for a character array of given size, the parsed pattern is cached */
+    static bool simpleMatchCompiled(const Token *tok, const char pattern[], std::size_t size);
+
     std::string mStr;
 
     Token *mNext;
@@ -1144,6 +1292,7 @@ public:
     bool isCalculation() const;
 
     void clearAst() {
+        resetDefUseIndex();
         mImpl->mAstOperand1 = mImpl->mAstOperand2 = mImpl->mAstParent = nullptr;
     }
 
@@ -0,0 +1,370 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tokencache.h"
+
+#include "path.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <unordered_map>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+namespace {
+    /** Incremented when the file format or the simplecpp tokenizer changes */
+    const std::uint32_t CACHE_VERSION = 1;
+
+    const char CACHE_MAGIC[8] = {'C','P','P','C','H','K','T','C'};
+
+    struct CacheHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t fileCount;
+        std::uint64_t contentHash;
+        std::uint64_t contentSize;
+        std::uint32_t tokenCount;
+        std::uint32_t stringPoolSize;
+    };
+
+    /** Other file names the tokens refer to, with #line directives */
+    struct FileRecord {
+        std::uint32_t str;
+        std::uint32_t len;
+    };
+
+    /**
+     * Token string is an offset into the string pool. File index 0 is the
+     * file itself, the file index n is the FileRecord n-1.
+     */
+    struct TokenRecord {
+        std::uint32_t str;
+        std::uint32_t len;
+        std::uint32_t fileIndex;
+        std::uint32_t line;
+        std::uint32_t col;
+    };
+
+    /** Read only view of a cache file, mapped into memory if possible */
+    class CacheFile {
+    public:
+        explicit CacheFile(const std::string &filename) : mData(nullptr), mSize(0) {
+#ifndef _WIN32
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                return;
+            struct stat fileStat;
+            if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+                void *p = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    mData = static_cast<const char *>(p);
+                    mSize = static_cast<std::size_t>(fileStat.st_size);
+                }
+            }
+            ::close(fd);
+#else
+            std::ifstream fin(filename, std::ios::binary);
+            mBuffer.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+            mData = mBuffer.data();
+            mSize = mBuffer.size();
+#endif
+        }
+
+        ~CacheFile() {
+#ifndef _WIN32
+            if (mData)
+                munmap(const_cast<char *>(mData), mSize);
+#endif
+        }
+
+        const char *data() const {
+            return mData;
+        }
+
+        std::size_t size() const {
+            return mSize;
+        }
+
+    private:
+        const char *mData;
+        std::size_t mSize;
+#ifdef _WIN32
+        std::string mBuffer;
+#endif
+
+        CacheFile(const CacheFile &);
+        CacheFile &operator=(const CacheFile &);
+    };
+
+    /** String pool of a cache file being written, equal strings are stored once */
+    class StringPool {
+    public:
+        std::uint32_t add(const std::string &str) {
+            const std::unordered_map<std::string, std::uint32_t>::const_iterator it = mOffsets.find(str);
+            if (it != mOffsets.end())
+                return it->second;
+            const std::uint32_t offset = static_cast<std::uint32_t>(mData.size());
+            mData += str;
+            mOffsets[str] = offset;
+            return offset;
+        }
+
+        const std::string &data() const {
+            return mData;
+        }
+
+    private:
+        std::string mData;
+        std::unordered_map<std::string, std::uint32_t> mOffsets;
+    };
+}
+
+static unsigned int getFileIndex(std::vector<std::string> &files, const std::string &filename)
+{
+    const std::vector<std::string>::const_iterator it = std::find(files.begin(), files.end(), filename);
+    if (it != files.end())
+        return static_cast<unsigned int>(it - files.begin());
+    files.push_back(filename);
+    return static_cast<unsigned int>(files.size() - 1U);
+}
+
+static bool validString(std::uint32_t str, std::uint32_t len, std::uint32_t stringPoolSize)
+{
+    return str <= stringPoolSize && len <= stringPoolSize - str;
+}
+
+static int getProcessId()
+{
+#ifndef _WIN32
+    return static_cast<int>(getpid());
+#else
+    return _getpid();
+#endif
+}
+
+bool TokenCache::FileStamp::stat(const std::string &filename)
+{
+    // A file that is modified in the same second as it is read could be
+    // modified again without changing the modification time
+    const std::time_t now = std::time(nullptr);
+    struct ::stat fileStat;
+    if (::stat(filename.c_str(), &fileStat) != 0)
+        return false;
+    mtime = (fileStat.st_mtime < now) ? fileStat.st_mtime : 0;
+    size = fileStat.st_size;
+    return true;
+}
+
+void TokenCache::FileStamp::setContent(const std::string &content)
+{
+    // The file was replaced between stat() and reading it
+    if (content.size() != static_cast<std::size_t>(size))
+        mtime = 0;
+    hash = TokenCache::hash(content);
+}
+
+unsigned long long TokenCache::hash(const std::string &content)
+{
+    // FNV-1a
+    std::uint64_t h = 14695981039346656037ULL;
+    for (const char c : content) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+std::string TokenCache::getCacheFile(const std::string &buildDir, const std::string &filename)
+{
+    std::string dir = Path::fromNativeSeparators(buildDir);
+    if (!endsWith(dir, '/'))
+        dir += '/';
+
+    // The base name is only there to make the build dir readable, the hash
+    // of the path tells files with the same name apart
+    const std::string path = Path::simplifyPath(Path::fromNativeSeparators(filename));
+    const std::string::size_type pos = path.rfind('/');
+    const std::string basename = (pos == std::string::npos) ? path : path.substr(pos + 1);
+
+    std::ostringstream ostr;
+    ostr << dir << basename << '.' << std::hex << std::setfill('0') << std::setw(16) << hash(path) << ".rawtokens";
+    return ostr.str();
+}
+
+bool TokenCache::load(const std::string &cacheFile, const std::string &content, std::vector<std::string> &files, const std::string &filename, simplecpp::TokenList &tokens)
+{
+    const CacheFile cache(cacheFile);
+    if (cache.size() < sizeof(CacheHeader))
+        return false;
+
+    const CacheHeader *header = reinterpret_cast<const CacheHeader *>(cache.data());
+    if (std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header->version != CACHE_VERSION ||
+        header->contentHash != hash(content) ||
+        header->contentSize != content.size())
+        return false;
+
+    const std::size_t fileOffset = sizeof(CacheHeader);
+    const std::size_t tokenOffset = fileOffset + header->fileCount * sizeof(FileRecord);
+    const std::size_t stringOffset = tokenOffset + header->tokenCount * sizeof(TokenRecord);
+    if (stringOffset + header->stringPoolSize != cache.size())
+        return false;
+
+    const FileRecord *fileRecords = reinterpret_cast<const FileRecord *>(cache.data() + fileOffset);
+    const TokenRecord *tokenRecords = reinterpret_cast<const TokenRecord *>(cache.data() + tokenOffset);
+    const char *stringPool = cache.data() + stringOffset;
+
+    // Validate everything before the token list is changed
+    for (std::uint32_t i = 0; i < header->fileCount; ++i) {
+        if (!validString(fileRecords[i].str, fileRecords[i].len, header->stringPoolSize))
+            return false;
+    }
+    for (std::uint32_t i = 0; i < header->tokenCount; ++i) {
+        const TokenRecord &rec = tokenRecords[i];
+        if (rec.len == 0 || !validString(rec.str, rec.len, header->stringPoolSize) || rec.fileIndex > header->fileCount)
+            return false;
+    }
+
+    std::vector<unsigned int> fileIndex(1, getFileIndex(files, filename));
+    for (std::uint32_t i = 0; i < header->fileCount; ++i)
+        fileIndex.push_back(getFileIndex(files, std::string(stringPool + fileRecords[i].str, fileRecords[i].len)));
+
+    simplecpp::Location location(files);
+    for (std::uint32_t i = 0; i < header->tokenCount; ++i) {
+        const TokenRecord &rec = tokenRecords[i];
+        location.fileIndex = fileIndex[rec.fileIndex];
+        location.line = rec.line;
+        location.col = rec.col;
+        tokens.push_back(new simplecpp::Token(simplecpp::TokenString(stringPool + rec.str, rec.len), location));
+    }
+    return true;
+}
+
+bool TokenCache::store(const std::string &cacheFile, const std::string &content, const std::vector<std::string> &files, const std::string &filename, const simplecpp::TokenList &tokens)
+{
+    StringPool stringPool;
+    std::vector<FileRecord> fileRecords;
+    std::vector<TokenRecord> tokenRecords;
+
+    // Map the file indexes of the tokens, 0 is the file itself
+    const std::uint32_t noIndex = ~0U;
+    std::vector<std::uint32_t> fileIndex(files.size(), noIndex);
+
+    for (const simplecpp::Token *tok = tokens.cfront(); tok; tok = tok->next) {
+        const unsigned int index = tok->location.fileIndex;
+        if (index >= files.size())
+            return false;
+        if (fileIndex[index] == noIndex) {
+            if (files[index] == filename)
+                fileIndex[index] = 0;
+            else {
+                FileRecord rec;
+                rec.str = stringPool.add(files[index]);
+                rec.len = static_cast<std::uint32_t>(files[index].size());
+                fileRecords.push_back(rec);
+                fileIndex[index] = static_cast<std::uint32_t>(fileRecords.size());
+            }
+        }
+        TokenRecord rec;
+        rec.str = stringPool.add(tok->str());
+        rec.len = static_cast<std::uint32_t>(tok->str().size());
+        rec.fileIndex = fileIndex[index];
+        rec.line = tok->location.line;
+        rec.col = tok->location.col;
+        tokenRecords.push_back(rec);
+    }
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.fileCount = static_cast<std::uint32_t>(fileRecords.size());
+    header.contentHash = hash(content);
+    header.contentSize = content.size();
+    header.tokenCount = static_cast<std::uint32_t>(tokenRecords.size());
+    header.stringPoolSize = static_cast<std::uint32_t>(stringPool.data().size());
+
+    // Write a temporary file and rename it so other processes never see a partial file
+    std::ostringstream tempFile;
+    tempFile << cacheFile << '.' << getProcessId() << '.' << &tokens << ".tmp";
+    {
+        std::ofstream fout(tempFile.str(), std::ios::binary);
+        if (!fout.is_open())
+            return false;
+        fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        if (!fileRecords.empty())
+            fout.write(reinterpret_cast<const char *>(fileRecords.data()), fileRecords.size() * sizeof(FileRecord));
+        if (!tokenRecords.empty())
+            fout.write(reinterpret_cast<const char *>(tokenRecords.data()), tokenRecords.size() * sizeof(TokenRecord));
+        fout.write(stringPool.data().data(), stringPool.data().size());
+        if (!fout.good()) {
+            fout.close();
+            std::remove(tempFile.str().c_str());
+            return false;
+        }
+    }
+    if (std::rename(tempFile.str().c_str(), cacheFile.c_str()) != 0) {
+        std::remove(tempFile.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+void TokenCache::readfile(const std::string &buildDir, std::istream &istr, std::vector<std::string> &files, const std::string &filename, simplecpp::TokenList &tokens, simplecpp::OutputList *outputList, FileStamp *stamp)
+{
+    if ((buildDir.empty() && !stamp) || !tokens.empty()) {
+        tokens.readfile(istr, filename, outputList);
+        return;
+    }
+
+    const std::string content((std::istreambuf_iterator<char>(istr)), std::istreambuf_iterator<char>());
+    if (stamp)
+        stamp->setContent(content);
+    if (buildDir.empty()) {
+        std::istringstream istr2(content);
+        tokens.readfile(istr2, filename, outputList);
+        return;
+    }
+
+    const std::string cacheFile = getCacheFile(buildDir, filename);
+    if (load(cacheFile, content, files, filename, tokens))
+        return;
+
+    std::istringstream istr2(content);
+    simplecpp::OutputList output;
+    tokens.readfile(istr2, filename, &output);
+    if (output.empty())
+        store(cacheFile, content, files, filename, tokens);
+    else if (outputList)
+        outputList->splice(outputList->end(), output);
+}
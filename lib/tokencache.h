@@ -0,0 +1,105 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef tokencacheH
+#define tokencacheH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+#include "simplecpp.h"
+
+#include <ctime>
+#include <istream>
+#include <string>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Raw tokens of source files, cached in the build dir
+ *
+ * The raw tokens of a file are stored in a binary file in the build dir,
+ * one cache file per source file. The cache file records the hash of the
+ * content. When the content is unchanged in a later run the tokens are
+ * read from the cache instead of tokenizing the file again, when it has
+ * changed the cache file is replaced, so editing files does not make the
+ * cache grow.
+ *
+ * The cache file is a header followed by arrays of fixed size records and
+ * a string pool, so it can be mapped into memory and read in place.
+ */
+class CPPCHECKLIB TokenCache {
+public:
+    /**
+     * Modification time, size and content hash of a file as it was read.
+     * The modification time is 0 if the file could be modified again
+     * without changing the modification time, then the content must be
+     * compared.
+     */
+    struct FileStamp {
+        FileStamp() : mtime(0), size(0), hash(0) {}
+
+        /**
+         * Get modification time and size, before the file is read
+         * @return false if the file is not found
+         */
+        bool stat(const std::string &filename);
+
+        /** Set the hash of the content that was read */
+        void setContent(const std::string &content);
+
+        std::time_t mtime;
+        long long size;
+        unsigned long long hash;
+    };
+
+    /**
+     * Read raw tokens of a file. If buildDir is not empty the tokens are
+     * read from the cache if possible and otherwise added to the cache.
+     * Files that have tokenizer output (errors, warnings) are not cached.
+     * @param buildDir the cppcheck build dir
+     * @param istr content of the file
+     * @param files the file names that tokens refer to
+     * @param filename name of the file
+     * @param tokens the tokens are appended to this token list, it must use files
+     * @param outputList output of the tokenizer
+     * @param stamp if not null, the hash of the content that is read is set
+     */
+    static void readfile(const std::string &buildDir, std::istream &istr, std::vector<std::string> &files, const std::string &filename, simplecpp::TokenList &tokens, simplecpp::OutputList *outputList, FileStamp *stamp = nullptr);
+
+    /** Hash of file content, the key of the cache */
+    static unsigned long long hash(const std::string &content);
+
+    /** Name of the cache file of a source file */
+    static std::string getCacheFile(const std::string &buildDir, const std::string &filename);
+
+    /**
+     * Read tokens from cache file.
+     * @return false if the cache file is missing, invalid or for other content
+     */
+    static bool load(const std::string &cacheFile, const std::string &content, std::vector<std::string> &files, const std::string &filename, simplecpp::TokenList &tokens);
+
+    /** Write tokens to cache file */
+    static bool store(const std::string &cacheFile, const std::string &content, const std::vector<std::string> &files, const std::string &filename, const simplecpp::TokenList &tokens);
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // tokencacheH
@@ -544,6 +544,19 @@ Token *Tokenizer::processFunc(Token *tok2, bool inOperator) const
 
 void Tokenizer::simplifyTypedef()
 {
+    // Count the names once, the counts are not updated but stay
+    // conservative. Removed typedefs make them too large, which only
+    // disables the skip below. Replacing a typedef copies the names of
+    // its definition, so a copied name was already counted there besides
+    // at its own typedef. A name that is counted once can therefore not
+    // be used later. This depends on the replacement never inventing a
+    // name that is the name of a typedef.
+    std::unordered_map<std::string, unsigned int> nameCount;
+    for (const Token *tok = list.front(); tok; tok = tok->next()) {
+        if (tok->isName())
+            ++nameCount[tok->str()];
+    }
+
     std::vector<Space> spaceInfo;
     bool isNamespace = false;
     std::string className;
@@ -1024,7 +1037,16 @@ void Tokenizer::simplifyTypedef()
             bool globalScope = false;
             std::size_t classLevel = spaceInfo.size();
 
-            for (Token *tok2 = tok; tok2; tok2 = tok2->next()) {
+            // Skip the search for uses of an unused name. The search also
+            // updates the end of reopened namespaces, so it is only skipped
+            // outside of namespaces.
+            const std::unordered_map<std::string, unsigned int>::const_iterator count = nameCount.find(typeName->str());
+            const bool unused = (count == nameCount.end() || count->second <= 1) &&
+                                std::none_of(spaceInfo.begin(), spaceInfo.end(), [](const Space &info) {
+                return info.isNamespace;
+            });
+
+            for (Token *tok2 = unused ? nullptr : tok; tok2; tok2 = tok2->next()) {
                 if (mSettings->terminated())
                     return;
 
@@ -2300,9 +2322,11 @@ bool Tokenizer::simplifyTokens1(const std::string &configuration)
         mSymbolDatabase->setValueTypeInTokenList();
     }
 
+    list.createDefUseIndex();
+
     if (mTimerResults) {
         Timer t("Tokenizer::simplifyTokens1::ValueFlow", mSettings->showtime, mTimerResults);
-        ValueFlow::setValues(&list, mSymbolDatabase, mErrorLogger, mSettings);
+        ValueFlow::setValues(&list, mSymbolDatabase, mErrorLogger, mSettings, mTimerResults);
     } else {
         ValueFlow::setValues(&list, mSymbolDatabase, mErrorLogger, mSettings);
     }
@@ -4648,6 +4672,8 @@ bool Tokenizer::simplifyTokenList2()
     createSymbolDatabase();
     mSymbolDatabase->setValueTypeInTokenList();
 
+    list.createDefUseIndex();
+
     ValueFlow::setValues(&list, mSymbolDatabase, mErrorLogger, mSettings);
 
     if (mSettings->terminated())
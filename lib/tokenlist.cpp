@@ -19,6 +19,7 @@
 //---------------------------------------------------------------------------
 #include "tokenlist.h"
 
+#include "astutils.h"
 #include "errorlogger.h"
 #include "mathlib.h"
 #include "path.h"
@@ -30,6 +31,7 @@
 #include <cstring>
 #include <set>
 #include <stack>
+#include <unordered_map>
 
 // How many compileExpression recursions are allowed?
 // For practical code this could be endless. But in some special torture test
@@ -43,6 +45,7 @@ TokenList::TokenList(const Settings* settings) :
     mIsC(false),
     mIsCpp(false)
 {
+    mTokensFrontBack.arena = &mTokenArena;
 }
 
 TokenList::~TokenList()
@@ -68,6 +71,9 @@ void TokenList::deallocateTokens()
     deleteTokens(mTokensFrontBack.front);
     mTokensFrontBack.front = nullptr;
     mTokensFrontBack.back = nullptr;
+    mTokensFrontBack.defUseIndex = nullptr;
+    mDefUseIndex.reset();
+    mTokenArena.release();
     mFiles.clear();
 }
 
@@ -144,7 +150,7 @@ void TokenList::addtoken(std::string str, const unsigned int lineno, const unsig
     if (mTokensFrontBack.back) {
         mTokensFrontBack.back->insertToken(str);
     } else {
-        mTokensFrontBack.front = new Token(&mTokensFrontBack);
+        mTokensFrontBack.front = new (&mTokensFrontBack) Token(&mTokensFrontBack);
         mTokensFrontBack.back = mTokensFrontBack.front;
         mTokensFrontBack.back->str(str);
     }
@@ -163,7 +169,7 @@ void TokenList::addtoken(const Token * tok, const unsigned int lineno, const uns
     if (mTokensFrontBack.back) {
         mTokensFrontBack.back->insertToken(tok->str(), tok->originalName());
     } else {
-        mTokensFrontBack.front = new Token(&mTokensFrontBack);
+        mTokensFrontBack.front = new (&mTokensFrontBack) Token(&mTokensFrontBack);
         mTokensFrontBack.back = mTokensFrontBack.front;
         mTokensFrontBack.back->str(tok->str());
         if (!tok->originalName().empty())
@@ -307,7 +313,7 @@ void TokenList::createTokens(const simplecpp::TokenList *tokenList)
         if (mTokensFrontBack.back) {
             mTokensFrontBack.back->insertToken(str);
         } else {
-            mTokensFrontBack.front = new Token(&mTokensFrontBack);
+            mTokensFrontBack.front = new (&mTokensFrontBack) Token(&mTokensFrontBack);
             mTokensFrontBack.back = mTokensFrontBack.front;
             mTokensFrontBack.back->str(str);
         }
@@ -356,8 +362,12 @@ unsigned long long TokenList::calculateChecksum() const
 
 //---------------------------------------------------------------------------
 
+/** Name tokens that iscpp11init() found for the braces it was called with */
+typedef std::unordered_map<const Token *, const Token *> Cpp11InitNames;
+
 struct AST_state {
     std::stack<Token*> op;
+    Cpp11InitNames cpp11InitNames;
     unsigned int depth;
     unsigned int inArrayAssignment;
     bool cpp;
@@ -463,14 +473,24 @@ static Token * findCppTypeInitPar(Token *tok)
 }
 
 // X{} X<Y>{} etc
-static bool iscpp11init(const Token * const tok)
+static bool iscpp11init(const Token * const tok, Cpp11InitNames *names)
 {
     const Token *nameToken = tok;
     while (nameToken && nameToken->str() == "{") {
+        // Reuse the result of a previous element, so that long initializer lists are not quadratic
+        if (nameToken != tok) {
+            const Cpp11InitNames::const_iterator it = names->find(nameToken);
+            if (it != names->end()) {
+                nameToken = it->second;
+                break;
+            }
+        }
         nameToken = nameToken->previous();
         if (nameToken && nameToken->str() == "," && Token::simpleMatch(nameToken->previous(), "} ,"))
             nameToken = nameToken->linkAt(-1);
     }
+    if (tok->str() == "{")
+        (*names)[tok] = nameToken;
     if (!nameToken)
         return false;
     if (nameToken->str() == ">" && nameToken->link())
@@ -583,7 +603,7 @@ static void compileTerm(Token *&tok, AST_state& state)
             tok = findCppTypeInitPar(tok);
             state.op.push(tok);
             tok = tok->tokAt(2);
-        } else if (state.cpp && iscpp11init(tok)) { // X{} X<Y>{} etc
+        } else if (state.cpp && iscpp11init(tok, &state.cpp11InitNames)) { // X{} X<Y>{} etc
             state.op.push(tok);
             tok = tok->next();
             if (tok->str() == "<")
@@ -615,7 +635,7 @@ static void compileTerm(Token *&tok, AST_state& state)
             prev = prev->link()->previous();
         if (Token::simpleMatch(tok->link(),"} [")) {
             tok = tok->next();
-        } else if (state.cpp && iscpp11init(tok)) {
+        } else if (state.cpp && iscpp11init(tok, &state.cpp11InitNames)) {
             if (state.op.empty() || Token::Match(tok->previous(), "[{,]"))
                 compileUnaryOp(tok, state, compileExpression);
             else
@@ -745,7 +765,7 @@ static void compilePrecedence2(Token *&tok, AST_state& state)
                     compileUnaryOp(tok, state, nullptr);
             }
             tok = tok->link()->next();
-        } else if (state.cpp && tok->str() == "{" && iscpp11init(tok)) {
+        } else if (state.cpp && tok->str() == "{" && iscpp11init(tok, &state.cpp11InitNames)) {
             if (Token::simpleMatch(tok, "{ }"))
                 compileUnaryOp(tok, state, compileExpression);
             else
@@ -1035,11 +1055,33 @@ static bool isLambdaCaptureList(const Token * tok)
 
 static Token * createAstAtToken(Token *tok, bool cpp);
 
+// Skip the comma operators above tok. The result is stored for every comma
+// so that the elements of long lists do not walk the same commas again.
+static const Token * skipCommaParents(const Token *tok, std::unordered_map<const Token *, const Token *> *parents)
+{
+    const Token *parent = tok;
+    while (Token::simpleMatch(parent, ",")) {
+        const std::unordered_map<const Token *, const Token *>::const_iterator it = parents->find(parent);
+        if (it != parents->end()) {
+            parent = it->second;
+            break;
+        }
+        parent = parent->astParent();
+    }
+    for (; Token::simpleMatch(tok, ","); tok = tok->astParent()) {
+        if (!parents->emplace(tok, parent).second)
+            break;
+    }
+    return parent;
+}
+
 // Compile inner expressions inside inner ({..}) and lambda bodies
 static void createAstAtTokenInner(Token * const tok1, const Token *endToken, bool cpp)
 {
+    Cpp11InitNames cpp11InitNames;
+    std::unordered_map<const Token *, const Token *> commaParents;
     for (Token *tok = tok1; tok && tok != endToken; tok = tok ? tok->next() : nullptr) {
-        if (tok->str() == "{" && !iscpp11init(tok)) {
+        if (tok->str() == "{" && !iscpp11init(tok, &cpp11InitNames)) {
             if (Token::simpleMatch(tok->astOperand1(), ","))
                 continue;
             if (Token::simpleMatch(tok->previous(), "( {"))
@@ -1055,9 +1097,7 @@ static void createAstAtTokenInner(Token * const tok1, const Token *endToken, boo
                 ;
             else {
                 // function argument is initializer list?
-                const Token *parent = tok->astParent();
-                while (Token::simpleMatch(parent, ","))
-                    parent = parent->astParent();
+                const Token * const parent = skipCommaParents(tok->astParent(), &commaParents);
                 if (!parent || !Token::Match(parent->previous(), "%name% ("))
                     // not function argument..
                     continue;
@@ -1232,8 +1272,10 @@ static Token * createAstAtToken(Token *tok, bool cpp)
         return endToken->previous();
     }
 
-    if (cpp && tok->str() == "{" && iscpp11init(tok)) {
+    if (cpp && tok->str() == "{") {
         AST_state state(cpp);
+        if (!iscpp11init(tok, &state.cpp11InitNames))
+            return tok;
         compileExpression(tok, state);
         return tok;
     }
@@ -1248,6 +1290,17 @@ void TokenList::createAst()
     }
 }
 
+void TokenList::createDefUseIndex()
+{
+    mTokensFrontBack.defUseIndex = nullptr;
+    mDefUseIndex.reset();
+    if (!mTokensFrontBack.front)
+        return;
+    mTokensFrontBack.front->assignIndexes();
+    mDefUseIndex.reset(new DefUseIndex(mTokensFrontBack.front, mSettings, isCPP()));
+    mTokensFrontBack.defUseIndex = mDefUseIndex.get();
+}
+
 void TokenList::validateAst() const
 {
     // Check for some known issues in AST to avoid crash/hang later on
@@ -24,6 +24,7 @@
 #include "config.h"
 #include "token.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -161,6 +162,14 @@ public:
      */
     void validateAst() const;
 
+    /**
+     * Create the index of the variable uses that isVariableChanged() uses.
+     * The AST and the symbol database must be complete. The index is
+     * dropped when tokens are added, removed or moved, and when the AST,
+     * the variables, the functions or the value types of tokens change.
+     */
+    void createDefUseIndex();
+
     /**
      * Verify that the given token is an element of the tokenlist.
      * That method is implemented for debugging purposes.
@@ -190,9 +199,15 @@ private:
     /** Disable assignment operator, no implementation */
     TokenList &operator=(const TokenList &);
 
+    /** Memory for the tokens */
+    TokenArena mTokenArena;
+
     /** Token list */
     TokensFrontBack mTokensFrontBack;
 
+    /** Uses of the variables, see createDefUseIndex() */
+    std::unique_ptr<DefUseIndex> mDefUseIndex;
+
     /** filenames for the tokenized source code (source + included) */
     std::vector<std::string> mFiles;
 
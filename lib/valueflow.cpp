@@ -89,62 +89,140 @@
 #include "tokenlist.h"
 #include "utils.h"
 #include "path.h"
+#include "timer.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <ctime>
+#include <exception>
 #include <functional>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <stack>
+#include <thread>
 #include <vector>
 
-static const int TIMEOUT = 10; // Do not repeat ValueFlow analysis more than 10 seconds
-
 namespace {
-    struct ProgramMemory {
-        std::map<unsigned int, ValueFlow::Value> values;
+    /**
+     * Values of variables when code is executed. Copies of the memory are
+     * made at every branch, so the values are kept in a shared array and
+     * a copy only copies the values that were set after the array was
+     * created.
+     */
+    class ProgramMemory {
+    public:
+        typedef std::vector<std::pair<unsigned int, ValueFlow::Value>> Values;
+
+        ProgramMemory() {}
 
         void setValue(unsigned int varid, const ValueFlow::Value &value) {
-            values[varid] = value;
+            for (std::pair<unsigned int, ValueFlow::Value> &change : mChanges) {
+                if (change.first == varid) {
+                    change.second = value;
+                    return;
+                }
+            }
+            mChanges.emplace_back(varid, value);
+            // Move the changes into a new shared array when searching them gets slow
+            if (mChanges.size() > 8U && mChanges.size() * 2U > (mValues ? mValues->size() : 0U))
+                merge();
         }
 
         bool getIntValue(unsigned int varid, MathLib::bigint* result) const {
-            const std::map<unsigned int, ValueFlow::Value>::const_iterator it = values.find(varid);
-            const bool found = it != values.end() && it->second.isIntValue();
+            const ValueFlow::Value *value = getValue(varid);
+            const bool found = value && value->isIntValue();
             if (found)
-                *result = it->second.intvalue;
+                *result = value->intvalue;
             return found;
         }
 
         void setIntValue(unsigned int varid, MathLib::bigint value) {
-            values[varid] = ValueFlow::Value(value);
+            setValue(varid, ValueFlow::Value(value));
         }
 
         bool getTokValue(unsigned int varid, const Token** result) const {
-            const std::map<unsigned int, ValueFlow::Value>::const_iterator it = values.find(varid);
-            const bool found = it != values.end() && it->second.isTokValue();
+            const ValueFlow::Value *value = getValue(varid);
+            const bool found = value && value->isTokValue();
             if (found)
-                *result = it->second.tokvalue;
+                *result = value->tokvalue;
             return found;
         }
 
-        bool hasValue(unsigned int varid) {
-            return values.find(varid) != values.end();
+        bool hasValue(unsigned int varid) const {
+            return getValue(varid) != nullptr;
         }
 
         void swap(ProgramMemory &pm) {
-            values.swap(pm.values);
+            mValues.swap(pm.mValues);
+            mChanges.swap(pm.mChanges);
         }
 
         void clear() {
-            values.clear();
+            mValues.reset();
+            mChanges.clear();
         }
 
         bool empty() const {
-            return values.empty();
+            return mChanges.empty() && !mValues;
+        }
+
+        /** All values, sorted by varid */
+        const Values &values() {
+            static const Values noValues;
+            if (!mChanges.empty())
+                merge();
+            return mValues ? *mValues : noValues;
         }
+
+    private:
+        static bool lessVarId(const std::pair<unsigned int, ValueFlow::Value> &value, unsigned int varid) {
+            return value.first < varid;
+        }
+
+        const ValueFlow::Value *getValue(unsigned int varid) const {
+            for (const std::pair<unsigned int, ValueFlow::Value> &change : mChanges) {
+                if (change.first == varid)
+                    return &change.second;
+            }
+            if (!mValues)
+                return nullptr;
+            const Values::const_iterator it = std::lower_bound(mValues->begin(), mValues->end(), varid, lessVarId);
+            return (it != mValues->end() && it->first == varid) ? &it->second : nullptr;
+        }
+
+        void merge() {
+            std::shared_ptr<Values> values = std::make_shared<Values>();
+            values->reserve((mValues ? mValues->size() : 0U) + mChanges.size());
+            std::sort(mChanges.begin(), mChanges.end(), [](const std::pair<unsigned int, ValueFlow::Value> &a, const std::pair<unsigned int, ValueFlow::Value> &b) {
+                return a.first < b.first;
+            });
+            static const Values noValues;
+            const Values &oldValues = mValues ? *mValues : noValues;
+            Values::const_iterator it = oldValues.begin();
+            const Values::const_iterator end = oldValues.end();
+            for (const std::pair<unsigned int, ValueFlow::Value> &change : mChanges) {
+                while (it != end && it->first < change.first)
+                    values->push_back(*it++);
+                if (it != end && it->first == change.first)
+                    ++it;
+                values->push_back(change);
+            }
+            while (it != end)
+                values->push_back(*it++);
+            mValues = values;
+            mChanges.clear();
+        }
+
+        /** Values sorted by varid, shared by copies of the memory */
+        std::shared_ptr<const Values> mValues;
+        /** Values that are set after mValues was created */
+        Values mChanges;
     };
 }
 
@@ -344,6 +422,19 @@ static bool bailoutSelfAssignment(const Token * const tok)
 
 static ValueFlow::Value castValue(ValueFlow::Value value, const ValueType::Sign sign, unsigned int bit)
 {
+    if (value.isIntRangeValue()) {
+        ValueFlow::Value lower(value);
+        lower.valueType = ValueFlow::Value::INT;
+        lower = castValue(lower, sign, bit);
+        ValueFlow::Value upper(value);
+        upper.valueType = ValueFlow::Value::INT;
+        upper.intvalue = value.intvalueMax;
+        upper = castValue(upper, sign, bit);
+        // values in a truncated range can't be described by its bounds => only keep lower bound
+        if (lower.intvalue != value.intvalue || upper.intvalue != value.intvalueMax)
+            return lower;
+        return value;
+    }
     if (value.isFloatValue()) {
         value.valueType = ValueFlow::Value::INT;
         if (value.floatValue >= std::numeric_limits<int>::min() && value.floatValue <= std::numeric_limits<int>::max()) {
@@ -479,7 +570,7 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
                 const Token *op = cond ? tok->astOperand1() : tok->astOperand2();
                 if (!op) // #7769 segmentation fault at setTokenValue()
                     return;
-                const std::list<ValueFlow::Value> &values = op->values();
+                const ValueFlow::ValueList &values = op->values();
                 if (std::find(values.begin(), values.end(), value) != values.end())
                     setTokenValue(parent, value, settings);
             }
@@ -516,6 +607,27 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
              parent->astOperand1() &&
              parent->astOperand2()) {
 
+        // int range +/- known int value
+        if (value.isIntRangeValue()) {
+            const Token *other = (tok == parent->astOperand1()) ? parent->astOperand2() : parent->astOperand1();
+            if (!Token::Match(parent, "+|-") || !other->hasKnownIntValue())
+                return;
+            const MathLib::bigint k = other->values().front().intvalue;
+            ValueFlow::Value result(value);
+            if (parent->str() == "+") {
+                result.intvalue = value.intvalue + k;
+                result.intvalueMax = value.intvalueMax + k;
+            } else if (tok == parent->astOperand1()) {
+                result.intvalue = value.intvalue - k;
+                result.intvalueMax = value.intvalueMax - k;
+            } else {
+                result.intvalue = k - value.intvalueMax;
+                result.intvalueMax = k - value.intvalue;
+            }
+            setTokenValue(parent, result, settings);
+            return;
+        }
+
         // known result when a operand is 0.
         if (Token::Match(parent, "[&*]") && value.isKnown() && value.isIntValue() && value.intvalue==0) {
             setTokenValue(parent, value, settings);
@@ -728,12 +840,15 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
     // unary minus
     else if (parent->isUnaryOp("-")) {
         for (const ValueFlow::Value &val : tok->values()) {
-            if (!val.isIntValue() && !val.isFloatValue())
+            if (!val.isIntValue() && !val.isIntRangeValue() && !val.isFloatValue())
                 continue;
             ValueFlow::Value v(val);
             if (v.isIntValue())
                 v.intvalue = -v.intvalue;
-            else
+            else if (v.isIntRangeValue()) {
+                v.intvalue = -val.intvalueMax;
+                v.intvalueMax = -val.intvalue;
+            } else
                 v.floatValue = -v.floatValue;
             setTokenValue(parent, v, settings);
         }
@@ -982,6 +1097,283 @@ static Token * valueFlowSetConstantValue(Token *tok, const Settings *settings, b
     return tok->next();
 }
 
+static std::size_t getTotalValues(const TokenList *tokenlist)
+{
+    std::size_t n = 1;
+    for (const Token *tok = tokenlist->front(); tok; tok = tok->next())
+        n += tok->values().size();
+    return n;
+}
+
+/** Get the outermost function scope that the given scope is nested in, nullptr if it's not in a function */
+static const Scope *getOutermostFunctionScope(const Scope *scope)
+{
+    const Scope *functionScope = nullptr;
+    for (; scope; scope = scope->nestedIn) {
+        if (scope->type == Scope::eFunction)
+            functionScope = scope;
+    }
+    return functionScope;
+}
+
+namespace {
+    /**
+     * The function scopes that are analysed in a round of the repeated
+     * ValueFlow passes. The first round analyses all function scopes. The
+     * next rounds only analyse the function scopes where values changed in
+     * the previous round. Code outside function scopes is always analysed.
+     */
+    class ValueFlowWorklist {
+    public:
+        ValueFlowWorklist(const TokenList *tokenlist, const SymbolDatabase *symboldatabase)
+            : mSymbolDatabase(symboldatabase), mFunctionScopes(symboldatabase->functionScopes), mOutsideFunctionScopes(true), mOutermostScope(nullptr), mTotalValues(getTotalValues(tokenlist)) {
+            mFunctionScopeSet.insert(mFunctionScopes.begin(), mFunctionScopes.end());
+            for (const Scope *scope : mFunctionScopes)
+                mScopeValues[scope] = countValues(scope);
+            setScopes();
+        }
+
+        const std::vector<const Scope *> &functionScopes() const {
+            return mFunctionScopes;
+        }
+
+        /** All scopes that are analysed in this round, in the order of the scope list */
+        const std::vector<const Scope *> &scopes() const {
+            return mScopes;
+        }
+
+        /** Should code in given scope be analysed in this round? */
+        bool contains(const Scope *scope) const {
+            while (scope && scope->type != Scope::eFunction)
+                scope = scope->nestedIn;
+            if (!scope)
+                return mOutsideFunctionScopes;
+            return mFunctionScopeSet.find(scope) != mFunctionScopeSet.end();
+        }
+
+        /**
+         * Split the worklist into parts that don't share tokens so they can be
+         * analysed at the same time. The first part has the code outside
+         * function scopes. Each of the other parts has the function scopes
+         * that are nested in one outermost function scope.
+         */
+        std::vector<ValueFlowWorklist> split() const {
+            std::vector<ValueFlowWorklist> parts(1, ValueFlowWorklist(mSymbolDatabase, nullptr));
+            parts[0].mOutsideFunctionScopes = mOutsideFunctionScopes;
+            std::map<const Scope *, std::size_t> partIndex;
+            for (const Scope *scope : mFunctionScopes) {
+                const Scope *outermostScope = getOutermostFunctionScope(scope);
+                const std::map<const Scope *, std::size_t>::const_iterator it = partIndex.find(outermostScope);
+                std::size_t index;
+                if (it != partIndex.end()) {
+                    index = it->second;
+                } else {
+                    index = parts.size();
+                    partIndex[outermostScope] = index;
+                    parts.push_back(ValueFlowWorklist(mSymbolDatabase, outermostScope));
+                }
+                parts[index].mFunctionScopes.push_back(scope);
+                parts[index].mFunctionScopeSet.insert(scope);
+            }
+            for (const Scope *scope : mScopes) {
+                const Scope *outermostScope = getOutermostFunctionScope(scope);
+                parts[outermostScope ? partIndex[outermostScope] : 0].mScopes.push_back(scope);
+            }
+            return parts;
+        }
+
+        /** Outermost function scope of a part of a split worklist */
+        const Scope *outermostScope() const {
+            return mOutermostScope;
+        }
+
+        /**
+         * Count the values after a round and select the function scopes
+         * where values changed for the next round.
+         * @return true if values were added
+         */
+        bool update(const TokenList *tokenlist) {
+            mFunctionScopes.clear();
+            mFunctionScopeSet.clear();
+            for (const Scope *scope : mSymbolDatabase->functionScopes) {
+                const std::size_t values = countValues(scope);
+                std::size_t &previous = mScopeValues[scope];
+                if (values != previous) {
+                    mFunctionScopes.push_back(scope);
+                    mFunctionScopeSet.insert(scope);
+                    previous = values;
+                }
+            }
+            setScopes();
+            const std::size_t previous = mTotalValues;
+            mTotalValues = getTotalValues(tokenlist);
+            return previous < mTotalValues;
+        }
+
+    private:
+        ValueFlowWorklist(const SymbolDatabase *symboldatabase, const Scope *outermostScope)
+            : mSymbolDatabase(symboldatabase), mOutsideFunctionScopes(false), mOutermostScope(outermostScope), mTotalValues(0) {
+        }
+
+        static std::size_t countValues(const Scope *scope) {
+            std::size_t values = 0;
+            for (const Token *tok = scope->bodyStart; tok != scope->bodyEnd; tok = tok->next())
+                values += tok->values().size();
+            return values;
+        }
+
+        void setScopes() {
+            mScopes.clear();
+            for (const Scope &scope : mSymbolDatabase->scopeList) {
+                if (contains(&scope))
+                    mScopes.push_back(&scope);
+            }
+        }
+
+        const SymbolDatabase *mSymbolDatabase;
+        std::vector<const Scope *> mFunctionScopes;
+        std::set<const Scope *> mFunctionScopeSet;
+        std::vector<const Scope *> mScopes;
+        bool mOutsideFunctionScopes;
+        const Scope *mOutermostScope;
+        /** Number of values in each function scope after the previous round */
+        std::map<const Scope *, std::size_t> mScopeValues;
+        std::size_t mTotalValues;
+    };
+}
+
+namespace {
+    /**
+     * Analysis of a part of a split worklist on a worker thread. The
+     * messages are reported when all parts are analysed so the output
+     * doesn't depend on the scheduling of the threads.
+     */
+    class ValueFlowPart : public ErrorLogger {
+    public:
+        ValueFlowPart() : worklist(nullptr) {}
+
+        void reportOut(const std::string &outmsg) OVERRIDE {
+            messages.emplace_back(true, outmsg, ErrorLogger::ErrorMessage());
+        }
+
+        void reportErr(const ErrorLogger::ErrorMessage &msg) OVERRIDE {
+            messages.emplace_back(false, emptyString, msg);
+        }
+
+        /** Report the messages and rethrow the exception of the analysis */
+        void finish(ErrorLogger *errorLogger) const {
+            if (errorLogger) {
+                for (const Message &message : messages) {
+                    if (message.out)
+                        errorLogger->reportOut(message.outmsg);
+                    else
+                        errorLogger->reportErr(message.msg);
+                }
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        const ValueFlowWorklist *worklist;
+
+        /**
+         * Function calls whose lifetime values depend on the values of a
+         * function in another part. They are analysed after the parts.
+         */
+        std::vector<Token *> lifetimeCalls;
+
+        std::exception_ptr error;
+
+    private:
+        struct Message {
+            Message(bool o, const std::string &s, const ErrorLogger::ErrorMessage &m) : out(o), outmsg(s), msg(m) {}
+            bool out;
+            std::string outmsg;
+            ErrorLogger::ErrorMessage msg;
+        };
+        std::vector<Message> messages;
+    };
+}
+
+namespace {
+    /**
+     * Worker threads that are kept for the whole run, so that the passes
+     * don't start new threads in every round of every configuration.
+     * Several configurations can use the pool at the same time.
+     */
+    class ValueFlowThreadPool {
+    public:
+        ValueFlowThreadPool() : mStop(false) {}
+
+        ~ValueFlowThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStop = true;
+            }
+            mWakeUp.notify_all();
+            for (std::thread &t : mThreads)
+                t.join();
+        }
+
+        /**
+         * Run work on the calling thread and on up to threads-1 pool threads.
+         * Returns when all of them are done. Pool threads that are busy with
+         * other work are not waited for.
+         */
+        void run(std::size_t threads, const std::function<void()> &work) {
+            std::size_t running = 0;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                while (mThreads.size() + 1 < threads)
+                    mThreads.emplace_back(&ValueFlowThreadPool::worker, this);
+                for (std::size_t i = 1; i < threads; ++i)
+                    mTasks.push_back(Task{&work, &running});
+            }
+            mWakeUp.notify_all();
+
+            work();
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mTasks.erase(std::remove_if(mTasks.begin(), mTasks.end(), [&](const Task &task) {
+                return task.running == &running;
+            }), mTasks.end());
+            mDone.wait(lock, [&] { return running == 0; });
+        }
+
+    private:
+        struct Task {
+            const std::function<void()> *work;
+            std::size_t *running;
+        };
+
+        void worker() {
+            std::unique_lock<std::mutex> lock(mMutex);
+            for (;;) {
+                mWakeUp.wait(lock, [this] { return mStop || !mTasks.empty(); });
+                if (mStop)
+                    return;
+                const Task task = mTasks.front();
+                mTasks.erase(mTasks.begin());
+                ++*task.running;
+                lock.unlock();
+                (*task.work)();
+                lock.lock();
+                --*task.running;
+                mDone.notify_all();
+            }
+        }
+
+        std::mutex mMutex;
+        std::condition_variable mWakeUp;
+        std::condition_variable mDone;
+        std::vector<std::thread> mThreads;
+        std::vector<Task> mTasks;
+        bool mStop;
+    };
+}
+
+/** The part that the current thread analyses, nullptr if the passes don't run concurrently */
+static thread_local ValueFlowPart *currentValueFlowPart = nullptr;
 
 static void valueFlowNumber(TokenList *tokenlist)
 {
@@ -1097,7 +1489,7 @@ static void valueFlowArrayBool(TokenList *tokenlist)
             continue;
         const Variable *var = nullptr;
         bool known = false;
-        std::list<ValueFlow::Value>::const_iterator val =
+        ValueFlow::ValueList::const_iterator val =
             std::find_if(tok->values().begin(), tok->values().end(), std::mem_fn(&ValueFlow::Value::isTokValue));
         if (val == tok->values().end()) {
             var = tok->variable();
@@ -1215,7 +1607,9 @@ static void valueFlowSameExpressions(TokenList *tokenlist)
         if (!val.isKnown())
             continue;
 
-        if (isSameExpression(tokenlist->isCPP(), false, tok->astOperand1(), tok->astOperand2(), tokenlist->getSettings()->library, true, true, &val.errorPath)) {
+        ErrorPath errorPath;
+        if (isSameExpression(tokenlist->isCPP(), false, tok->astOperand1(), tok->astOperand2(), tokenlist->getSettings()->library, true, true, &errorPath)) {
+            val.errorPath = errorPath;
             setTokenValue(tok, val, tokenlist->getSettings());
         }
     }
@@ -1430,12 +1824,12 @@ static void valueFlowRightShift(TokenList *tokenList, const Settings* settings)
     }
 }
 
-static void valueFlowOppositeCondition(SymbolDatabase *symboldatabase, const Settings *settings)
+static void valueFlowOppositeCondition(SymbolDatabase *symboldatabase, const ValueFlowWorklist &worklist, const Settings *settings)
 {
-    for (const Scope &scope : symboldatabase->scopeList) {
-        if (scope.type != Scope::eIf)
+    for (const Scope *scope : worklist.scopes()) {
+        if (scope->type != Scope::eIf)
             continue;
-        Token *tok = const_cast<Token *>(scope.classDef);
+        Token *tok = const_cast<Token *>(scope->classDef);
         if (!Token::simpleMatch(tok, "if ("))
             continue;
         const Token *cond1 = tok->next()->astOperand2();
@@ -1588,6 +1982,7 @@ static void valueFlowReverse(TokenList *tokenlist,
             }
             if (inc != 0) {
                 val.intvalue += inc;
+                val.intvalueMax += inc;
                 const std::string info(tok2->str() + " is " + std::string(inc==1 ? "decremented" : "incremented") + ", before this " + (inc==1?"decrement":"increment") + " the value is " + val.infoString());
                 val.errorPath.emplace_back(tok2, info);
             }
@@ -1602,11 +1997,13 @@ static void valueFlowReverse(TokenList *tokenlist,
                     break;
                 }
                 const MathLib::bigint rhsValue =  rhsToken->values().front().intvalue;
-                if (assignToken->str() == "+=")
+                if (assignToken->str() == "+=") {
                     val.intvalue -= rhsValue;
-                else if (assignToken->str() == "-=")
+                    val.intvalueMax -= rhsValue;
+                } else if (assignToken->str() == "-=") {
                     val.intvalue += rhsValue;
-                else if (assignToken->str() == "*=" && rhsValue != 0)
+                    val.intvalueMax += rhsValue;
+                } else if (assignToken->str() == "*=" && rhsValue != 0 && !val.isIntRangeValue())
                     val.intvalue /= rhsValue;
                 else {
                     if (settings->debugwarnings)
@@ -1667,7 +2064,7 @@ static void valueFlowReverse(TokenList *tokenlist,
                             continue;
                         ProgramMemory programMemory;
                         programMemory.setIntValue(varid, num);
-                        if (conditionIsTrue(iftok->next()->astOperand2(), programMemory)) {
+                        if (val.isIntRangeValue() || conditionIsTrue(iftok->next()->astOperand2(), programMemory)) {
                             breakBailout = true;
                             break;
                         }
@@ -1703,7 +2100,7 @@ static void valueFlowReverse(TokenList *tokenlist,
 
         if (tok2->str() == "}") {
             const Token *vartok = Token::findmatch(tok2->link(), "%varid%", tok2, varid);
-            while (Token::Match(vartok, "%name% = %num% ;") && !vartok->tokAt(2)->getValue(num))
+            while (!val.isIntRangeValue() && Token::Match(vartok, "%name% = %num% ;") && !vartok->tokAt(2)->getValue(num))
                 vartok = Token::findmatch(vartok->next(), "%varid%", tok2, varid);
             if (vartok) {
                 if (settings->debugwarnings) {
@@ -1762,9 +2159,9 @@ static void valueFlowReverse(TokenList *tokenlist,
     }
 }
 
-static void valueFlowBeforeCondition(TokenList *tokenlist, SymbolDatabase *symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowBeforeCondition(TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger *errorLogger, const Settings *settings)
 {
-    for (const Scope * scope : symboldatabase->functionScopes) {
+    for (const Scope * scope : worklist.functionScopes()) {
         for (Token* tok = const_cast<Token*>(scope->bodyStart); tok != scope->bodyEnd; tok = tok->next()) {
             MathLib::bigint num = 0;
             const Token *vartok = nullptr;
@@ -1886,7 +2283,7 @@ static void valueFlowAST(Token *tok, unsigned int varid, const ValueFlow::Value
         if (conditionIsFalse(tok->astOperand1(), pm))
             return;
     } else if (tok->str() == "||" && tok->astOperand1()) {
-        const std::list<ValueFlow::Value> &values = tok->astOperand1()->values();
+        const ValueFlow::ValueList &values = tok->astOperand1()->values();
         const bool nonzero = std::any_of(values.cbegin(), values.cend(),
         [=](const ValueFlow::Value &v) {
             return v.intvalue != 0;
@@ -1950,6 +2347,15 @@ static bool evalAssignment(ValueFlow::Value &lhsValue, const std::string &assign
             lhsValue.intvalue ^= rhsValue.intvalue;
         else
             return false;
+    } else if (lhsValue.isIntRangeValue()) {
+        if (assign == "+=") {
+            lhsValue.intvalue += rhsValue.intvalue;
+            lhsValue.intvalueMax += rhsValue.intvalue;
+        } else if (assign == "-=") {
+            lhsValue.intvalue -= rhsValue.intvalue;
+            lhsValue.intvalueMax -= rhsValue.intvalue;
+        } else
+            return false;
     } else if (lhsValue.isFloatValue()) {
         if (assign == "+=")
             lhsValue.floatValue += rhsValue.intvalue;
@@ -1967,6 +2373,24 @@ static bool evalAssignment(ValueFlow::Value &lhsValue, const std::string &assign
     return true;
 }
 
+/**
+ * Int ranges are not split by conditions. Stop tracking them when the variable
+ * is checked in the condition, the condition might exclude some values.
+ */
+static void removeIntRangeValues(const Token *condition, unsigned int varid, std::list<ValueFlow::Value> &values)
+{
+    if (std::none_of(values.cbegin(), values.cend(), std::mem_fn(&ValueFlow::Value::isIntRangeValue)))
+        return;
+    bool checked = false;
+    visitAstNodes(condition,
+    [&](const Token *tok) {
+        checked = (tok->varId() == varid);
+        return checked ? ChildrenToVisit::done : ChildrenToVisit::op1_and_op2;
+    });
+    if (checked)
+        values.remove_if(std::mem_fn(&ValueFlow::Value::isIntRangeValue));
+}
+
 static bool valueFlowForward(Token * const               startToken,
                              const Token * const         endToken,
                              const Variable * const      var,
@@ -2121,6 +2545,9 @@ static bool valueFlowForward(Token * const               startToken,
             }
 
             const Token * const condTok = tok2->next()->astOperand2();
+            removeIntRangeValues(condTok, varid, values);
+            if (values.empty())
+                return true;
             const bool condAlwaysTrue = (condTok && condTok->hasKnownIntValue() && condTok->values().front().intvalue != 0);
             const bool condAlwaysFalse = (condTok && condTok->hasKnownIntValue() && condTok->values().front().intvalue == 0);
 
@@ -2339,6 +2766,7 @@ static bool valueFlowForward(Token * const               startToken,
         else if (Token::Match(tok2, "assert|ASSERT (") && Token::simpleMatch(tok2->linkAt(1), ") ;")) {
             const Token * const arg = tok2->next()->astOperand2();
             if (arg != nullptr && arg->str() != ",") {
+                removeIntRangeValues(arg, varid, values);
                 // Should scope be skipped because variable value is checked?
                 for (std::list<ValueFlow::Value>::iterator it = values.begin(); it != values.end();) {
                     if (conditionIsFalse(arg, getProgramMemory(tok2, varid, *it)))
@@ -2417,6 +2845,7 @@ static bool valueFlowForward(Token * const               startToken,
                 if (isVariableChangedByFunctionCall(expr, varid, settings, nullptr))
                     changeKnownToPossible(values);
             } else {
+                removeIntRangeValues(condition, varid, values);
                 for (const ValueFlow::Value &v : values) {
                     const ProgramMemory programMemory(getProgramMemory(tok2, varid, v));
                     if (conditionIsTrue(condition, programMemory))
@@ -2570,7 +2999,7 @@ static bool valueFlowForward(Token * const               startToken,
                 std::list<ValueFlow::Value>::iterator it;
                 // Erase values that are not int values..
                 for (it = values.begin(); it != values.end();) {
-                    if (!it->isIntValue())
+                    if (!it->isIntValue() && !it->isIntRangeValue())
                         it = values.erase(it);
                     else
                         ++it;
@@ -2588,6 +3017,7 @@ static bool valueFlowForward(Token * const               startToken,
                     if (!pre)
                         setTokenValue(op, *it, settings);
                     it->intvalue += (inc ? 1 : -1);
+                    it->intvalueMax += (inc ? 1 : -1);
                     if (pre)
                         setTokenValue(op, *it, settings);
                     const std::string info(tok2->str() + " is " + std::string(inc ? "incremented" : "decremented") + "', new value is " + it->infoString());
@@ -2797,7 +3227,7 @@ static const Token *getLifetimeToken(const Token *tok, ValueFlow::Value::ErrorPa
             for (const ValueFlow::Value &v : vartok->values()) {
                 if (!v.isLocalLifetimeValue())
                     continue;
-                errorPath.insert(errorPath.end(), v.errorPath.begin(), v.errorPath.end());
+                errorPath.splice(errorPath.end(), ErrorPath(v.errorPath));
                 return getLifetimeToken(v.tokvalue, errorPath);
             }
         } else {
@@ -3177,6 +3607,11 @@ static void valueFlowLifetimeFunction(Token *tok, TokenList *tokenlist, ErrorLog
         const Token *returnTok = findSimpleReturn(f);
         if (!returnTok)
             return;
+        // The values of a function in another part can't be read while the parts are analysed
+        if (currentValueFlowPart && getOutermostFunctionScope(returnTok->scope()) != currentValueFlowPart->worklist->outermostScope()) {
+            currentValueFlowPart->lifetimeCalls.push_back(tok);
+            return;
+        }
         for (const ValueFlow::Value &v : returnTok->values()) {
             if (!v.isLifetimeValue())
                 continue;
@@ -3478,11 +3913,13 @@ static const Token * findEndOfFunctionCallForParameter(const Token * parameterTo
     return nextAfterAstRightmostLeaf(parent);
 }
 
-static void valueFlowAfterMove(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowAfterMove(TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger *errorLogger, const Settings *settings)
 {
     if (!tokenlist->isCPP() || settings->standards.cpp < Standards::CPP11)
         return;
-    for (const Scope * scope : symboldatabase->functionScopes) {
+    if (!(settings->analysis & Settings::MOVED_VALUES))
+        return;
+    for (const Scope * scope : worklist.functionScopes()) {
         if (!scope)
             continue;
         const Token * start = scope->bodyStart;
@@ -3636,9 +4073,9 @@ static std::list<ValueFlow::Value> truncateValues(std::list<ValueFlow::Value> va
     return values;
 }
 
-static void valueFlowAfterAssign(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowAfterAssign(TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger *errorLogger, const Settings *settings)
 {
-    for (const Scope * scope : symboldatabase->functionScopes) {
+    for (const Scope * scope : worklist.functionScopes()) {
         std::set<unsigned int> aliased;
         for (Token* tok = const_cast<Token*>(scope->bodyStart); tok != scope->bodyEnd; tok = tok->next()) {
             // Alias
@@ -3686,10 +4123,10 @@ struct ValueFlowConditionHandler {
     std::function<Condition(Token *tok)> parse;
 
     void afterCondition(TokenList *tokenlist,
-                        SymbolDatabase *symboldatabase,
+                        const ValueFlowWorklist &worklist,
                         ErrorLogger *errorLogger,
                         const Settings *settings) const {
-        for (const Scope *scope : symboldatabase->functionScopes) {
+        for (const Scope *scope : worklist.functionScopes()) {
             std::set<unsigned> aliased;
             for (Token *tok = const_cast<Token *>(scope->bodyStart); tok != scope->bodyEnd; tok = tok->next()) {
                 if (Token::Match(tok, "= & %var% ;"))
@@ -3907,7 +4344,7 @@ static const Token *parseCompareInt(const Token *tok, ValueFlow::Value &true_val
 }
 
 static void valueFlowAfterCondition(TokenList *tokenlist,
-                                    SymbolDatabase *symboldatabase,
+                                    const ValueFlowWorklist &worklist,
                                     ErrorLogger *errorLogger,
                                     const Settings *settings)
 {
@@ -3953,200 +4390,417 @@ static void valueFlowAfterCondition(TokenList *tokenlist,
 
         return cond;
     };
-    handler.afterCondition(tokenlist, symboldatabase, errorLogger, settings);
+    handler.afterCondition(tokenlist, worklist, errorLogger, settings);
 }
 
-static void execute(const Token *expr,
-                    ProgramMemory * const programMemory,
-                    MathLib::bigint *result,
-                    bool *error)
-{
-    if (!expr)
-        *error = true;
-
-    else if (expr->hasKnownIntValue()) {
-        *result = expr->values().front().intvalue;
-    }
-
-    else if (expr->isNumber()) {
-        *result = MathLib::toLongNumber(expr->str());
-        if (MathLib::isFloat(expr->str()))
-            *error = true;
-    }
+namespace {
+    /**
+     * An AST expression that is compiled once so it can be executed
+     * many times. The token strings are converted to operation codes and
+     * the known values are looked up during compilation.
+     */
+    class CompiledExpression {
+    public:
+        explicit CompiledExpression(const Token *expr) {
+            compile(expr);
+        }
+
+        void execute(ProgramMemory * const programMemory, MathLib::bigint *result, bool *error) const {
+            execute(0, programMemory, result, error);
+        }
+
+    private:
+        enum class Op {
+            Error, Constant, FloatConstant, Variable,
+            Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual,
+            Assign, Increment, Decrement,
+            Add, Sub, Mul, Div, Mod, ShiftLeft, ShiftRight,
+            BitAnd, BitOr, BitXor,
+            LogicalAnd, LogicalOr, Not, Comma, Subscript,
+            None
+        };
+
+        struct Instruction {
+            Op op;
+            /** Assignment: operation of compound assignment, None for "=" */
+            Op assignOp;
+            unsigned int varid;
+            /** Decrement: variable is unsigned */
+            bool isUnsigned;
+            MathLib::bigint value;
+            /** Subscript: token value of the array when it is not in program memory */
+            const Token *tokvalue;
+            std::size_t operand1;
+            std::size_t operand2;
+        };
+
+        static Op arithmeticOp(const std::string &str) {
+            if (str == "+")
+                return Op::Add;
+            if (str == "-")
+                return Op::Sub;
+            if (str == "*")
+                return Op::Mul;
+            if (str == "/")
+                return Op::Div;
+            if (str == "%")
+                return Op::Mod;
+            if (str == "<<")
+                return Op::ShiftLeft;
+            if (str == ">>")
+                return Op::ShiftRight;
+            return Op::None;
+        }
+
+        static Op comparisonOp(const std::string &str) {
+            if (str == "<")
+                return Op::Less;
+            if (str == "<=")
+                return Op::LessEqual;
+            if (str == ">")
+                return Op::Greater;
+            if (str == ">=")
+                return Op::GreaterEqual;
+            if (str == "==")
+                return Op::Equal;
+            return Op::NotEqual;
+        }
+
+        std::size_t add(Op op) {
+            const Instruction instruction = { op, Op::None, 0U, false, 0, nullptr, 0U, 0U };
+            mCode.push_back(instruction);
+            return mCode.size() - 1U;
+        }
+
+        std::size_t compile(const Token *expr) {
+            if (!expr)
+                return add(Op::Error);
+
+            if (expr->hasKnownIntValue()) {
+                const std::size_t i = add(Op::Constant);
+                mCode[i].value = expr->values().front().intvalue;
+                return i;
+            }
 
-    else if (expr->varId() > 0) {
-        if (!programMemory->getIntValue(expr->varId(), result))
-            *error = true;
-    }
+            if (expr->isNumber()) {
+                const std::size_t i = add(MathLib::isFloat(expr->str()) ? Op::FloatConstant : Op::Constant);
+                mCode[i].value = MathLib::toLongNumber(expr->str());
+                return i;
+            }
 
-    else if (expr->isComparisonOp()) {
-        MathLib::bigint result1(0), result2(0);
-        execute(expr->astOperand1(), programMemory, &result1, error);
-        execute(expr->astOperand2(), programMemory, &result2, error);
-        if (expr->str() == "<")
-            *result = result1 < result2;
-        else if (expr->str() == "<=")
-            *result = result1 <= result2;
-        else if (expr->str() == ">")
-            *result = result1 > result2;
-        else if (expr->str() == ">=")
-            *result = result1 >= result2;
-        else if (expr->str() == "==")
-            *result = result1 == result2;
-        else if (expr->str() == "!=")
-            *result = result1 != result2;
-    }
+            if (expr->varId() > 0) {
+                const std::size_t i = add(Op::Variable);
+                mCode[i].varid = expr->varId();
+                return i;
+            }
 
-    else if (expr->isAssignmentOp()) {
-        execute(expr->astOperand2(), programMemory, result, error);
-        if (!expr->astOperand1() || !expr->astOperand1()->varId())
-            *error = true;
-        if (*error)
-            return;
+            std::size_t i;
+            if (expr->isComparisonOp())
+                i = add(comparisonOp(expr->str()));
+            else if (expr->isAssignmentOp()) {
+                i = add(Op::Assign);
+                if (expr->str() == "&=")
+                    mCode[i].assignOp = Op::BitAnd;
+                else if (expr->str() == "|=")
+                    mCode[i].assignOp = Op::BitOr;
+                else if (expr->str() == "^=")
+                    mCode[i].assignOp = Op::BitXor;
+                else if (expr->str() == "<<=" || expr->str() == ">>=")
+                    mCode[i].assignOp = Op::Error; // the variable is not changed
+                else if (expr->str() != "=")
+                    mCode[i].assignOp = arithmeticOp(expr->str().substr(0, 1));
+                mCode[i].varid = expr->astOperand1() ? expr->astOperand1()->varId() : 0U;
+                const std::size_t operand2 = compile(expr->astOperand2());
+                mCode[i].operand2 = operand2;
+                return i;
+            } else if (Token::Match(expr, "++|--")) {
+                i = add(expr->str() == "++" ? Op::Increment : Op::Decrement);
+                const Token *vartok = expr->astOperand1();
+                if (!vartok || vartok->varId() == 0U)
+                    mCode[i].op = Op::Error;
+                else {
+                    mCode[i].varid = vartok->varId();
+                    mCode[i].isUnsigned = vartok->variable() && vartok->variable()->typeStartToken()->isUnsigned();
+                }
+                return i;
+            } else if (expr->isArithmeticalOp() && expr->astOperand1() && expr->astOperand2())
+                i = add(arithmeticOp(expr->str()));
+            else if (expr->str() == "&&")
+                i = add(Op::LogicalAnd);
+            else if (expr->str() == "||")
+                i = add(Op::LogicalOr);
+            else if (expr->str() == "!") {
+                i = add(Op::Not);
+                const std::size_t operand1 = compile(expr->astOperand1());
+                mCode[i].operand1 = operand1;
+                return i;
+            } else if (expr->str() == "," && expr->astOperand1() && expr->astOperand2())
+                i = add(Op::Comma);
+            else if (expr->str() == "[" && expr->astOperand1() && expr->astOperand2()) {
+                i = add(Op::Subscript);
+                mCode[i].varid = expr->astOperand1()->varId();
+                auto tokvalue_it = std::find_if(expr->astOperand1()->values().begin(),
+                                                expr->astOperand1()->values().end(),
+                                                std::mem_fn(&ValueFlow::Value::isTokValue));
+                if (tokvalue_it != expr->astOperand1()->values().end())
+                    mCode[i].tokvalue = tokvalue_it->tokvalue;
+                const std::size_t operand2 = compile(expr->astOperand2());
+                mCode[i].operand2 = operand2;
+                return i;
+            } else
+                return add(Op::Error);
 
-        if (expr->str() == "=") {
-            programMemory->setIntValue(expr->astOperand1()->varId(), *result);
-            return;
+            const std::size_t operand1 = compile(expr->astOperand1());
+            const std::size_t operand2 = compile(expr->astOperand2());
+            mCode[i].operand1 = operand1;
+            mCode[i].operand2 = operand2;
+            return i;
         }
 
-        long long intValue;
-        if (!programMemory->getIntValue(expr->astOperand1()->varId(), &intValue)) {
-            *error = true;
-            return;
+        static bool arithmetic(Op op, MathLib::bigint value1, MathLib::bigint value2, MathLib::bigint *result) {
+            switch (op) {
+            case Op::Add:
+                *result = value1 + value2;
+                return true;
+            case Op::Sub:
+                *result = value1 - value2;
+                return true;
+            case Op::Mul:
+                if (value2 && (value1 > std::numeric_limits<MathLib::bigint>::max()/value2))
+                    return false;
+                *result = value1 * value2;
+                return true;
+            default:
+                break;
+            }
+            if (value2 == 0)
+                return false;
+            switch (op) {
+            case Op::Div:
+                *result = value1 / value2;
+                break;
+            case Op::Mod:
+                *result = value1 % value2;
+                break;
+            case Op::ShiftLeft:
+                if (value2 < 0 || value1 < 0 || value2 >= MathLib::bigint_bits) // don't perform UB
+                    return false;
+                *result = value1 << value2;
+                break;
+            case Op::ShiftRight:
+                if (value2 < 0) // don't perform UB
+                    return false;
+                *result = value1 >> value2;
+                break;
+            default:
+                break;
+            }
+            return true;
         }
-        if (expr->str() == "+=")
-            programMemory->setIntValue(expr->astOperand1()->varId(), intValue + *result);
-        else if (expr->str() == "-=")
-            programMemory->setIntValue(expr->astOperand1()->varId(), intValue - *result);
-        else if (expr->str() == "*=")
-            programMemory->setIntValue(expr->astOperand1()->varId(), intValue * *result);
-        else if (expr->str() == "/=" && *result != 0)
-            programMemory->setIntValue(expr->astOperand1()->varId(), intValue / *result);
-        else if (expr->str() == "%=" && *result != 0)
-            programMemory->setIntValue(expr->astOperand1()->varId(), intValue % *result);
-        else if (expr->str() == "&=")
-            programMemory->setIntValue(expr->astOperand1()->varId(), intValue & *result);
-        else if (expr->str() == "|=")
-            programMemory->setIntValue(expr->astOperand1()->varId(), intValue | *result);
-        else if (expr->str() == "^=")
-            programMemory->setIntValue(expr->astOperand1()->varId(), intValue ^ *result);
-    }
 
-    else if (Token::Match(expr, "++|--")) {
-        if (!expr->astOperand1() || expr->astOperand1()->varId() == 0U)
-            *error = true;
-        else {
-            long long intValue;
-            if (!programMemory->getIntValue(expr->astOperand1()->varId(), &intValue))
+        void execute(std::size_t pc, ProgramMemory * const programMemory, MathLib::bigint *result, bool *error) const {
+            const Instruction &instruction = mCode[pc];
+            switch (instruction.op) {
+            case Op::Error:
+            case Op::None:
+            case Op::BitAnd:
+            case Op::BitOr:
+            case Op::BitXor:
                 *error = true;
-            else {
-                if (intValue == 0 &&
-                    expr->str() == "--" &&
-                    expr->astOperand1()->variable() &&
-                    expr->astOperand1()->variable()->typeStartToken()->isUnsigned())
-                    *error = true; // overflow
-                *result = intValue + (expr->str() == "++" ? 1 : -1);
-                programMemory->setIntValue(expr->astOperand1()->varId(), *result);
-            }
-        }
-    }
+                break;
+
+            case Op::Constant:
+                *result = instruction.value;
+                break;
 
-    else if (expr->isArithmeticalOp() && expr->astOperand1() && expr->astOperand2()) {
-        MathLib::bigint result1(0), result2(0);
-        execute(expr->astOperand1(), programMemory, &result1, error);
-        execute(expr->astOperand2(), programMemory, &result2, error);
-        if (expr->str() == "+")
-            *result = result1 + result2;
-        else if (expr->str() == "-")
-            *result = result1 - result2;
-        else if (expr->str() == "*") {
-            if (result2 && (result1 > std::numeric_limits<MathLib::bigint>::max()/result2))
+            case Op::FloatConstant:
+                *result = instruction.value;
                 *error = true;
-            else
-                *result = result1 * result2;
-        } else if (result2 == 0)
-            *error = true;
-        else if (expr->str() == "/")
-            *result = result1 / result2;
-        else if (expr->str() == "%")
-            *result = result1 % result2;
-        else if (expr->str() == "<<")  {
-            if (result2 < 0 || result1 < 0 || result2 >= MathLib::bigint_bits)  { // don't perform UB
-                *error= true;
-            } else {
-                *result = result1 << result2;
+                break;
+
+            case Op::Variable:
+                if (!programMemory->getIntValue(instruction.varid, result))
+                    *error = true;
+                break;
+
+            case Op::Less:
+            case Op::LessEqual:
+            case Op::Greater:
+            case Op::GreaterEqual:
+            case Op::Equal:
+            case Op::NotEqual: {
+                MathLib::bigint result1(0), result2(0);
+                execute(instruction.operand1, programMemory, &result1, error);
+                execute(instruction.operand2, programMemory, &result2, error);
+                switch (instruction.op) {
+                case Op::Less:
+                    *result = result1 < result2;
+                    break;
+                case Op::LessEqual:
+                    *result = result1 <= result2;
+                    break;
+                case Op::Greater:
+                    *result = result1 > result2;
+                    break;
+                case Op::GreaterEqual:
+                    *result = result1 >= result2;
+                    break;
+                case Op::Equal:
+                    *result = result1 == result2;
+                    break;
+                default:
+                    *result = result1 != result2;
+                    break;
+                }
+                break;
             }
-        } else if (expr->str() == ">>") {
-            if (result2 < 0) { // don't perform UB
-                *error=true;
-            } else {
-                *result = result1 >> result2;
+
+            case Op::Assign: {
+                execute(instruction.operand2, programMemory, result, error);
+                if (!instruction.varid)
+                    *error = true;
+                if (*error)
+                    break;
+
+                if (instruction.assignOp == Op::None) {
+                    programMemory->setIntValue(instruction.varid, *result);
+                    break;
+                }
+
+                long long intValue;
+                if (!programMemory->getIntValue(instruction.varid, &intValue)) {
+                    *error = true;
+                    break;
+                }
+                switch (instruction.assignOp) {
+                case Op::Add:
+                    programMemory->setIntValue(instruction.varid, intValue + *result);
+                    break;
+                case Op::Sub:
+                    programMemory->setIntValue(instruction.varid, intValue - *result);
+                    break;
+                case Op::Mul:
+                    programMemory->setIntValue(instruction.varid, intValue * *result);
+                    break;
+                case Op::Div:
+                    if (*result != 0)
+                        programMemory->setIntValue(instruction.varid, intValue / *result);
+                    break;
+                case Op::Mod:
+                    if (*result != 0)
+                        programMemory->setIntValue(instruction.varid, intValue % *result);
+                    break;
+                case Op::BitAnd:
+                    programMemory->setIntValue(instruction.varid, intValue & *result);
+                    break;
+                case Op::BitOr:
+                    programMemory->setIntValue(instruction.varid, intValue | *result);
+                    break;
+                case Op::BitXor:
+                    programMemory->setIntValue(instruction.varid, intValue ^ *result);
+                    break;
+                default:
+                    break;
+                }
+                break;
             }
-        }
-    }
 
-    else if (expr->str() == "&&") {
-        bool error1 = false;
-        execute(expr->astOperand1(), programMemory, result, &error1);
-        if (!error1 && *result == 0)
-            *result = 0;
-        else {
-            bool error2 = false;
-            execute(expr->astOperand2(), programMemory, result, &error2);
-            if (error1 && error2)
-                *error = true;
-            if (error2)
-                *result = 1;
-            else
-                *result = !!*result;
-        }
-    }
+            case Op::Increment:
+            case Op::Decrement: {
+                long long intValue;
+                if (!programMemory->getIntValue(instruction.varid, &intValue)) {
+                    *error = true;
+                    break;
+                }
+                if (intValue == 0 && instruction.op == Op::Decrement && instruction.isUnsigned)
+                    *error = true; // overflow
+                *result = intValue + (instruction.op == Op::Increment ? 1 : -1);
+                programMemory->setIntValue(instruction.varid, *result);
+                break;
+            }
 
-    else if (expr->str() == "||") {
-        execute(expr->astOperand1(), programMemory, result, error);
-        if (*result == 0 && *error == false)
-            execute(expr->astOperand2(), programMemory, result, error);
-    }
+            case Op::Add:
+            case Op::Sub:
+            case Op::Mul:
+            case Op::Div:
+            case Op::Mod:
+            case Op::ShiftLeft:
+            case Op::ShiftRight: {
+                MathLib::bigint result1(0), result2(0);
+                execute(instruction.operand1, programMemory, &result1, error);
+                execute(instruction.operand2, programMemory, &result2, error);
+                if (!arithmetic(instruction.op, result1, result2, result))
+                    *error = true;
+                break;
+            }
 
-    else if (expr->str() == "!") {
-        execute(expr->astOperand1(), programMemory, result, error);
-        *result = !(*result);
-    }
+            case Op::LogicalAnd: {
+                bool error1 = false;
+                execute(instruction.operand1, programMemory, result, &error1);
+                if (!error1 && *result == 0)
+                    *result = 0;
+                else {
+                    bool error2 = false;
+                    execute(instruction.operand2, programMemory, result, &error2);
+                    if (error1 && error2)
+                        *error = true;
+                    if (error2)
+                        *result = 1;
+                    else
+                        *result = !!*result;
+                }
+                break;
+            }
 
-    else if (expr->str() == "," && expr->astOperand1() && expr->astOperand2()) {
-        execute(expr->astOperand1(), programMemory, result, error);
-        execute(expr->astOperand2(), programMemory, result, error);
-    }
+            case Op::LogicalOr:
+                execute(instruction.operand1, programMemory, result, error);
+                if (*result == 0 && *error == false)
+                    execute(instruction.operand2, programMemory, result, error);
+                break;
 
-    else if (expr->str() == "[" && expr->astOperand1() && expr->astOperand2()) {
-        const Token *tokvalue = nullptr;
-        if (!programMemory->getTokValue(expr->astOperand1()->varId(), &tokvalue)) {
-            auto tokvalue_it = std::find_if(expr->astOperand1()->values().begin(),
-                                            expr->astOperand1()->values().end(),
-                                            std::mem_fn(&ValueFlow::Value::isTokValue));
-            if (tokvalue_it == expr->astOperand1()->values().end()) {
-                *error = true;
-                return;
+            case Op::Not:
+                execute(instruction.operand1, programMemory, result, error);
+                *result = !(*result);
+                break;
+
+            case Op::Comma:
+                execute(instruction.operand1, programMemory, result, error);
+                execute(instruction.operand2, programMemory, result, error);
+                break;
+
+            case Op::Subscript: {
+                const Token *tokvalue = nullptr;
+                if (!programMemory->getTokValue(instruction.varid, &tokvalue))
+                    tokvalue = instruction.tokvalue;
+                if (!tokvalue || !tokvalue->isLiteral()) {
+                    *error = true;
+                    break;
+                }
+                const std::string strValue = tokvalue->strValue();
+                MathLib::bigint index = 0;
+                execute(instruction.operand2, programMemory, &index, error);
+                if (index >= 0 && index < strValue.size())
+                    *result = strValue[index];
+                else if (index == strValue.size())
+                    *result = 0;
+                else
+                    *error = true;
+                break;
+            }
             }
-            tokvalue = tokvalue_it->tokvalue;
-        }
-        if (!tokvalue || !tokvalue->isLiteral()) {
-            *error = true;
-            return;
         }
-        const std::string strValue = tokvalue->strValue();
-        MathLib::bigint index = 0;
-        execute(expr->astOperand2(), programMemory, &index, error);
-        if (index >= 0 && index < strValue.size())
-            *result = strValue[index];
-        else if (index == strValue.size())
-            *result = 0;
-        else
-            *error = true;
-    }
 
-    else
-        *error = true;
+        /** Instructions, the root of the expression first */
+        std::vector<Instruction> mCode;
+    };
+}
+
+static void execute(const Token *expr,
+                    ProgramMemory * const programMemory,
+                    MathLib::bigint *result,
+                    bool *error)
+{
+    CompiledExpression(expr).execute(programMemory, result, error);
 }
 
 static bool valueFlowForLoop1(const Token *tok, unsigned int * const varid, MathLib::bigint * const num1, MathLib::bigint * const num2, MathLib::bigint * const numAfter)
@@ -4223,12 +4877,14 @@ static bool valueFlowForLoop2(const Token *tok,
     ProgramMemory startMemory(programMemory);
     ProgramMemory endMemory;
 
+    const CompiledExpression condition(secondExpression);
+    const CompiledExpression increment(thirdExpression);
     unsigned int maxcount = 10000;
     while (result != 0 && !error && --maxcount) {
         endMemory = programMemory;
-        execute(thirdExpression, &programMemory, &result, &error);
+        increment.execute(&programMemory, &result, &error);
         if (!error)
-            execute(secondExpression, &programMemory, &result, &error);
+            condition.execute(&programMemory, &result, &error);
     }
 
     memory1->swap(startMemory);
@@ -4360,14 +5016,14 @@ static void valueFlowForLoopSimplifyAfter(Token *fortok, unsigned int varid, con
                      settings);
 }
 
-static void valueFlowForLoop(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowForLoop(TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger *errorLogger, const Settings *settings)
 {
-    for (const Scope &scope : symboldatabase->scopeList) {
-        if (scope.type != Scope::eFor)
+    for (const Scope *scope : worklist.scopes()) {
+        if (scope->type != Scope::eFor)
             continue;
 
-        Token* tok = const_cast<Token*>(scope.classDef);
-        Token* const bodyStart = const_cast<Token*>(scope.bodyStart);
+        Token* tok = const_cast<Token*>(scope->classDef);
+        Token* const bodyStart = const_cast<Token*>(scope->bodyStart);
 
         if (!Token::simpleMatch(tok->next()->astOperand2(), ";") ||
             !Token::simpleMatch(tok->next()->astOperand2()->astOperand2(), ";"))
@@ -4386,18 +5042,18 @@ static void valueFlowForLoop(TokenList *tokenlist, SymbolDatabase* symboldatabas
         } else {
             ProgramMemory mem1, mem2, memAfter;
             if (valueFlowForLoop2(tok, &mem1, &mem2, &memAfter)) {
-                std::map<unsigned int, ValueFlow::Value>::const_iterator it;
-                for (it = mem1.values.begin(); it != mem1.values.end(); ++it) {
+                ProgramMemory::Values::const_iterator it;
+                for (it = mem1.values().begin(); it != mem1.values().end(); ++it) {
                     if (!it->second.isIntValue())
                         continue;
                     valueFlowForLoopSimplify(bodyStart, it->first, false, it->second.intvalue, tokenlist, errorLogger, settings);
                 }
-                for (it = mem2.values.begin(); it != mem2.values.end(); ++it) {
+                for (it = mem2.values().begin(); it != mem2.values().end(); ++it) {
                     if (!it->second.isIntValue())
                         continue;
                     valueFlowForLoopSimplify(bodyStart, it->first, false, it->second.intvalue, tokenlist, errorLogger, settings);
                 }
-                for (it = memAfter.values.begin(); it != memAfter.values.end(); ++it) {
+                for (it = memAfter.values().begin(); it != memAfter.values().end(); ++it) {
                     if (!it->second.isIntValue())
                         continue;
                     valueFlowForLoopSimplifyAfter(tok, it->first, it->second.intvalue, tokenlist, errorLogger, settings);
@@ -4421,14 +5077,14 @@ static void valueFlowInjectParameter(TokenList* tokenlist, ErrorLogger* errorLog
     valueFlowForward(const_cast<Token*>(functionScope->bodyStart->next()), functionScope->bodyEnd, arg, varid2, argvalues, false, true, tokenlist, errorLogger, settings);
 }
 
-static void valueFlowSwitchVariable(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowSwitchVariable(TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger *errorLogger, const Settings *settings)
 {
-    for (const Scope &scope : symboldatabase->scopeList) {
-        if (scope.type != Scope::ScopeType::eSwitch)
+    for (const Scope *scope : worklist.scopes()) {
+        if (scope->type != Scope::ScopeType::eSwitch)
             continue;
-        if (!Token::Match(scope.classDef, "switch ( %var% ) {"))
+        if (!Token::Match(scope->classDef, "switch ( %var% ) {"))
             continue;
-        const Token *vartok = scope.classDef->tokAt(2);
+        const Token *vartok = scope->classDef->tokAt(2);
         const Variable *var = vartok->variable();
         if (!var)
             continue;
@@ -4440,7 +5096,7 @@ static void valueFlowSwitchVariable(TokenList *tokenlist, SymbolDatabase* symbol
             continue;
         }
 
-        for (Token *tok = scope.bodyStart->next(); tok != scope.bodyEnd; tok = tok->next()) {
+        for (Token *tok = scope->bodyStart->next(); tok != scope->bodyEnd; tok = tok->next()) {
             if (tok->str() == "{") {
                 tok = tok->link();
                 continue;
@@ -4464,9 +5120,23 @@ static void valueFlowSwitchVariable(TokenList *tokenlist, SymbolDatabase* symbol
                     const std::string info2("case " + tok->next()->str() + ": " + vartok->str() + " is " + tok->next()->str() + " here.");
                     values.back().errorPath.emplace_back(tok, info2);
                 }
+                // Tokens don't store more than 10 values => the case values that don't fit are merged into an int range.
+                // Most checks only look at int values, so the first case values are kept as they are.
+                if (values.size() > 10U) {
+                    const std::list<ValueFlow::Value>::iterator overflow = std::next(values.begin(), 9);
+                    const auto minmax = std::minmax_element(overflow, values.end(), [](const ValueFlow::Value &v1, const ValueFlow::Value &v2) {
+                        return v1.intvalue < v2.intvalue;
+                    });
+                    ValueFlow::Value range(*minmax.second);
+                    range.valueType = ValueFlow::Value::INT_RANGE;
+                    range.intvalue = minmax.first->intvalue;
+                    range.intvalueMax = minmax.second->intvalue;
+                    values.erase(overflow, values.end());
+                    values.push_back(range);
+                }
                 for (std::list<ValueFlow::Value>::const_iterator val = values.begin(); val != values.end(); ++val) {
                     valueFlowReverse(tokenlist,
-                                     const_cast<Token*>(scope.classDef),
+                                     const_cast<Token*>(scope->classDef),
                                      vartok,
                                      *val,
                                      ValueFlow::Value(),
@@ -4679,10 +5349,10 @@ static void valueFlowLibraryFunction(Token *tok, const std::string &returnValue,
         setTokenValues(tok, results, settings);
 }
 
-static void valueFlowSubFunction(TokenList *tokenlist, const Settings *settings)
+static void valueFlowSubFunction(TokenList *tokenlist, const ValueFlowWorklist &worklist, const Settings *settings)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
-        if (!Token::Match(tok, "%name% ("))
+        if (!Token::Match(tok, "%name% (") || !worklist.contains(tok->scope()))
             continue;
 
         const Function * const calledFunction = tok->function();
@@ -4752,7 +5422,7 @@ static void valueFlowFunctionDefaultParameter(TokenList *tokenlist, SymbolDataba
         for (std::size_t arg = function->minArgCount(); arg < function->argCount(); arg++) {
             const Variable* var = function->getArgumentVar(arg);
             if (var && var->hasDefault() && Token::Match(var->nameToken(), "%var% = %num%|%str% [,)]")) {
-                const std::list<ValueFlow::Value> &values = var->nameToken()->tokAt(2)->values();
+                const ValueFlow::ValueList &values = var->nameToken()->tokAt(2)->values();
                 std::list<ValueFlow::Value> argvalues;
                 for (const ValueFlow::Value &value : values) {
                     ValueFlow::Value v(value);
@@ -5103,32 +5773,34 @@ static void valueFlowSmartPointer(TokenList *tokenlist, ErrorLogger * errorLogge
     }
 }
 
-static void valueFlowContainerSize(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger * /*errorLogger*/, const Settings *settings)
+static void valueFlowContainerSize(TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger * /*errorLogger*/, const Settings *settings)
 {
     // declaration
-    for (const Variable *var : symboldatabase->variableList()) {
-        if (!var || !var->isLocal() || var->isPointer() || var->isReference())
-            continue;
-        if (!var->valueType() || !var->valueType()->container)
-            continue;
-        if (!Token::Match(var->nameToken(), "%name% ;"))
-            continue;
-        if (var->nameToken()->hasKnownValue())
-            continue;
-        ValueFlow::Value value(0);
-        if (var->valueType()->container->size_templateArgNo >= 0) {
-            if (var->dimensions().size() == 1 && var->dimensions().front().known)
-                value.intvalue = var->dimensions().front().num;
-            else
+    for (const Scope *scope : worklist.scopes()) {
+        for (const Variable &var : scope->varlist) {
+            if (!var.isLocal() || var.isPointer() || var.isReference())
+                continue;
+            if (!var.valueType() || !var.valueType()->container)
+                continue;
+            if (!Token::Match(var.nameToken(), "%name% ;"))
                 continue;
+            if (var.nameToken()->hasKnownValue())
+                continue;
+            ValueFlow::Value value(0);
+            if (var.valueType()->container->size_templateArgNo >= 0) {
+                if (var.dimensions().size() == 1 && var.dimensions().front().known)
+                    value.intvalue = var.dimensions().front().num;
+                else
+                    continue;
+            }
+            value.valueType = ValueFlow::Value::ValueType::CONTAINER_SIZE;
+            value.setKnown();
+            valueFlowContainerForward(var.nameToken()->next(), var.declarationId(), value, settings, tokenlist->isCPP());
         }
-        value.valueType = ValueFlow::Value::ValueType::CONTAINER_SIZE;
-        value.setKnown();
-        valueFlowContainerForward(var->nameToken()->next(), var->declarationId(), value, settings, tokenlist->isCPP());
     }
 
     // after assignment
-    for (const Scope *functionScope : symboldatabase->functionScopes) {
+    for (const Scope *functionScope : worklist.functionScopes()) {
         for (const Token *tok = functionScope->bodyStart; tok != functionScope->bodyEnd; tok = tok->next()) {
             if (Token::Match(tok, "[;{}] %var% = %str% ;")) {
                 const Token *containerTok = tok->next();
@@ -5143,10 +5815,10 @@ static void valueFlowContainerSize(TokenList *tokenlist, SymbolDatabase* symbold
     }
 
     // conditional conditionSize
-    for (const Scope &scope : symboldatabase->scopeList) {
-        if (scope.type != Scope::ScopeType::eIf) // TODO: while
+    for (const Scope *scope : worklist.scopes()) {
+        if (scope->type != Scope::ScopeType::eIf) // TODO: while
             continue;
-        for (const Token *tok = scope.classDef; tok && tok->str() != "{"; tok = tok->next()) {
+        for (const Token *tok = scope->classDef; tok && tok->str() != "{"; tok = tok->next()) {
             if (!tok->isName() || !tok->valueType() || tok->valueType()->type != ValueType::CONTAINER || !tok->valueType()->container)
                 continue;
 
@@ -5182,13 +5854,13 @@ static void valueFlowContainerSize(TokenList *tokenlist, SymbolDatabase* symbold
             value.valueType = ValueFlow::Value::ValueType::CONTAINER_SIZE;
 
             // possible value before condition
-            valueFlowContainerReverse(const_cast<Token *>(scope.classDef), tok->varId(), value, settings);
+            valueFlowContainerReverse(const_cast<Token *>(scope->classDef), tok->varId(), value, settings);
         }
     }
 }
 
 static void valueFlowContainerAfterCondition(TokenList *tokenlist,
-        SymbolDatabase *symboldatabase,
+        const ValueFlowWorklist &worklist,
         ErrorLogger *errorLogger,
         const Settings *settings)
 {
@@ -5260,7 +5932,7 @@ static void valueFlowContainerAfterCondition(TokenList *tokenlist,
         }
         return cond;
     };
-    handler.afterCondition(tokenlist, symboldatabase, errorLogger, settings);
+    handler.afterCondition(tokenlist, worklist, errorLogger, settings);
 }
 
 static void valueFlowFwdAnalysis(const TokenList *tokenlist, const Settings *settings)
@@ -5357,9 +6029,143 @@ static void valueFlowDynamicBufferSize(TokenList *tokenlist, SymbolDatabase *sym
     }
 }
 
+ValueFlow::SharedErrorPath &ValueFlow::SharedErrorPath::operator=(const List &items)
+{
+    mLast.reset();
+    for (const Item &item : items)
+        push_back(item);
+    return *this;
+}
+
+ValueFlow::SharedErrorPath::operator List() const
+{
+    List items;
+    for (const Node *node = mLast.get(); node; node = node->previous.get())
+        items.push_front(node->item);
+    return items;
+}
+
+void ValueFlow::SharedErrorPath::push_front(const Item &item)
+{
+    List items = *this;
+    items.push_front(item);
+    *this = items;
+}
+
+ValueFlow::ValueList::ValueList(const ValueList &other) : mData(inlineData()), mSize(0), mCapacity(1)
+{
+    reserve(other.mSize);
+    for (const Value &value : other)
+        new (mData + mSize++) Value(value);
+}
+
+ValueFlow::ValueList::ValueList(ValueList &&other) : mData(inlineData()), mSize(0), mCapacity(1)
+{
+    take(other);
+}
+
+ValueFlow::ValueList::~ValueList()
+{
+    clear();
+    if (mData != inlineData())
+        ::operator delete(mData);
+}
+
+ValueFlow::ValueList &ValueFlow::ValueList::operator=(const ValueList &other)
+{
+    if (this != &other) {
+        clear();
+        reserve(other.mSize);
+        for (const Value &value : other)
+            new (mData + mSize++) Value(value);
+    }
+    return *this;
+}
+
+ValueFlow::ValueList &ValueFlow::ValueList::operator=(ValueList &&other)
+{
+    if (this != &other) {
+        clear();
+        if (mData != inlineData())
+            ::operator delete(mData);
+        mData = inlineData();
+        mCapacity = 1;
+        take(other);
+    }
+    return *this;
+}
+
+void ValueFlow::ValueList::take(ValueList &other)
+{
+    if (other.mData == other.inlineData()) {
+        // The inline value is moved
+        if (other.mSize > 0) {
+            new (mData) Value(std::move(other.mData[0]));
+            mSize = 1;
+            other.clear();
+        }
+        return;
+    }
+    mData = other.mData;
+    mSize = other.mSize;
+    mCapacity = other.mCapacity;
+    other.mData = other.inlineData();
+    other.mSize = 0;
+    other.mCapacity = 1;
+}
+
+void ValueFlow::ValueList::reserve(size_type capacity)
+{
+    if (capacity <= mCapacity)
+        return;
+    Value *data = static_cast<Value *>(::operator new(capacity * sizeof(Value)));
+    for (size_type i = 0; i < mSize; ++i) {
+        new (data + i) Value(std::move(mData[i]));
+        mData[i].~Value();
+    }
+    if (mData != inlineData())
+        ::operator delete(mData);
+    mData = data;
+    mCapacity = capacity;
+}
+
+void ValueFlow::ValueList::clear()
+{
+    while (mSize > 0)
+        mData[--mSize].~Value();
+}
+
+void ValueFlow::ValueList::push_back(Value value)
+{
+    if (mSize == mCapacity)
+        reserve(mCapacity * 4);
+    new (mData + mSize) Value(std::move(value));
+    ++mSize;
+}
+
+void ValueFlow::ValueList::push_front(Value value)
+{
+    if (mSize == mCapacity)
+        reserve(mCapacity * 4);
+    if (mSize == 0) {
+        new (mData) Value(std::move(value));
+    } else {
+        new (mData + mSize) Value(std::move(mData[mSize - 1]));
+        std::move_backward(mData, mData + mSize - 1, mData + mSize);
+        mData[0] = std::move(value);
+    }
+    ++mSize;
+}
+
+bool ValueFlow::ValueList::operator==(const ValueList &other) const
+{
+    return mSize == other.mSize && std::equal(begin(), end(), other.begin());
+}
+
 ValueFlow::Value::Value(const Token *c, long long val)
     : valueType(INT),
       intvalue(val),
+      intvalueMax(val),
       tokvalue(nullptr),
       floatValue(0.0),
       moveKind(NonMovedVariable),
@@ -5380,6 +6186,8 @@ std::string ValueFlow::Value::infoString() const
     switch (valueType) {
     case INT:
         return MathLib::toString(intvalue);
+    case INT_RANGE:
+        return MathLib::toString(intvalue) + ".." + MathLib::toString(intvalueMax);
     case TOK:
         return tokvalue->str();
     case FLOAT:
@@ -5407,57 +6215,136 @@ const ValueFlow::Value *ValueFlow::valueFlowConstantFoldAST(Token *expr, const S
     return expr && expr->hasKnownValue() ? &expr->values().front() : nullptr;
 }
 
-static std::size_t getTotalValues(TokenList *tokenlist)
+/** Passes of the function scopes that run between valueFlowTerminatingCondition() and valueFlowSubFunction() */
+static void valueFlowConditionPasses(TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger *errorLogger, const Settings *settings)
 {
-    std::size_t n = 1;
-    for (Token *tok = tokenlist->front(); tok; tok = tok->next())
-        n += tok->values().size();
-    return n;
+    valueFlowBeforeCondition(tokenlist, worklist, errorLogger, settings);
+    valueFlowAfterMove(tokenlist, worklist, errorLogger, settings);
+    valueFlowAfterAssign(tokenlist, worklist, errorLogger, settings);
+    valueFlowAfterCondition(tokenlist, worklist, errorLogger, settings);
+    valueFlowSwitchVariable(tokenlist, worklist, errorLogger, settings);
+    valueFlowForLoop(tokenlist, worklist, errorLogger, settings);
+}
+
+/** Passes of the function scopes that run last, for C++ code */
+static void valueFlowContainerPasses(TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger *errorLogger, const Settings *settings)
+{
+    valueFlowContainerSize(tokenlist, worklist, errorLogger, settings);
+    valueFlowContainerAfterCondition(tokenlist, worklist, errorLogger, settings);
+}
+
+/**
+ * Run passes that only set values in the analysed scopes on worker
+ * threads, each thread analyses the code of one outermost function scope
+ * at a time. The values are the same as when the passes run serially: a
+ * part only writes to the tokens of its own scope, the messages and the
+ * lifetime calls between parts are handled afterwards in the order of the
+ * parts, and the passes that run before and after them are the same as in
+ * the serial order.
+ */
+static void valueFlowFunctionScopesConcurrently(void (*passes)(TokenList *, const ValueFlowWorklist &, ErrorLogger *, const Settings *), TokenList *tokenlist, const ValueFlowWorklist &worklist, ErrorLogger *errorLogger, const Settings *settings)
+{
+    const std::vector<ValueFlowWorklist> parts = worklist.split();
+
+    // Code outside function scopes
+    passes(tokenlist, parts[0], errorLogger, settings);
+
+    std::vector<ValueFlowPart> results(parts.size());
+    for (std::size_t i = 0; i < parts.size(); ++i)
+        results[i].worklist = &parts[i];
+
+    std::atomic<std::size_t> nextPart(1);
+    auto worker = [&]() {
+        for (std::size_t i = nextPart++; i < parts.size(); i = nextPart++) {
+            ValueFlowPart &result = results[i];
+            currentValueFlowPart = &result;
+            try {
+                passes(tokenlist, parts[i], &result, settings);
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+            currentValueFlowPart = nullptr;
+        }
+    };
+
+    static ValueFlowThreadPool pool;
+    pool.run(std::min<std::size_t>(settings->valueFlowJobs, parts.size() - 1), worker);
+
+    for (const ValueFlowPart &result : results)
+        result.finish(errorLogger);
+    for (const ValueFlowPart &result : results) {
+        for (Token *tok : result.lifetimeCalls)
+            valueFlowLifetimeFunction(tok, tokenlist, errorLogger, settings);
+    }
 }
 
-void ValueFlow::setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
+void ValueFlow::setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings, TimerResultsIntf *timerResults)
 {
+    // The time of each pass is reported with --showtime
+    const unsigned int showtime = timerResults ? settings->showtime : SHOWTIME_NONE;
+    auto runPass = [&](const char *name, const std::function<void()> &pass) {
+        Timer t(std::string("ValueFlow::") + name, showtime, timerResults);
+        pass();
+    };
+
     for (Token *tok = tokenlist->front(); tok; tok = tok->next())
         tok->clearValueFlow();
 
-    valueFlowNumber(tokenlist);
-    valueFlowString(tokenlist);
-    valueFlowArray(tokenlist);
-    valueFlowGlobalConstVar(tokenlist, settings);
-    valueFlowGlobalStaticVar(tokenlist, settings);
-    valueFlowPointerAlias(tokenlist);
-    valueFlowLifetime(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowFunctionReturn(tokenlist, errorLogger);
-    valueFlowBitAnd(tokenlist);
-    valueFlowSameExpressions(tokenlist);
-    valueFlowFwdAnalysis(tokenlist, settings);
-
-    // Temporary hack.. run valueflow until there is nothing to update or timeout expires
-    const std::time_t timeout = std::time(0) + TIMEOUT;
-    std::size_t values = 0;
-    while (std::time(0) < timeout && values < getTotalValues(tokenlist)) {
-        values = getTotalValues(tokenlist);
-        valueFlowArrayBool(tokenlist);
-        valueFlowRightShift(tokenlist, settings);
-        valueFlowOppositeCondition(symboldatabase, settings);
-        valueFlowTerminatingCondition(tokenlist, symboldatabase, settings);
-        valueFlowBeforeCondition(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowAfterMove(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowAfterAssign(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowAfterCondition(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowSwitchVariable(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowForLoop(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowSubFunction(tokenlist, settings);
-        valueFlowFunctionDefaultParameter(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowUninit(tokenlist, symboldatabase, errorLogger, settings);
-        if (tokenlist->isCPP()) {
-            valueFlowSmartPointer(tokenlist, errorLogger, settings);
-            valueFlowContainerSize(tokenlist, symboldatabase, errorLogger, settings);
-            valueFlowContainerAfterCondition(tokenlist, symboldatabase, errorLogger, settings);
+    runPass("valueFlowNumber", [&] { valueFlowNumber(tokenlist); });
+    runPass("valueFlowString", [&] { valueFlowString(tokenlist); });
+    runPass("valueFlowArray", [&] { valueFlowArray(tokenlist); });
+    runPass("valueFlowGlobalConstVar", [&] { valueFlowGlobalConstVar(tokenlist, settings); });
+    runPass("valueFlowGlobalStaticVar", [&] { valueFlowGlobalStaticVar(tokenlist, settings); });
+    runPass("valueFlowPointerAlias", [&] { valueFlowPointerAlias(tokenlist); });
+    runPass("valueFlowLifetime", [&] { valueFlowLifetime(tokenlist, symboldatabase, errorLogger, settings); });
+    runPass("valueFlowFunctionReturn", [&] { valueFlowFunctionReturn(tokenlist, errorLogger); });
+    runPass("valueFlowBitAnd", [&] { valueFlowBitAnd(tokenlist); });
+    runPass("valueFlowSameExpressions", [&] { valueFlowSameExpressions(tokenlist); });
+    runPass("valueFlowFwdAnalysis", [&] { valueFlowFwdAnalysis(tokenlist, settings); });
+
+    // Repeat the passes until no values are added or the time limit is reached. After
+    // the first round only the function scopes where values changed are analysed.
+    const std::time_t timeout = std::time(0) + settings->valueFlowMaxTime;
+    ValueFlowWorklist worklist(tokenlist, symboldatabase);
+    do {
+        if (settings->valueFlowJobs > 1) {
+            // The same order as below, the passes that only set values in the
+            // analysed function scopes run concurrently
+            runPass("valueFlowArrayBool", [&] { valueFlowArrayBool(tokenlist); });
+            runPass("valueFlowRightShift", [&] { valueFlowRightShift(tokenlist, settings); });
+            runPass("valueFlowOppositeCondition", [&] { valueFlowOppositeCondition(symboldatabase, worklist, settings); });
+            runPass("valueFlowTerminatingCondition", [&] { valueFlowTerminatingCondition(tokenlist, symboldatabase, settings); });
+            runPass("valueFlowConditionPasses", [&] { valueFlowFunctionScopesConcurrently(valueFlowConditionPasses, tokenlist, worklist, errorLogger, settings); });
+            runPass("valueFlowSubFunction", [&] { valueFlowSubFunction(tokenlist, worklist, settings); });
+            runPass("valueFlowFunctionDefaultParameter", [&] { valueFlowFunctionDefaultParameter(tokenlist, symboldatabase, errorLogger, settings); });
+            runPass("valueFlowUninit", [&] { valueFlowUninit(tokenlist, symboldatabase, errorLogger, settings); });
+            if (tokenlist->isCPP()) {
+                runPass("valueFlowSmartPointer", [&] { valueFlowSmartPointer(tokenlist, errorLogger, settings); });
+                runPass("valueFlowContainerPasses", [&] { valueFlowFunctionScopesConcurrently(valueFlowContainerPasses, tokenlist, worklist, errorLogger, settings); });
+            }
+        } else {
+            runPass("valueFlowArrayBool", [&] { valueFlowArrayBool(tokenlist); });
+            runPass("valueFlowRightShift", [&] { valueFlowRightShift(tokenlist, settings); });
+            runPass("valueFlowOppositeCondition", [&] { valueFlowOppositeCondition(symboldatabase, worklist, settings); });
+            runPass("valueFlowTerminatingCondition", [&] { valueFlowTerminatingCondition(tokenlist, symboldatabase, settings); });
+            runPass("valueFlowBeforeCondition", [&] { valueFlowBeforeCondition(tokenlist, worklist, errorLogger, settings); });
+            runPass("valueFlowAfterMove", [&] { valueFlowAfterMove(tokenlist, worklist, errorLogger, settings); });
+            runPass("valueFlowAfterAssign", [&] { valueFlowAfterAssign(tokenlist, worklist, errorLogger, settings); });
+            runPass("valueFlowAfterCondition", [&] { valueFlowAfterCondition(tokenlist, worklist, errorLogger, settings); });
+            runPass("valueFlowSwitchVariable", [&] { valueFlowSwitchVariable(tokenlist, worklist, errorLogger, settings); });
+            runPass("valueFlowForLoop", [&] { valueFlowForLoop(tokenlist, worklist, errorLogger, settings); });
+            runPass("valueFlowSubFunction", [&] { valueFlowSubFunction(tokenlist, worklist, settings); });
+            runPass("valueFlowFunctionDefaultParameter", [&] { valueFlowFunctionDefaultParameter(tokenlist, symboldatabase, errorLogger, settings); });
+            runPass("valueFlowUninit", [&] { valueFlowUninit(tokenlist, symboldatabase, errorLogger, settings); });
+            if (tokenlist->isCPP()) {
+                runPass("valueFlowSmartPointer", [&] { valueFlowSmartPointer(tokenlist, errorLogger, settings); });
+                runPass("valueFlowContainerSize", [&] { valueFlowContainerSize(tokenlist, worklist, errorLogger, settings); });
+                runPass("valueFlowContainerAfterCondition", [&] { valueFlowContainerAfterCondition(tokenlist, worklist, errorLogger, settings); });
+            }
         }
-    }
+    } while (worklist.update(tokenlist) && (settings->valueFlowMaxTime == 0 || std::time(0) < timeout));
 
-    valueFlowDynamicBufferSize(tokenlist, symboldatabase, errorLogger, settings);
+    runPass("valueFlowDynamicBufferSize", [&] { valueFlowDynamicBufferSize(tokenlist, symboldatabase, errorLogger, settings); });
 }
 
 
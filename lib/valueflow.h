@@ -23,26 +23,88 @@
 
 #include "config.h"
 
+#include <cstddef>
 #include <list>
+#include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 class ErrorLogger;
 class Settings;
 class SymbolDatabase;
+class TimerResultsIntf;
 class Token;
 class TokenList;
 class Variable;
 
 namespace ValueFlow {
+    /**
+     * Error path of a value. Values are copied often when they are
+     * propagated and every copy may add its own items. The items are
+     * immutable nodes that point to the item before them, so the copies
+     * share the path they have in common and adding an item at the end
+     * does not copy anything.
+     */
+    class CPPCHECKLIB SharedErrorPath {
+    public:
+        typedef std::pair<const Token *, std::string> Item;
+        typedef std::list<Item> List;
+
+        SharedErrorPath() {}
+
+        SharedErrorPath &operator=(const List &items);
+
+        /** @return the items, from the first to the last */
+        operator List() const;
+
+        bool empty() const {
+            return !mLast;
+        }
+        std::size_t size() const {
+            return mLast ? mLast->size : 0;
+        }
+        const Item &back() const {
+            return mLast->item;
+        }
+
+        template<class... Args>
+        void emplace_back(Args&&... args) {
+            mLast = std::make_shared<const Node>(mLast, Item(std::forward<Args>(args)...));
+        }
+        void push_back(const Item &item) {
+            mLast = std::make_shared<const Node>(mLast, item);
+        }
+
+        /** Adding an item in front copies the path */
+        template<class... Args>
+        void emplace_front(Args&&... args) {
+            push_front(Item(std::forward<Args>(args)...));
+        }
+        void push_front(const Item &item);
+
+    private:
+        struct Node {
+            Node(const std::shared_ptr<const Node> &previous, const Item &item)
+                : previous(previous), item(item), size(previous ? previous->size + 1 : 1) {}
+            const std::shared_ptr<const Node> previous;
+            const Item item;
+            const std::size_t size;
+        };
+
+        std::shared_ptr<const Node> mLast;
+    };
+
     class CPPCHECKLIB Value {
     public:
-        typedef std::pair<const Token *, std::string> ErrorPathItem;
-        typedef std::list<ErrorPathItem> ErrorPath;
+        typedef SharedErrorPath::Item ErrorPathItem;
+        typedef SharedErrorPath::List ErrorPath;
 
         explicit Value(long long val = 0)
             : valueType(INT),
               intvalue(val),
+              intvalueMax(val),
               tokvalue(nullptr),
               floatValue(0.0),
               moveKind(NonMovedVariable),
@@ -65,6 +127,10 @@ namespace ValueFlow {
                 if (intvalue != rhs.intvalue)
                     return false;
                 break;
+            case INT_RANGE:
+                if (intvalue != rhs.intvalue || intvalueMax != rhs.intvalueMax)
+                    return false;
+                break;
             case TOK:
                 if (tokvalue != rhs.tokvalue)
                     return false;
@@ -103,10 +169,13 @@ namespace ValueFlow {
 
         std::string infoString() const;
 
-        enum ValueType { INT, TOK, FLOAT, MOVED, UNINIT, CONTAINER_SIZE, LIFETIME, BUFFER_SIZE } valueType;
+        enum ValueType { INT, TOK, FLOAT, MOVED, UNINIT, CONTAINER_SIZE, LIFETIME, BUFFER_SIZE, INT_RANGE } valueType;
         bool isIntValue() const {
             return valueType == INT;
         }
+        bool isIntRangeValue() const {
+            return valueType == INT_RANGE;
+        }
         bool isTokValue() const {
             return valueType == TOK;
         }
@@ -137,9 +206,37 @@ namespace ValueFlow {
             return valueType == LIFETIME && lifetimeScope == Argument;
         }
 
-        /** int value */
+        /** int value, lower bound of int range */
         long long intvalue;
 
+        /**
+         * upper bound of int range. The bounds are possible values, values
+         * between the bounds might be possible.
+         */
+        long long intvalueMax;
+
+        /** largest possible int value */
+        long long maxIntValue() const {
+            return isIntRangeValue() ? intvalueMax : intvalue;
+        }
+
+        /**
+         * Merge int value into this int range
+         * @return true if the range was extended
+         */
+        bool mergeIntRange(const Value &value) {
+            bool changed = false;
+            if (value.intvalue < intvalue) {
+                intvalue = value.intvalue;
+                changed = true;
+            }
+            if (value.maxIntValue() > intvalueMax) {
+                intvalueMax = value.maxIntValue();
+                changed = true;
+            }
+            return changed;
+        }
+
         /** token value - the token that has the value. this is used for pointer aliases, strings, etc. */
         const Token *tokvalue;
 
@@ -155,7 +252,7 @@ namespace ValueFlow {
         /** Condition that this value depends on */
         const Token *condition;
 
-        ErrorPath errorPath;
+        SharedErrorPath errorPath;
 
         /** For calculated values - varId that calculated value depends on */
         unsigned int varId;
@@ -227,11 +324,108 @@ namespace ValueFlow {
         }
     };
 
+    /**
+     * Values of a token. The first value is stored inline, more values
+     * are stored in one array.
+     */
+    class CPPCHECKLIB ValueList {
+    public:
+        typedef Value value_type;
+        typedef Value *iterator;
+        typedef const Value *const_iterator;
+        typedef std::size_t size_type;
+
+        ValueList() : mData(inlineData()), mSize(0), mCapacity(1) {}
+        ValueList(const ValueList &other);
+        ValueList(ValueList &&other);
+        ~ValueList();
+        ValueList &operator=(const ValueList &other);
+        ValueList &operator=(ValueList &&other);
+
+        /** Copy of the values, for code that needs a list */
+        operator std::list<Value>() const {
+            return std::list<Value>(begin(), end());
+        }
+
+        iterator begin() {
+            return mData;
+        }
+        iterator end() {
+            return mData + mSize;
+        }
+        const_iterator begin() const {
+            return mData;
+        }
+        const_iterator end() const {
+            return mData + mSize;
+        }
+        const_iterator cbegin() const {
+            return mData;
+        }
+        const_iterator cend() const {
+            return mData + mSize;
+        }
+        bool empty() const {
+            return mSize == 0;
+        }
+        size_type size() const {
+            return mSize;
+        }
+        Value &front() {
+            return mData[0];
+        }
+        const Value &front() const {
+            return mData[0];
+        }
+        Value &back() {
+            return mData[mSize - 1];
+        }
+        const Value &back() const {
+            return mData[mSize - 1];
+        }
+
+        void push_back(Value value);
+        void push_front(Value value);
+
+        template<class Predicate>
+        void remove_if(Predicate pred) {
+            Value *out = mData;
+            for (Value *it = mData; it != mData + mSize; ++it) {
+                if (pred(*it))
+                    continue;
+                if (out != it)
+                    *out = std::move(*it);
+                ++out;
+            }
+            while (mData + mSize != out)
+                mData[--mSize].~Value();
+        }
+
+        bool operator==(const ValueList &other) const;
+        bool operator!=(const ValueList &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        Value *inlineData() {
+            return reinterpret_cast<Value *>(&mInline);
+        }
+        void reserve(size_type capacity);
+        void clear();
+        /** Take the values of other, which is left empty. This list must be empty and use the inline value. */
+        void take(ValueList &other);
+
+        Value *mData;
+        size_type mSize;
+        size_type mCapacity;
+        std::aligned_storage<sizeof(Value), alignof(Value)>::type mInline;
+    };
+
     /// Constant folding of expression. This can be used before the full ValueFlow has been executed (ValueFlow::setValues).
     const ValueFlow::Value * valueFlowConstantFoldAST(Token *expr, const Settings *settings);
 
     /// Perform valueflow analysis.
-    void setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings);
+    void setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings, TimerResultsIntf *timerResults = nullptr);
 
     std::string eitherTheConditionIsRedundant(const Token *condition);
 }
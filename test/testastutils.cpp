@@ -39,6 +39,7 @@ private:
         TEST_CASE(isVariableChanged);
         TEST_CASE(isVariableChangedByFunctionCall);
         TEST_CASE(nextAfterAstRightmostLeaf);
+        TEST_CASE(expressionHasher);
     }
 
     bool findLambdaEndToken(const char code[]) {
@@ -193,6 +194,57 @@ private:
         ASSERT_EQUALS(true, nextAfterAstRightmostLeaf("int * g(int); void f(int a, int b) { int x = g(a)[b + 1]; }", "+", "] ; }"));
         ASSERT_EQUALS(true, nextAfterAstRightmostLeaf("int * g(int); void f(int a, int b) { int x = g(a + 1)[b]; }", "+", ") ["));
     }
+
+    // Expressions that isSameExpression() finds the same have the same hash
+    void expressionHasher() {
+        Settings settings;
+        Tokenizer tokenizer(&settings, this);
+        std::istringstream istr("void f(int a, int b, int c) {\n"
+                                "    const int y = a + b;\n"
+                                "    int x;\n"
+                                "    x = a < b;\n"
+                                "    x = b > a;\n"
+                                "    x = a + b * c;\n"
+                                "    x = c * b + a;\n"
+                                "    x = a - b;\n"
+                                "    x = b - a;\n"
+                                "    x = a <= b;\n"
+                                "    x = y;\n"
+                                "    x = b + a;\n"
+                                "}");
+        tokenizer.tokenize(istr, "test.cpp");
+        std::vector<const Token *> expressions;
+        for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+            if (tok->str() == "=" && tok->astOperand2())
+                expressions.push_back(tok->astOperand2());
+        }
+        ASSERT_EQUALS(10U, expressions.size());
+
+        for (const bool followVar : { false, true }) {
+            ExpressionHasher hasher(true, followVar);
+            for (const Token *expr1 : expressions) {
+                for (const Token *expr2 : expressions) {
+                    if (isSameExpression(true, false, expr1, expr2, settings.library, false, followVar))
+                        ASSERT_EQUALS_MSG(true, hasher.maybeSame(expr1, expr2), expr1->expressionString() + " " + expr2->expressionString());
+                }
+            }
+        }
+
+        ExpressionHasher hasher(true, false);
+        ASSERT_EQUALS(true, hasher.maybeSame(expressions[1], expressions[2]));
+        ASSERT_EQUALS(true, hasher.maybeSame(expressions[3], expressions[4]));
+        ASSERT_EQUALS(false, hasher.maybeSame(expressions[5], expressions[6]));
+        ASSERT_EQUALS(false, hasher.maybeSame(expressions[1], expressions[7]));
+        ASSERT_EQUALS(false, hasher.maybeSame(expressions[8], expressions[9]));
+
+        // With followVar a variable hashes like its initialization expression
+        ExpressionHasher followHasher(true, true);
+        ASSERT_EQUALS(true, followHasher.maybeSame(expressions[8], expressions[9]));
+
+        // The memoized hash is the same as a new one
+        ExpressionHasher hasher2(true, false);
+        ASSERT_EQUALS(hasher.hash(expressions[3]), hasher2.hash(expressions[3]));
+    }
 };
 
 REGISTER_TEST(TestAstUtils)
@@ -128,6 +128,7 @@ private:
         TEST_CASE(array_index_47); // #5849
         TEST_CASE(array_index_multidim);
         TEST_CASE(array_index_switch_in_for);
+        TEST_CASE(array_index_switch_range);
         TEST_CASE(array_index_for_in_for);   // FP: #2634
         TEST_CASE(array_index_calculation);
         TEST_CASE(array_index_negative1);
@@ -1642,6 +1643,31 @@ private:
         TODO_ASSERT_EQUALS("[test.cpp:12]: (error) Array index out of bounds.\n", "", errout.str());
     }
 
+    void array_index_switch_range() {
+        const std::string cases = "case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8: case 9:\n"
+                                  "case 10: case 11: case 12: case 13: case 14: case 15: case 16: case 17: case 18: case 19:\n";
+        check(("void f(int x) {\n"
+               "  int a[15];\n"
+               "  switch (x) {\n" + cases +
+               "    a[x] = 0;\n"
+               "    a[x - 5] = 0;\n"
+               "    break;\n"
+               "  }\n"
+               "}").c_str());
+        ASSERT_EQUALS("[test.cpp:5] -> [test.cpp:6]: (warning) Either the switch case 'case 19' is redundant or the array 'a[15]' is accessed at index 19, which is out of bounds.\n"
+                      "[test.cpp:4] -> [test.cpp:7]: (warning) Either the switch case 'case 4' is redundant or the array 'a[15]' is accessed at index -1, which is out of bounds.\n", errout.str());
+
+        check(("void f(int x) {\n"
+               "  int a[15];\n"
+               "  switch (x) {\n" + cases +
+               "    if (x < 15)\n"
+               "      a[x] = 0;\n"
+               "    break;\n"
+               "  }\n"
+               "}").c_str());
+        ASSERT_EQUALS("", errout.str());
+    }
+
     void array_index_for_in_for() {
         check("void f() {\n"
               "    int a[5];\n"
@@ -0,0 +1,217 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chunkedvector.h"
+#include "testsuite.h"
+
+#include <string>
+#include <vector>
+
+class TestChunkedVector : public TestFixture {
+public:
+    TestChunkedVector() : TestFixture("TestChunkedVector") {
+    }
+
+private:
+    void run() OVERRIDE {
+        TEST_CASE(pushAndIterate);
+        TEST_CASE(stableAddresses);
+        TEST_CASE(popBack);
+        TEST_CASE(reverseIterate);
+        TEST_CASE(copy);
+        TEST_CASE(chunkBoundaries);
+        TEST_CASE(popBackChunkBoundary);
+        TEST_CASE(move);
+    }
+
+    void pushAndIterate() const {
+        ChunkedVector<int> v;
+        ASSERT_EQUALS(true, v.empty());
+        ASSERT_EQUALS(true, v.begin() == v.end());
+        for (int i = 0; i < 100; ++i)
+            v.push_back(i);
+        ASSERT_EQUALS(100U, v.size());
+        ASSERT_EQUALS(0, v.front());
+        ASSERT_EQUALS(99, v.back());
+
+        int expected = 0;
+        for (ChunkedVector<int>::const_iterator it = v.begin(); it != v.end(); ++it)
+            ASSERT_EQUALS(expected++, *it);
+        ASSERT_EQUALS(100, expected);
+
+        for (int i = 0; i < 100; ++i)
+            ASSERT_EQUALS(i, v[i]);
+    }
+
+    void stableAddresses() const {
+        ChunkedVector<std::string> v;
+        std::vector<const std::string *> addresses;
+        for (int i = 0; i < 1000; ++i) {
+            v.emplace_back(std::to_string(i));
+            addresses.push_back(&v.back());
+        }
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_EQUALS(true, addresses[i] == &v[i]);
+            ASSERT_EQUALS(std::to_string(i), *addresses[i]);
+        }
+    }
+
+    void popBack() const {
+        ChunkedVector<int> v;
+        for (int i = 0; i < 5; ++i)
+            v.push_back(i);
+        v.pop_back();
+        v.pop_back();
+        ASSERT_EQUALS(3U, v.size());
+        ASSERT_EQUALS(2, v.back());
+        v.push_back(10);
+        v.push_back(11);
+        v.push_back(12);
+        std::vector<int> values(v.begin(), v.end());
+        ASSERT_EQUALS(6U, values.size());
+        ASSERT_EQUALS(12, values.back());
+        while (!v.empty())
+            v.pop_back();
+        ASSERT_EQUALS(true, v.begin() == v.end());
+    }
+
+    void reverseIterate() const {
+        ChunkedVector<int> v;
+        for (int i = 0; i < 13; ++i)
+            v.push_back(i);
+        int expected = 12;
+        for (ChunkedVector<int>::const_reverse_iterator it = v.rbegin(); it != v.rend(); ++it)
+            ASSERT_EQUALS(expected--, *it);
+        ASSERT_EQUALS(-1, expected);
+    }
+
+    void copy() const {
+        ChunkedVector<int> v1;
+        for (int i = 0; i < 20; ++i)
+            v1.push_back(i);
+        ChunkedVector<int> v2(v1);
+        v2.push_back(20);
+        ASSERT_EQUALS(20U, v1.size());
+        ASSERT_EQUALS(21U, v2.size());
+        ASSERT_EQUALS(19, v2[19]);
+        ASSERT_EQUALS(true, &v1[19] != &v2[19]);
+    }
+
+    // The chunks hold 4, 8, 16 and 32 elements, the sizes are at the ends of the chunks and next to them
+    void chunkBoundaries() const {
+        const int sizes[] = { 1, 3, 4, 5, 11, 12, 13, 27, 28, 29, 60, 61 };
+        for (const int size : sizes) {
+            ChunkedVector<int> v;
+            for (int i = 0; i < size; ++i)
+                v.push_back(i);
+            ASSERT_EQUALS(size, v.size());
+            ASSERT_EQUALS(size - 1, v.back());
+
+            for (int i = 0; i < size; ++i)
+                ASSERT_EQUALS(i, v[i]);
+
+            int expected = 0;
+            for (int value : v)
+                ASSERT_EQUALS(expected++, value);
+            ASSERT_EQUALS(size, expected);
+
+            for (ChunkedVector<int>::reverse_iterator it = v.rbegin(); it != v.rend(); ++it)
+                ASSERT_EQUALS(--expected, *it);
+            ASSERT_EQUALS(0, expected);
+
+            // Decrement from the end and increment to the end
+            ChunkedVector<int>::iterator it = v.end();
+            for (int i = size - 1; i >= 0; --i)
+                ASSERT_EQUALS(i, *--it);
+            ASSERT_EQUALS(true, it == v.begin());
+            for (int i = 0; i < size; ++i)
+                ASSERT_EQUALS(i, *it++);
+            ASSERT_EQUALS(true, it == v.end());
+            const ChunkedVector<int>::const_iterator cit = it;
+            ASSERT_EQUALS(true, cit == v.cend());
+
+            // Elements are assigned through the index
+            for (int i = 0; i < size; ++i)
+                v[i] = 2 * i;
+            ASSERT_EQUALS(2 * (size - 1), v.back());
+            ASSERT_EQUALS(2 * (size - 1), *v.rbegin());
+        }
+    }
+
+    void popBackChunkBoundary() const {
+        ChunkedVector<int> v;
+        for (int i = 0; i < 13; ++i)
+            v.push_back(i);
+        const int *first = &v[0];
+        const int *last = &v[11];
+
+        // Remove the only element of the third chunk and one of the second chunk
+        v.pop_back();
+        ASSERT_EQUALS(12U, v.size());
+        ASSERT_EQUALS(11, v.back());
+        v.pop_back();
+        ASSERT_EQUALS(11U, v.size());
+        ASSERT_EQUALS(10, v.back());
+        int expected = 11;
+        for (ChunkedVector<int>::const_reverse_iterator it = v.rbegin(); it != v.rend(); ++it)
+            ASSERT_EQUALS(--expected, *it);
+        ASSERT_EQUALS(0, expected);
+
+        // Add elements to the second chunk and a new third chunk
+        v.push_back(21);
+        v.push_back(22);
+        v.push_back(23);
+        ASSERT_EQUALS(14U, v.size());
+        ASSERT_EQUALS(21, v[11]);
+        ASSERT_EQUALS(22, v[12]);
+        ASSERT_EQUALS(23, v[13]);
+        ASSERT_EQUALS(true, first == &v[0]);
+        ASSERT_EQUALS(true, last == &v[11]);
+        const std::vector<int> values(v.begin(), v.end());
+        ASSERT_EQUALS(14U, values.size());
+        ASSERT_EQUALS(10, values[10]);
+        ASSERT_EQUALS(23, values[13]);
+    }
+
+    void move() const {
+        ChunkedVector<std::string> v1;
+        for (int i = 0; i < 20; ++i)
+            v1.emplace_back(std::to_string(i));
+        const std::string *address = &v1[15];
+
+        // The chunks are moved, the elements keep their addresses
+        ChunkedVector<std::string> v2(std::move(v1));
+        ASSERT_EQUALS(true, v1.empty());
+        ASSERT_EQUALS(true, v1.begin() == v1.end());
+        ASSERT_EQUALS(20U, v2.size());
+        ASSERT_EQUALS(true, address == &v2[15]);
+
+        ChunkedVector<std::string> v3;
+        v3.push_back("x");
+        v3 = std::move(v2);
+        ASSERT_EQUALS(20U, v3.size());
+        ASSERT_EQUALS("15", v3[15]);
+        ASSERT_EQUALS(true, address == &v3[15]);
+
+        v1.push_back("a");
+        ASSERT_EQUALS(1U, v1.size());
+        ASSERT_EQUALS("a", v1.front());
+    }
+};
+
+REGISTER_TEST(TestChunkedVector)
@@ -25,6 +25,8 @@
 #include "testsuite.h"
 #include "timer.h"
 
+#include <cstdio>
+#include <fstream>
 #include <list>
 #include <set>
 #include <sstream>
@@ -98,10 +100,22 @@ private:
         TEST_CASE(jobs);
         TEST_CASE(jobsMissingCount);
         TEST_CASE(jobsInvalid);
+        TEST_CASE(executor);
+        TEST_CASE(executorInvalid);
+        TEST_CASE(configJobs);
+        TEST_CASE(configJobsTooSmall);
         TEST_CASE(maxConfigs);
         TEST_CASE(maxConfigsMissingCount);
         TEST_CASE(maxConfigsInvalid);
         TEST_CASE(maxConfigsTooSmall);
+        TEST_CASE(valueFlowMaxTime);
+        TEST_CASE(valueFlowMaxTimeInvalid);
+        TEST_CASE(valueFlowJobs);
+        TEST_CASE(valueFlowJobsTooSmall);
+        TEST_CASE(distributedTimeout);
+        TEST_CASE(distributedTimeoutInvalid);
+        TEST_CASE(distributedTokenFile);
+        TEST_CASE(distributedTokenFileMissing);
         TEST_CASE(reportProgressTest); // "Test" suffix to avoid hiding the parent's reportProgress
         TEST_CASE(stdc99);
         TEST_CASE(stdcpp11);
@@ -654,6 +668,41 @@ private:
         ASSERT_EQUALS(false, defParser.parseFromArgs(4, argv));
     }
 
+    void executor() {
+        REDIRECT;
+        ASSERT_EQUALS(Settings::EXECUTOR_PROCESS, Settings().executor);
+        const char * const argv[] = {"cppcheck", "-j2", "--executor=process", "file.cpp"};
+        settings.executor = Settings::EXECUTOR_THREAD;
+        ASSERT(defParser.parseFromArgs(4, argv));
+        ASSERT_EQUALS(Settings::EXECUTOR_PROCESS, settings.executor);
+        const char * const argv2[] = {"cppcheck", "-j2", "--executor=thread", "file.cpp"};
+        ASSERT(defParser.parseFromArgs(4, argv2));
+        ASSERT_EQUALS(Settings::EXECUTOR_THREAD, settings.executor);
+    }
+
+    void executorInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--executor=fibers", "file.cpp"};
+        // Fails since the executor is unknown
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
+    void configJobs() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=4", "file.cpp"};
+        settings.configJobs = 1;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(4, settings.configJobs);
+        settings.configJobs = 1;
+    }
+
+    void configJobsTooSmall() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=0", "file.cpp"};
+        // Fails since the number of jobs must be greater than 0
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
     void maxConfigs() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "-f", "--max-configs=12", "file.cpp"};
@@ -685,6 +734,71 @@ private:
         ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
     }
 
+    void valueFlowMaxTime() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--valueflow-max-time=0", "file.cpp"};
+        settings.valueFlowMaxTime = 10;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(0, settings.valueFlowMaxTime);
+    }
+
+    void valueFlowMaxTimeInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--valueflow-max-time=e", "file.cpp"};
+        // Fails since invalid time given for --valueflow-max-time=
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
+    void distributedTimeout() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--distributed-timeout=120", "file.cpp"};
+        settings.distributedTimeout = 30;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(120, settings.distributedTimeout);
+    }
+
+    void distributedTimeoutInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--distributed-timeout=0", "file.cpp"};
+        // Fails since a worker can't answer at once
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
+    void distributedTokenFile() {
+        REDIRECT;
+        {
+            std::ofstream fout("testtoken.txt");
+            fout << "secret\r\nnot used\n";
+        }
+        const char * const argv[] = {"cppcheck", "--distributed-token-file=testtoken.txt", "file.cpp"};
+        settings.distributedToken.clear();
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS("secret", settings.distributedToken);
+        std::remove("testtoken.txt");
+    }
+
+    void distributedTokenFileMissing() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--distributed-token-file=testtoken.txt", "file.cpp"};
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
+    void valueFlowJobs() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--valueflow-jobs=4", "file.cpp"};
+        settings.valueFlowJobs = 1;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(4, settings.valueFlowJobs);
+        settings.valueFlowJobs = 1;
+    }
+
+    void valueFlowJobsTooSmall() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--valueflow-jobs=0", "file.cpp"};
+        // Fails since the number of jobs must be greater than 0
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
     void reportProgressTest() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--report-progress", "file.cpp"};
@@ -16,14 +16,24 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "analyzerinfo.h"
 #include "check.h"
 #include "cppcheck.h"
 #include "errorlogger.h"
+#include "settings.h"
 #include "testsuite.h"
+#include "tokencache.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iterator>
 #include <list>
+#include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 
 class TestCppcheck : public TestFixture {
@@ -36,12 +46,15 @@ private:
     class ErrorLogger2 : public ErrorLogger {
     public:
         std::list<std::string> id;
+        std::list<std::string> output;
 
-        void reportOut(const std::string & /*outmsg*/) {
+        void reportOut(const std::string &outmsg) {
+            output.push_back(outmsg);
         }
 
         void reportErr(const ErrorLogger::ErrorMessage &msg) {
             id.push_back(msg._id);
+            output.push_back(msg.toString(false));
         }
     };
 
@@ -49,6 +62,12 @@ private:
         TEST_CASE(instancesSorted);
         TEST_CASE(classInfoFormat);
         TEST_CASE(getErrorMessages);
+        TEST_CASE(configJobs);
+        TEST_CASE(canReport);
+        TEST_CASE(analysis);
+        TEST_CASE(reportOrder);
+        TEST_CASE(reuseResults);
+        TEST_CASE(dependenciesAsRead);
     }
 
     void instancesSorted() const {
@@ -105,6 +124,172 @@ private:
         ASSERT(foundPurgedConfiguration);
         ASSERT(foundTooManyConfigs);
     }
+
+    void canReport() const {
+        Settings settings;
+        for (const Check *check : Check::instances()) {
+            // errors are always enabled
+            const std::vector<Severity::SeverityType> severities = check->severities();
+            const bool error = std::find(severities.begin(), severities.end(), Severity::error) != severities.end();
+            ASSERT_EQUALS(error, check->canReport(&settings));
+        }
+
+        settings.addEnabled("all");
+        for (const Check *check : Check::instances())
+            ASSERT_EQUALS(true, check->canReport(&settings));
+    }
+
+    void analysis() const {
+        // moved values are only computed when the warnings about them are enabled
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.check("test.cpp", "void f() {}");
+        ASSERT_EQUALS(0, cppCheck.settings().analysis);
+
+        cppCheck.settings().addEnabled("warning");
+        cppCheck.check("test.cpp", "void f() {}");
+        ASSERT_EQUALS(Settings::MOVED_VALUES, cppCheck.settings().analysis);
+    }
+
+    void reportOrder() const {
+        // Checks that subscribe to tokens report in the order of the checks like the others
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings().addEnabled("style");
+        cppCheck.check("test.cpp", "void f() { bool b = false; b++; int x[2]; x[2] = 0; }");
+        std::string ids;
+        for (const std::string &id : errorLogger.id)
+            ids += id + " ";
+        ASSERT_EQUALS("incrementboolean arrayIndexOutOfBounds unreadVariable ", ids);
+    }
+
+    static void replaceInFile(const std::string &filename, const std::string &from, const std::string &to) {
+        std::string content;
+        {
+            std::ifstream fin(filename);
+            content.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        }
+        const std::string::size_type pos = content.find(from);
+        if (pos != std::string::npos)
+            content.replace(pos, from.size(), to);
+        std::ofstream fout(filename);
+        fout << content;
+    }
+
+    static bool hasOutput(const ErrorLogger2 &errorLogger, const std::string &text) {
+        return std::any_of(errorLogger.output.begin(), errorLogger.output.end(), [&](const std::string &s) {
+            return s.find(text) != std::string::npos;
+        });
+    }
+
+    void reuseResults() const {
+        const char code[] = "void f() { int x[2]; x[2] = 0; }\n";
+        {
+            std::ofstream fout("testreuse.c");
+            fout << code;
+        }
+
+        // The stored results are marked so that reused results can be told apart
+        {
+            ErrorLogger2 errorLogger;
+            CppCheck cppCheck(errorLogger, true);
+            cppCheck.settings().buildDir = ".";
+            cppCheck.check("testreuse.c");
+            ASSERT_EQUALS(1U, errorLogger.id.size());
+        }
+        replaceInFile("testreuse.c.analyzerinfo", "out of bounds", "reused");
+
+        {
+            ErrorLogger2 errorLogger;
+            CppCheck cppCheck(errorLogger, true);
+            cppCheck.settings().buildDir = ".";
+            cppCheck.check("testreuse.c");
+            ASSERT_EQUALS(1U, errorLogger.id.size());
+            ASSERT_EQUALS(true, hasOutput(errorLogger, "reused"));
+        }
+
+        // Another include path can change the results
+        {
+            ErrorLogger2 errorLogger;
+            CppCheck cppCheck(errorLogger, true);
+            cppCheck.settings().buildDir = ".";
+            cppCheck.settings().includePaths.push_back("include/");
+            cppCheck.check("testreuse.c");
+            ASSERT_EQUALS(1U, errorLogger.id.size());
+            ASSERT_EQUALS(true, hasOutput(errorLogger, "out of bounds"));
+        }
+
+        std::remove("testreuse.c");
+        std::remove("testreuse.c.analyzerinfo");
+        std::remove(TokenCache::getCacheFile(".", "testreuse.c").c_str());
+    }
+
+    // A file that is modified after it was read is analyzed again
+    void dependenciesAsRead() const {
+        {
+            std::ofstream fout("testdeps.c");
+            fout << "int a;\n";
+        }
+        const std::time_t readTime = std::time(nullptr);
+        std::map<std::string, TokenCache::FileStamp> files;
+        ASSERT_EQUALS(true, files["testdeps.c"].stat("testdeps.c"));
+        files["testdeps.c"].setContent("int a;\n");
+        const std::string dependencies = AnalyzerInformation::getDependencies("", files, std::set<std::string>(), readTime);
+        ASSERT(dependencies.find("hash=\"" + std::to_string(TokenCache::hash("int a;\n")) + "\"") != std::string::npos);
+
+        std::list<ErrorLogger::ErrorMessage> errors;
+        {
+            AnalyzerInformation analyzerInformation;
+            ASSERT_EQUALS(true, analyzerInformation.analyzeFile(".", "testdeps.c", "", 1, &errors, dependencies));
+        }
+        ASSERT_EQUALS(true, AnalyzerInformation::reuseResults(".", "testdeps.c", "", "", &errors));
+
+        // Same size, and likely the same modification time
+        {
+            std::ofstream fout("testdeps.c");
+            fout << "int b;\n";
+        }
+        ASSERT_EQUALS(false, AnalyzerInformation::reuseResults(".", "testdeps.c", "", "", &errors));
+
+        std::remove("testdeps.c");
+        std::remove("testdeps.c.analyzerinfo");
+    }
+
+    std::list<std::string> checkConfigurations(unsigned int configJobs, unsigned int maxConfigs) const {
+        const char code[] = "#ifdef A\n"
+                            "void fa() { char *p = malloc(10); }\n"
+                            "#endif\n"
+                            "#ifdef B\n"
+                            "#error B\n"
+                            "#endif\n"
+                            "#ifdef C\n"
+                            "void fc() { int x[2]; x[2] = 0; }\n"
+                            "#endif\n"
+                            "#ifdef D\n"
+                            "#endif\n"
+                            "#ifdef E\n"
+                            "void fe() { int *p = 0; *p = 1; }\n"
+                            "#endif\n"
+                            "void f() { int x[2]; x[2] = 0; }\n";
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings().configJobs = configJobs;
+        cppCheck.settings().maxConfigs = maxConfigs;
+        cppCheck.settings().debugwarnings = true;
+        cppCheck.check("test.c", code);
+        return errorLogger.output;
+    }
+
+    void configJobs() const {
+        // The configurations are reported in order, with the same purged and skipped configurations.
+        // Invalid configurations do not count for --max-configs.
+        for (unsigned int maxConfigs = 3; maxConfigs <= 12; maxConfigs += 9) {
+            const std::list<std::string> expected = checkConfigurations(1, maxConfigs);
+            ASSERT(expected.size() > 3);
+            const std::list<std::string> actual = checkConfigurations(4, maxConfigs);
+            ASSERT_EQUALS(true, expected == actual);
+        }
+    }
 };
 
 REGISTER_TEST(TestCppcheck)
@@ -0,0 +1,299 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cppcheck.h"
+#include "distributedexecutor.h"
+#include "settings.h"
+#include "testsuite.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef THREADING_MODEL_FORK
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+class TestDistributedExecutor : public TestFixture {
+public:
+    TestDistributedExecutor() : TestFixture("TestDistributedExecutor") {
+    }
+
+private:
+    Settings settings;
+
+    void run() OVERRIDE {
+#ifdef THREADING_MODEL_FORK
+        LOAD_LIB_2(settings.library, "std.cfg");
+        settings.quiet = true;
+
+        TEST_CASE(checkFiles);
+        TEST_CASE(lostWorker);
+        TEST_CASE(silentWorker);
+        TEST_CASE(wrongToken);
+#endif
+    }
+
+#ifdef THREADING_MODEL_FORK
+    const std::string dir = "testdistributed";
+    const std::string address = "unix:testdistributed/socket";
+
+    static void removeDirectory(const std::string &path) {
+        DIR *d = opendir(path.c_str());
+        if (!d)
+            return;
+        while (const struct dirent *entry = readdir(d)) {
+            const std::string name = entry->d_name;
+            if (name == "." || name == "..")
+                continue;
+            const std::string child = path + '/' + name;
+            struct stat st;
+            if (lstat(child.c_str(), &st) == 0 && S_ISDIR(st.st_mode))
+                removeDirectory(child);
+            else
+                std::remove(child.c_str());
+        }
+        closedir(d);
+        rmdir(path.c_str());
+    }
+
+    static bool fileExists(const std::string &path) {
+        struct stat st;
+        return stat(path.c_str(), &st) == 0;
+    }
+
+    /** Create files with a memory leak each, and the build dirs */
+    std::map<std::string, std::size_t> createFiles(int count, int workers) const {
+        removeDirectory(dir);
+        mkdir(dir.c_str(), 0777);
+        mkdir((dir + "/coordinator").c_str(), 0777);
+        for (int i = 1; i <= workers; ++i)
+            mkdir((dir + "/worker" + std::to_string(i)).c_str(), 0777);
+
+        std::map<std::string, std::size_t> files;
+        for (int i = 1; i <= count; ++i) {
+            const std::string filename = dir + "/file_" + std::to_string(i) + ".cpp";
+            std::ofstream fout(filename);
+            fout << "void f" << i << "()\n"
+                 << "{\n"
+                 << "  char *a = malloc(10);\n"
+                 << "}\n";
+            files[filename] = 50;
+        }
+        return files;
+    }
+
+    Settings coordinatorSettings() const {
+        Settings s(settings);
+        s.buildDir = dir + "/coordinator";
+        s.distributedRole = Settings::DISTRIBUTED_COORDINATOR;
+        s.distributedAddress = address;
+        return s;
+    }
+
+    Settings workerSettings(int worker) const {
+        Settings s(settings);
+        s.buildDir = dir + "/worker" + std::to_string(worker);
+        s.distributedRole = Settings::DISTRIBUTED_WORKER;
+        s.distributedAddress = address;
+        return s;
+    }
+
+    static unsigned int countLines(const std::string &str) {
+        unsigned int lines = 0;
+        for (char c : str)
+            lines += (c == '\n') ? 1U : 0U;
+        return lines;
+    }
+
+    void checkFiles() {
+        errout.str("");
+        const std::map<std::string, std::size_t> files = createFiles(10, 3);
+
+        Settings settings1 = coordinatorSettings();
+        std::vector<Settings> settings2;
+        for (int i = 1; i <= 3; ++i)
+            settings2.push_back(workerSettings(i));
+
+        std::vector<std::thread> workers;
+        for (Settings &s : settings2) {
+            workers.emplace_back([&s]() {
+                DistributedWorker worker(s);
+                worker.run();
+            });
+        }
+
+        DistributedExecutor executor(files, settings1, *this);
+        const unsigned int result = executor.check();
+        for (std::thread &t : workers)
+            t.join();
+
+        ASSERT_EQUALS(10U, result);
+        ASSERT_EQUALS(10U, countLines(errout.str()));
+        ASSERT(errout.str().find("[testdistributed/file_7.cpp:4]: (error) Memory leak: a") != std::string::npos);
+
+        // The analyzerinfo files are collected in the build dir of the coordinator
+        ASSERT_EQUALS(true, fileExists(dir + "/coordinator/file_1.cpp.analyzerinfo"));
+        ASSERT_EQUALS(true, fileExists(dir + "/coordinator/file_10.cpp.analyzerinfo"));
+        ASSERT_EQUALS(true, fileExists(dir + "/coordinator/filetimes.txt"));
+
+        removeDirectory(dir);
+    }
+
+    static void appendInt(std::string &out, unsigned int value) {
+        const uint32_t n = htonl(value);
+        out.append(reinterpret_cast<const char *>(&n), sizeof(n));
+    }
+
+    static void appendString(std::string &out, const std::string &str) {
+        appendInt(out, static_cast<unsigned int>(str.size()));
+        out += str;
+    }
+
+    /**
+     * Connect, take one file and disconnect without checking it. A silent
+     * worker keeps the connection open until the coordinator closes it.
+     */
+    static void fakeWorker(const std::string &socketPath, const std::string &token, bool silent) {
+        struct sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, socketPath.c_str());
+        int fd = -1;
+        for (int attempt = 0; attempt < 100 && fd < 0; ++attempt) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(attempt > 0 ? 100 : 0));
+            fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (connect(fd, reinterpret_cast<const struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+        if (fd < 0)
+            return;
+
+        const std::string version = CppCheck::version();
+        std::string hello;
+        appendString(hello, version);
+        appendString(hello, token);
+        std::string frame(1, static_cast<char>(DistributedExecutor::HELLO));
+        appendInt(frame, static_cast<unsigned int>(hello.size()));
+        frame += hello;
+        if (write(fd, frame.data(), frame.size()) == static_cast<ssize_t>(frame.size())) {
+            char buf[1024];
+            ssize_t res;
+            while ((res = read(fd, buf, sizeof(buf))) < 0 && errno == EINTR)
+                ;
+            while (silent && (res > 0 || (res < 0 && errno == EINTR)))
+                res = read(fd, buf, sizeof(buf));
+        }
+        close(fd);
+    }
+
+    void lostWorker() {
+        errout.str("");
+        const std::map<std::string, std::size_t> files = createFiles(3, 1);
+
+        Settings settings1 = coordinatorSettings();
+        Settings settings2 = workerSettings(1);
+
+        // The real worker connects when the fake worker has taken a file
+        std::thread workers([&settings2, this]() {
+            fakeWorker(address.substr(5), emptyString, false);
+            DistributedWorker worker(settings2);
+            worker.run();
+        });
+
+        DistributedExecutor executor(files, settings1, *this);
+        const unsigned int result = executor.check();
+        workers.join();
+
+        ASSERT_EQUALS(3U, result);
+        ASSERT_EQUALS(3U, countLines(errout.str()));
+
+        removeDirectory(dir);
+    }
+
+    void silentWorker() {
+        errout.str("");
+        const std::map<std::string, std::size_t> files = createFiles(3, 1);
+
+        Settings settings1 = coordinatorSettings();
+        settings1.distributedTimeout = 2;
+        Settings settings2 = workerSettings(1);
+
+        // The real worker connects when the coordinator has given up the silent worker
+        std::thread workers([&settings2, this]() {
+            fakeWorker(address.substr(5), emptyString, true);
+            DistributedWorker worker(settings2);
+            worker.run();
+        });
+
+        DistributedExecutor executor(files, settings1, *this);
+        const unsigned int result = executor.check();
+        workers.join();
+
+        ASSERT_EQUALS(3U, result);
+        ASSERT_EQUALS(3U, countLines(errout.str()));
+
+        removeDirectory(dir);
+    }
+
+    void wrongToken() {
+        errout.str("");
+        output.str("");
+        const std::map<std::string, std::size_t> files = createFiles(3, 1);
+
+        Settings settings1 = coordinatorSettings();
+        settings1.distributedToken = "secret";
+        Settings settings2 = workerSettings(1);
+        settings2.distributedToken = "secret";
+
+        // The fake worker would take a file and keep it, but it is rejected
+        std::thread workers([&settings2, this]() {
+            fakeWorker(address.substr(5), "guess", true);
+            DistributedWorker worker(settings2);
+            worker.run();
+        });
+
+        DistributedExecutor executor(files, settings1, *this);
+        const unsigned int result = executor.check();
+        workers.join();
+
+        ASSERT_EQUALS(3U, result);
+        ASSERT_EQUALS(3U, countLines(errout.str()));
+        ASSERT_EQUALS(true, output.str().find("Rejected worker that does not know the token") != std::string::npos);
+
+        removeDirectory(dir);
+    }
+#endif
+};
+
+REGISTER_TEST(TestDistributedExecutor)
@@ -11,11 +11,14 @@ SOURCES += $${BASEPATH}/test64bit.cpp \
            $${BASEPATH}/testboost.cpp \
            $${BASEPATH}/testbufferoverrun.cpp \
            $${BASEPATH}/testcharvar.cpp \
+           $${BASEPATH}/testchunkedvector.cpp \
+           $${BASEPATH}/testchunkedvector.cpp \
            $${BASEPATH}/testclass.cpp \
            $${BASEPATH}/testcmdlineparser.cpp \
            $${BASEPATH}/testcondition.cpp \
            $${BASEPATH}/testconstructors.cpp \
            $${BASEPATH}/testcppcheck.cpp \
+           $${BASEPATH}/testdistributedexecutor.cpp \
            $${BASEPATH}/testerrorlogger.cpp \
            $${BASEPATH}/testexceptionsafety.cpp \
            $${BASEPATH}/testfilelister.cpp \
@@ -52,6 +55,7 @@ SOURCES += $${BASEPATH}/test64bit.cpp \
            $${BASEPATH}/testthreadexecutor.cpp \
            $${BASEPATH}/testtimer.cpp \
            $${BASEPATH}/testtoken.cpp \
+           $${BASEPATH}/testtokencache.cpp \
            $${BASEPATH}/testtokenize.cpp \
            $${BASEPATH}/testtokenlist.cpp \
            $${BASEPATH}/testtype.cpp \
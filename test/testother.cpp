@@ -56,6 +56,7 @@ private:
         TEST_CASE(zeroDiv10);
         TEST_CASE(zeroDiv11);
         TEST_CASE(zeroDiv12);
+        TEST_CASE(zeroDiv13);
 
         TEST_CASE(zeroDivCond); // division by zero / useless condition
 
@@ -541,6 +542,18 @@ private:
         ASSERT_EQUALS("[test.cpp:2]: (error) Division by zero.\n", errout.str());
     }
 
+    void zeroDiv13() {
+        // more case values than a token can store
+        check("int f(int x) {\n"
+              "  switch (x) {\n"
+              "  case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8: case 9: case 10: case 11:\n"
+              "    return 100 / x;\n"
+              "  }\n"
+              "  return 0;\n"
+              "}");
+        ASSERT_EQUALS("[test.cpp:3] -> [test.cpp:4]: (warning) Either the switch case 'case 0' is redundant or there is division by zero at line 4.\n", errout.str());
+    }
+
     void zeroDivCond() {
         check("void f(unsigned int x) {\n"
               "  int y = 17 / x;\n"
@@ -26,7 +26,9 @@
 #include "testsuite.h"
 
 #include <simplecpp.h>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <list>
 #include <map>
 #include <set>
@@ -246,6 +248,9 @@ private:
         TEST_CASE(testDirectiveIncludeTypes);
         TEST_CASE(testDirectiveIncludeLocations);
         TEST_CASE(testDirectiveIncludeComments);
+
+        TEST_CASE(headerCache);
+        TEST_CASE(headerCacheLimit);
     }
 
     void preprocess(const char* code, std::map<std::string, std::string>& actual, const char filename[] = "file.c") {
@@ -2370,6 +2375,70 @@ private:
         preprocessor.dump(ostr);
         ASSERT_EQUALS(dumpdata, ostr.str());
     }
+
+    std::string loadHeader(const std::vector<std::string> &initialFiles) {
+        const char code[] = "#include \"testheadercache.h\"\n"
+                            "int x;\n";
+        std::vector<std::string> files(initialFiles);
+        std::istringstream istr(code);
+        simplecpp::TokenList tokens1(istr, files, "test.c");
+        Preprocessor preprocessor(settings0, this);
+        preprocessor.loadFiles(tokens1, files);
+        preprocessor.setDirectives(tokens1);
+
+        std::ostringstream ostr;
+        preprocessor.dump(ostr);
+        return ostr.str() + preprocessor.getcode(tokens1, "", files, true);
+    }
+
+    void headerCache() {
+        {
+            std::ofstream fout("testheadercache.h");
+            fout << "#define X 1\n"
+                 << "int y;\n";
+        }
+
+        // The second translation unit gets the cached tokens of the header, with its own file indexes
+        const std::string first = loadHeader(std::vector<std::string>());
+        const std::string second = loadHeader(std::vector<std::string>(1, "other.c"));
+        std::remove("testheadercache.h");
+        ASSERT(first.find("testheadercache.h") != std::string::npos);
+        ASSERT(first.find("#line 2 \"test.c\"") != std::string::npos);
+        ASSERT_EQUALS(first, second);
+    }
+
+    static void loadCached(HeaderCache &cache, const std::string &filename) {
+        std::vector<std::string> files;
+        std::ifstream fin(filename);
+        delete cache.load(fin, files, filename, nullptr, emptyString);
+    }
+
+    void headerCacheLimit() {
+        {
+            std::ofstream fout1("testheadercache1.h");
+            fout1 << "int a;\n";
+            std::ofstream fout2("testheadercache2.h");
+            fout2 << "int b;\n";
+        }
+
+        // Only one of the 7 byte headers fits, the least recently used is removed
+        HeaderCache cache(10);
+        loadCached(cache, "testheadercache1.h");
+        ASSERT_EQUALS(1U, cache.size());
+        ASSERT_EQUALS(7U, cache.bytes());
+        loadCached(cache, "testheadercache2.h");
+        ASSERT_EQUALS(1U, cache.size());
+        ASSERT_EQUALS(7U, cache.bytes());
+
+        // Headers that are larger than the limit are not cached
+        HeaderCache small(5);
+        loadCached(small, "testheadercache1.h");
+        ASSERT_EQUALS(0U, small.size());
+        ASSERT_EQUALS(0U, small.bytes());
+
+        std::remove("testheadercache1.h");
+        std::remove("testheadercache2.h");
+    }
 };
 
 REGISTER_TEST(TestPreprocessor)
@@ -27,6 +27,7 @@
 #include "utils.h"
 
 #include <climits>
+#include <limits>
 #include <cstddef>
 #include <list>
 #include <map>
@@ -75,7 +76,7 @@ private:
     }
 
     static const Scope *findFunctionScopeByToken(const SymbolDatabase * db, const Token *tok) {
-        std::list<Scope>::const_iterator scope;
+        ChunkedVector<Scope>::const_iterator scope;
 
         for (scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
             if (scope->type == Scope::eFunction) {
@@ -95,7 +96,7 @@ private:
                 currScope = currScope->nestedIn;
         }
         while (currScope) {
-            for (std::list<Function>::const_iterator i = currScope->functionList.begin(); i != currScope->functionList.end(); ++i) {
+            for (ChunkedVector<Function>::const_iterator i = currScope->functionList.begin(); i != currScope->functionList.end(); ++i) {
                 if (i->tokenDef->str() == str)
                     return &*i;
             }
@@ -309,6 +310,9 @@ private:
         TEST_CASE(enum6);
         TEST_CASE(enum7);
 
+        TEST_CASE(scopeIndexes1);
+        TEST_CASE(scopeIndexes2);
+
         TEST_CASE(sizeOfType);
 
         TEST_CASE(isImplicitlyVirtual);
@@ -1474,8 +1478,8 @@ private:
 
         if (db) {
             bool seen_something = false;
-            for (std::list<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
-                for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+            for (ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
+                for (ChunkedVector<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
                     ASSERT_EQUALS("Sub", func->token->str());
                     ASSERT_EQUALS(true, func->hasBody());
                     ASSERT_EQUALS(Function::eConstructor, func->type);
@@ -1748,10 +1752,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            ChunkedVector<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                ChunkedVector<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "i");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -1763,10 +1767,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            ChunkedVector<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                ChunkedVector<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "array");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -1778,10 +1782,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            ChunkedVector<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                ChunkedVector<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "array");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -2125,7 +2129,7 @@ private:
         if (db) {
             ASSERT_EQUALS(3, db->scopeList.size());
             if (db->scopeList.size() == 3) {
-                std::list<Scope>::const_iterator scope = db->scopeList.begin();
+                ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
                 ++scope;
                 ASSERT_EQUALS((unsigned int)Scope::eClass, (unsigned int)scope->type);
                 ASSERT_EQUALS(1, scope->functionList.size());
@@ -2149,7 +2153,7 @@ private:
         if (db) {
             ASSERT_EQUALS(3, db->scopeList.size());
             if (db->scopeList.size() == 3) {
-                std::list<Scope>::const_iterator scope = db->scopeList.begin();
+                ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
                 ++scope;
                 ASSERT_EQUALS((unsigned int)Scope::eClass, (unsigned int)scope->type);
                 ASSERT_EQUALS(1, scope->functionList.size());
@@ -2254,7 +2258,7 @@ private:
 
         // Locate the scope for the class..
         const Scope *scope = nullptr;
-        for (std::list<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
+        for (ChunkedVector<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
             if (it->isClassOrStruct()) {
                 scope = &(*it);
                 break;
@@ -2288,7 +2292,7 @@ private:
 
         // Locate the scope for the class..
         const Scope *scope = nullptr;
-        for (std::list<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
+        for (ChunkedVector<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
             if (it->isClassOrStruct()) {
                 scope = &(*it);
                 break;
@@ -2577,7 +2581,7 @@ private:
 
         // Find the scope for the Fred struct..
         const Scope *fredScope = nullptr;
-        for (std::list<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
+        for (ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
             if (scope->isClassOrStruct() && scope->className == "Fred")
                 fredScope = &(*scope);
         }
@@ -2591,7 +2595,7 @@ private:
         // Get linenumbers where the bodies for the constructor and destructor are..
         unsigned int constructor = 0;
         unsigned int destructor = 0;
-        for (std::list<Function>::const_iterator it = fredScope->functionList.begin(); it != fredScope->functionList.end(); ++it) {
+        for (ChunkedVector<Function>::const_iterator it = fredScope->functionList.begin(); it != fredScope->functionList.end(); ++it) {
             if (it->type == Function::eConstructor)
                 constructor = it->token->linenr();  // line number for constructor body
             if (it->type == Function::eDestructor)
@@ -2684,7 +2688,7 @@ private:
         ASSERT(db && db->typeList.size() == 5);
         if (!db || db->typeList.size() < 5)
             return;
-        std::list<Type>::const_iterator i = db->typeList.begin();
+        ChunkedVector<Type>::const_iterator i = db->typeList.begin();
         const Type* Foo = &(*i++);
         const Type* Bar = &(*i++);
         const Type* Sub = &(*i++);
@@ -2753,7 +2757,7 @@ private:
         ASSERT(db && db->typeList.size() == 3);
         if (!db || db->typeList.size() != 3)
             return;
-        std::list<Type>::const_iterator i = db->typeList.begin();
+        ChunkedVector<Type>::const_iterator i = db->typeList.begin();
         const Type* Fred = &(*i++);
         const Type* Wilma = &(*i++);
         const Type* Barney = &(*i++);
@@ -2843,7 +2847,7 @@ private:
             ASSERT(db->getVariableFromVarId(i) != nullptr);
 
         ASSERT_EQUALS(4U, db->scopeList.size());
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
         ASSERT_EQUALS(Scope::eGlobal, scope->type);
         ++scope;
         ASSERT_EQUALS(Scope::eStruct, scope->type);
@@ -2861,7 +2865,7 @@ private:
 
         ASSERT(db != nullptr);
         ASSERT_EQUALS(4U, db->scopeList.size());
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
         ASSERT_EQUALS(Scope::eGlobal, scope->type);
         ++scope;
         ASSERT_EQUALS(Scope::eStruct, scope->type);
@@ -3069,7 +3073,7 @@ private:
         if (db) {
             ASSERT(db->scopeList.size() == 4U);
             if (db->scopeList.size() == 4U) {
-                std::list<Scope>::const_iterator it = db->scopeList.begin();
+                ChunkedVector<Scope>::const_iterator it = db->scopeList.begin();
                 ASSERT(it->type == Scope::eGlobal);
                 ASSERT((++it)->type == Scope::eFunction);
                 ASSERT((++it)->type == Scope::eIf);
@@ -3093,7 +3097,7 @@ private:
         if (db) {
             ASSERT(db->typeList.size() == 3U);
             if (db->typeList.size() == 3U) {
-                std::list<Type>::const_iterator it = db->typeList.begin();
+                ChunkedVector<Type>::const_iterator it = db->typeList.begin();
                 const Type * classB = &(*it);
                 const Type * classC = &(*(++it));
                 const Type * classA = &(*(++it));
@@ -4282,7 +4286,7 @@ private:
         ASSERT_EQUALS(3U, db->scopeList.size());
 
         // Assert that all enum values are known
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
 
         // Offsets
         ++scope;
@@ -4371,7 +4375,7 @@ private:
         ASSERT_EQUALS(2U, db->scopeList.size());
 
         // Assert that all enum values are known
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
 
         ++scope;
         ASSERT_EQUALS((unsigned int)Scope::eEnum, (unsigned int)scope->type);
@@ -4490,6 +4494,129 @@ private:
         TEST(settings1.sizeof_long_long);
     }
 
+    // The indexes of the scopes give the first match of a search in the lists
+    void checkScopeIndexes(const SymbolDatabase *db) {
+        for (const Scope &scope : db->scopeList) {
+            const Scope *firstByName = nullptr;
+            for (const Scope &s : db->scopeList) {
+                if (s.className == scope.className) {
+                    firstByName = &s;
+                    break;
+                }
+            }
+            ASSERT_EQUALS_MSG(true, db->findScopeByName(scope.className) == firstByName, scope.className);
+
+            for (const Scope *nested : scope.nestedList) {
+                const Scope *firstNested = nullptr;
+                for (const Scope *s : scope.nestedList) {
+                    if (s->className == nested->className) {
+                        firstNested = s;
+                        break;
+                    }
+                }
+                ASSERT_EQUALS_MSG(true, const_cast<Scope &>(scope).findInNestedList(nested->className) == firstNested, nested->className);
+
+                for (const Enumerator &enumerator : nested->enumeratorList) {
+                    const Enumerator *firstEnumerator = nullptr;
+                    for (const Scope *s : scope.nestedList) {
+                        for (const Enumerator &e : s->enumeratorList) {
+                            if (!firstEnumerator && e.name->str() == enumerator.name->str())
+                                firstEnumerator = &e;
+                        }
+                    }
+                    ASSERT_EQUALS_MSG(true, scope.findNestedEnumerator(enumerator.name->str()) == firstEnumerator, enumerator.name->str());
+                }
+            }
+
+            for (const Enumerator &enumerator : scope.enumeratorList) {
+                const Enumerator *firstEnumerator = nullptr;
+                for (const Enumerator &e : scope.enumeratorList) {
+                    if (e.name->str() == enumerator.name->str()) {
+                        firstEnumerator = &e;
+                        break;
+                    }
+                }
+                ASSERT_EQUALS_MSG(true, scope.findEnumerator(enumerator.name->str()) == firstEnumerator, enumerator.name->str());
+            }
+        }
+    }
+
+    void scopeIndexes1() {
+        // Scopes with the same name, nested types and enums, and function
+        // scopes that are added for member functions defined outside the class
+        GET_SYMBOL_DB("namespace A {\n"
+                      "    struct S { enum E { X, Y }; void f(); struct N {}; };\n"
+                      "    enum class F { Y, Z };\n"
+                      "}\n"
+                      "namespace B {\n"
+                      "    struct S { enum { X = 3 }; };\n"
+                      "    namespace A { struct T {}; }\n"
+                      "}\n"
+                      "namespace A { struct U {}; }\n"
+                      "void A::S::f() {\n"
+                      "    if (X) { auto l = []() { return Y; }; }\n"
+                      "    for (;;) {}\n"
+                      "}\n"
+                      "enum G { X2, Y2 };\n");
+        ASSERT(db != nullptr);
+        if (!db)
+            return;
+        checkScopeIndexes(db);
+
+        const Scope *a = db->findScopeByName("A");
+        ASSERT(a && a->type == Scope::eNamespace);
+        const Scope *s = db->findScopeByName("S");
+        ASSERT(s && s->nestedIn == a);
+        ASSERT(a && a->findRecordInNestedList("S") == s);
+        ASSERT(s && s->findRecordInNestedList("N") && s->findRecordInNestedList("N")->nestedIn == s);
+
+        // The reopened namespace is the same scope
+        ASSERT(db->findScopeByName("U") && db->findScopeByName("U")->nestedIn == a);
+        ASSERT(db->findScopeByName("T") && db->findScopeByName("T")->nestedIn->nestedIn->className == "B");
+
+        // Enumerators of the enums of a scope
+        ASSERT(s && s->findNestedEnumerator("X") && s->findNestedEnumerator("X")->value == 0);
+        ASSERT(s && s->findNestedEnumerator("Y") && s->findNestedEnumerator("Y")->value == 1);
+        ASSERT(s && s->findNestedEnumerator("Z") == nullptr);
+        ASSERT(a && a->findNestedEnumerator("Z") && a->findNestedEnumerator("Z")->value == 1);
+        ASSERT(db->scopeList.front().findNestedEnumerator("Y2") && db->scopeList.front().findNestedEnumerator("Y2")->value == 1);
+
+        // The scopes of the function body are nested in the function scope
+        const Scope *f = db->findScopeByName("f");
+        ASSERT(f && f->type == Scope::eFunction && f->functionOf == s);
+        ASSERT(f && f->nestedList.size() == 2U);
+    }
+
+    void scopeIndexes2() {
+        // Enumerators with the same name in different enums of a scope, the first enum is found
+        GET_SYMBOL_DB("struct S {\n"
+                      "    enum class E1 { A, B = 5 };\n"
+                      "    struct N { enum class E3 { B = 7 }; };\n"
+                      "    enum class E2 { B = 2, C };\n"
+                      "    struct N2 {};\n"
+                      "};\n"
+                      "struct S;\n"
+                      "struct S2 : S { enum { B = 9 }; };\n");
+        ASSERT(db != nullptr);
+        if (!db)
+            return;
+        checkScopeIndexes(db);
+
+        const Scope *s = db->findScopeByName("S");
+        ASSERT(s && s->nestedList.size() == 4U);
+        ASSERT(s && s->findNestedEnumerator("B") && s->findNestedEnumerator("B")->value == 5);
+        ASSERT(s && s->findNestedEnumerator("C") && s->findNestedEnumerator("C")->value == 3);
+        ASSERT(s && s->findRecordInNestedList("N2") && s->findRecordInNestedList("N2")->className == "N2");
+
+        const Scope *e2 = db->findScopeByName("E2");
+        ASSERT(e2 && e2->findEnumerator("B") && e2->findEnumerator("B")->value == 2);
+        ASSERT(e2 && e2->findEnumerator("A") == nullptr);
+        const Scope *n = db->findScopeByName("N");
+        ASSERT(n && n->findNestedEnumerator("B") && n->findNestedEnumerator("B")->value == 7);
+        const Scope *s2 = db->findScopeByName("S2");
+        ASSERT(s2 && s2->findNestedEnumerator("B") && s2->findNestedEnumerator("B")->value == 9);
+    }
+
     void sizeOfType() {
         // #7615 - crash in Symboldatabase::sizeOfType()
         GET_SYMBOL_DB("enum e;\n"
@@ -4625,7 +4752,7 @@ private:
                       "};");
         ASSERT(db && db->scopeList.back().functionList.size() == 4);
         if (db && db->scopeList.back().functionList.size() == 4) {
-            std::list<Function>::const_iterator it = db->scopeList.back().functionList.begin();
+            ChunkedVector<Function>::const_iterator it = db->scopeList.back().functionList.begin();
             ASSERT((it++)->isPure());
             ASSERT((it++)->isPure());
             ASSERT(!(it++)->isPure());
@@ -5855,7 +5982,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eFunction, scope->type);
@@ -5876,7 +6003,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eFunction, scope->type);
@@ -5893,7 +6020,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eFunction, scope->type);
@@ -5926,7 +6053,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            ChunkedVector<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eClass, scope->type);
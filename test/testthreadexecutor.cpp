@@ -16,15 +16,26 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "framing.h"
+#include "preprocessor.h"
 #include "settings.h"
 #include "testsuite.h"
 #include "threadexecutor.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <list>
 #include <map>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
+
+#ifdef THREADING_MODEL_FORK
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 class TestThreadExecutor : public TestFixture {
 public:
@@ -61,6 +72,13 @@ private:
         ASSERT_EQUALS(result, executor.check());
     }
 
+    void check(Settings::ExecutorType executor, unsigned int jobs, int files, int result, const std::string &data) {
+        const Settings::ExecutorType oldExecutor = settings.executor;
+        settings.executor = executor;
+        check(jobs, files, result, data);
+        settings.executor = oldExecutor;
+    }
+
     void run() OVERRIDE {
         LOAD_LIB_2(settings.library, "std.cfg");
 
@@ -71,6 +89,17 @@ private:
         TEST_CASE(no_errors_equal_amount_files);
         TEST_CASE(one_error_less_files);
         TEST_CASE(one_error_several_files);
+        TEST_CASE(thread_executor);
+        TEST_CASE(thread_executor_output);
+        TEST_CASE(same_results_in_executors);
+        TEST_CASE(schedule_by_size);
+        TEST_CASE(schedule_by_history);
+        TEST_CASE(steal_expensive_files);
+        TEST_CASE(framing_encode);
+        TEST_CASE(framing_incomplete);
+        TEST_CASE(framing_truncated_payload);
+        TEST_CASE(framing_message);
+        TEST_CASE(framing_pipe);
     }
 
     void deadlock_with_many_errors() {
@@ -135,6 +164,313 @@ private:
               "  return 0;\n"
               "}");
     }
+
+    void thread_executor() {
+        check(Settings::EXECUTOR_THREAD, 2, 3, 0,
+              "int main()\n"
+              "{\n"
+              "  return 0;\n"
+              "}");
+        check(Settings::EXECUTOR_THREAD, 2, 20, 20,
+              "int main()\n"
+              "{\n"
+              "  {char *a = malloc(10);}\n"
+              "  return 0;\n"
+              "}");
+    }
+
+    void thread_executor_output() {
+        // Identical findings in different files are all reported
+        check(Settings::EXECUTOR_THREAD, 4, 10, 10,
+              "int main()\n"
+              "{\n"
+              "  {char *a = malloc(10);}\n"
+              "  return 0;\n"
+              "}");
+        for (int i = 1; i <= 10; ++i) {
+            std::ostringstream oss;
+            oss << "[file_" << i << ".cpp:4]: (error) Memory leak: a\n";
+            ASSERT(errout.str().find(oss.str()) != std::string::npos);
+        }
+    }
+
+    /** Sorted messages and missing include flags of a check with @p executor */
+    std::string executorResults(Settings::ExecutorType executor, const std::string &data) {
+        Preprocessor::missingIncludeFlag = false;
+        Preprocessor::missingSystemIncludeFlag = false;
+        check(executor, 3, 4, 4, data);
+
+        std::vector<std::string> lines;
+        std::istringstream istr(errout.str());
+        std::string line;
+        while (std::getline(istr, line))
+            lines.push_back(line);
+        std::sort(lines.begin(), lines.end());
+
+        std::string ret;
+        for (const std::string &l : lines)
+            ret += l + "\n";
+        ret += Preprocessor::missingIncludeFlag ? "missingInclude\n" : "";
+        ret += Preprocessor::missingSystemIncludeFlag ? "missingIncludeSystem\n" : "";
+        Preprocessor::missingIncludeFlag = false;
+        Preprocessor::missingSystemIncludeFlag = false;
+        return ret;
+    }
+
+    void same_results_in_executors() {
+        // The missing includes of the files are known after the check, like with one job
+        const char code[] = "#include \"missing.h\"\n"
+                            "#include <missing_system.h>\n"
+                            "int main()\n"
+                            "{\n"
+                            "  {char *a = malloc(10);}\n"
+                            "  return 0;\n"
+                            "}";
+        const std::string expected = executorResults(Settings::EXECUTOR_PROCESS, code);
+        ASSERT_EQUALS("[file_1.cpp:6]: (error) Memory leak: a\n"
+                      "[file_2.cpp:6]: (error) Memory leak: a\n"
+                      "[file_3.cpp:6]: (error) Memory leak: a\n"
+                      "[file_4.cpp:6]: (error) Memory leak: a\n"
+                      "missingInclude\n"
+                      "missingIncludeSystem\n", expected);
+        ASSERT_EQUALS(expected, executorResults(Settings::EXECUTOR_THREAD, code));
+    }
+
+    static std::string scheduleOrder(const std::vector<ThreadExecutor::ScheduledFile> &schedule) {
+        std::string ret;
+        for (std::size_t i = 0; i < schedule.size(); ++i)
+            ret += (i > 0 ? " " : "") + *schedule[i].file;
+        return ret;
+    }
+
+    void schedule_by_size() {
+        std::map<std::string, std::size_t> files;
+        files["a.cpp"] = 10;
+        files["b.cpp"] = 1000;
+        files["c.cpp"] = 100;
+        files["d.cpp"] = 100;
+        const std::vector<ThreadExecutor::ScheduledFile> schedule = ThreadExecutor::scheduleFiles(files, std::list<ImportProject::FileSettings>(), std::map<std::string, unsigned long long>());
+        ASSERT_EQUALS("b.cpp c.cpp d.cpp a.cpp", scheduleOrder(schedule));
+        ASSERT_EQUALS(1000U, schedule[0].cost);
+    }
+
+    void schedule_by_history() {
+        std::map<std::string, std::size_t> files;
+        files["a.cpp"] = 10;
+        files["b.cpp"] = 1000;
+        files["c.cpp"] = 100;
+        std::map<std::string, unsigned long long> fileTimes;
+        fileTimes[":a.cpp"] = 5000;
+        fileTimes[":b.cpp"] = 1000;
+        fileTimes[":removed.cpp"] = 100000;
+        // c.cpp has no history, it is estimated from the time per byte of a.cpp and b.cpp
+        const std::vector<ThreadExecutor::ScheduledFile> schedule = ThreadExecutor::scheduleFiles(files, std::list<ImportProject::FileSettings>(), fileTimes);
+        ASSERT_EQUALS("a.cpp b.cpp c.cpp", scheduleOrder(schedule));
+        ASSERT_EQUALS(5000U, schedule[0].cost);
+        ASSERT_EQUALS(594U, schedule[2].cost);
+    }
+
+#if defined(THREADING_MODEL_FORK)
+    /** Time until @p workers are done with the files of @p costs, with the work queue of the thread backend */
+    static std::size_t simulatedTime(const std::vector<std::size_t> &costs, std::size_t workers) {
+        std::vector<ThreadExecutor::ScheduledFile> files(costs.size());
+        for (std::size_t i = 0; i < costs.size(); ++i)
+            files[i].cost = costs[i];
+
+        ThreadExecutor::WorkQueue queue(workers);
+        for (std::size_t i = 0; i < files.size(); ++i)
+            queue.push(i, &files[i]);
+
+        // The next free worker takes the next file
+        std::vector<std::size_t> freeAt(workers, 0);
+        std::vector<bool> done(workers, false);
+        std::size_t end = 0;
+        for (;;) {
+            std::size_t worker = workers;
+            for (std::size_t w = 0; w < workers; ++w) {
+                if (!done[w] && (worker == workers || freeAt[w] < freeAt[worker]))
+                    worker = w;
+            }
+            if (worker == workers)
+                return end;
+            const ThreadExecutor::ScheduledFile *file;
+            if (queue.pop(worker, &file))
+                freeAt[worker] += file->cost;
+            else
+                done[worker] = true;
+            end = std::max(end, freeAt[worker]);
+        }
+    }
+
+#endif
+
+    void steal_expensive_files() {
+#if defined(THREADING_MODEL_FORK)
+        // One worker is busy with the most expensive file while the other one
+        // takes the long files that were dealt to the busy worker
+        const std::size_t costs[] = {100, 50, 50, 5, 5, 5, 5, 2, 1, 1};
+        ASSERT_EQUALS(113U, simulatedTime(std::vector<std::size_t>(costs, costs + 10), 2));
+
+        const std::size_t costs2[] = {100, 60, 60, 1, 1, 1, 1, 1, 1, 1};
+        ASSERT_EQUALS(124U, simulatedTime(std::vector<std::size_t>(costs2, costs2 + 10), 2));
+        ASSERT_EQUALS(100U, simulatedTime(std::vector<std::size_t>(costs2, costs2 + 10), 3));
+#endif
+    }
+
+    void framing_encode() {
+        std::string out;
+        Framing::appendInt(out, 0x01020304U);
+        ASSERT_EQUALS(std::string("\x01\x02\x03\x04", 4), out);
+
+        out.clear();
+        Framing::appendString(out, "ab");
+        ASSERT_EQUALS(std::string("\0\0\0\x02" "ab", 6), out);
+
+        // Two frames back to back
+        out.clear();
+        Framing::appendFrame(out, 'x', "abc");
+        Framing::appendFrame(out, 'y', "");
+        ASSERT_EQUALS(2 * Framing::HEADER_SIZE + 3U, out.size());
+
+        char type = 0;
+        std::size_t len = 0;
+        ASSERT_EQUALS(1, Framing::peekFrame(out, 0, &type, &len));
+        ASSERT_EQUALS('x', type);
+        ASSERT_EQUALS(3U, len);
+        ASSERT_EQUALS("abc", out.substr(Framing::HEADER_SIZE, len));
+        ASSERT_EQUALS(1, Framing::peekFrame(out, Framing::HEADER_SIZE + 3U, &type, &len));
+        ASSERT_EQUALS('y', type);
+        ASSERT_EQUALS(0U, len);
+        ASSERT_EQUALS(0, Framing::peekFrame(out, out.size(), &type, &len));
+
+        std::string payload;
+        Framing::appendInt(payload, 7U);
+        Framing::appendString(payload, "hello");
+        Framing::PayloadReader reader(payload.data(), payload.size());
+        ASSERT_EQUALS(7U, reader.readInt());
+        ASSERT_EQUALS("hello", reader.readString());
+        ASSERT_EQUALS(false, reader.error());
+    }
+
+    void framing_incomplete() {
+        std::string frame;
+        Framing::appendFrame(frame, 'x', "abcdef");
+
+        // Nothing is returned until the whole frame is there
+        char type = 0;
+        std::size_t len = 0;
+        for (std::size_t size = 0; size < frame.size(); ++size)
+            ASSERT_EQUALS(0, Framing::peekFrame(frame.substr(0, size), 0, &type, &len));
+        ASSERT_EQUALS(1, Framing::peekFrame(frame, 0, &type, &len));
+
+        // Too large frames are errors, even before their payload is there
+        std::string large(1, 'x');
+        Framing::appendInt(large, static_cast<unsigned int>(Framing::MAX_FRAME_SIZE + 1U));
+        ASSERT_EQUALS(-1, Framing::peekFrame(large, 0, &type, &len));
+    }
+
+    void framing_truncated_payload() {
+        const std::string shortInt("\0\0", 2);
+        Framing::PayloadReader reader1(shortInt.data(), shortInt.size());
+        ASSERT_EQUALS(0U, reader1.readInt());
+        ASSERT_EQUALS(true, reader1.error());
+
+        std::string shortString;
+        Framing::appendString(shortString, "hello");
+        shortString.resize(shortString.size() - 1U);
+        Framing::PayloadReader reader2(shortString.data(), shortString.size());
+        ASSERT_EQUALS("", reader2.readString());
+        ASSERT_EQUALS(true, reader2.error());
+
+        std::string index;
+        Framing::appendInt(index, 2U);
+        const std::vector<std::string> strings(2, "s");
+        Framing::PayloadReader reader3(index.data(), index.size());
+        ASSERT_EQUALS("", reader3.readInterned(strings));
+        ASSERT_EQUALS(true, reader3.error());
+    }
+
+    static void appendName(std::string &payload, const std::string &name) {
+        Framing::appendString(payload, name);
+    }
+
+    static std::string readName(Framing::PayloadReader &reader) {
+        return reader.readString();
+    }
+
+    void framing_message() {
+        std::list<ErrorLogger::ErrorMessage::FileLocation> locations;
+        locations.emplace_back("a.cpp", "info", 3);
+        locations.back().col = 5;
+        locations.emplace_back("b.h", 7);
+        const ErrorLogger::ErrorMessage msg(locations, "a.cpp", Severity::warning, "short\nverbose", "someId", true);
+
+        std::string payload;
+        Framing::appendMessage(payload, msg, appendName);
+
+        ErrorLogger::ErrorMessage msg2;
+        Framing::PayloadReader reader(payload.data(), payload.size());
+        ASSERT_EQUALS(true, Framing::readMessage(reader, &msg2, readName));
+        ASSERT_EQUALS(msg.toXML(), msg2.toXML());
+        ASSERT_EQUALS(msg.toString(true), msg2.toString(true));
+
+        // A truncated message is not valid
+        for (std::size_t size = 0; size < payload.size(); size += 7) {
+            ErrorLogger::ErrorMessage msg3;
+            Framing::PayloadReader reader3(payload.data(), size);
+            ASSERT_EQUALS(false, Framing::readMessage(reader3, &msg3, readName));
+        }
+    }
+
+    void framing_pipe() {
+#ifdef THREADING_MODEL_FORK
+        int pipes[2];
+        ASSERT_EQUALS(0, pipe(pipes));
+        fcntl(pipes[0], F_SETFL, fcntl(pipes[0], F_GETFL, 0) | O_NONBLOCK);
+
+        const std::map<std::string, std::size_t> files;
+        ThreadExecutor executor(files, settings, *this);
+        ThreadExecutor::ChildPipe childPipe;
+        unsigned int result = 0;
+        output.str("");
+
+        std::string frames;
+        Framing::appendFrame(frames, ThreadExecutor::REPORT_OUT, "first");
+        Framing::appendFrame(frames, ThreadExecutor::REPORT_OUT, "second");
+
+        // A frame that is written in parts is handled when it is complete
+        ASSERT_EQUALS(true, Framing::writeAll(pipes[1], frames.substr(0, 3), false));
+        ASSERT_EQUALS(1, executor.handleRead(pipes[0], childPipe, result));
+        ASSERT_EQUALS("", output.str());
+        ASSERT_EQUALS(0, executor.handleRead(pipes[0], childPipe, result));
+        ASSERT_EQUALS(true, Framing::writeAll(pipes[1], frames.substr(3, 10), false));
+        ASSERT_EQUALS(1, executor.handleRead(pipes[0], childPipe, result));
+        ASSERT_EQUALS("first\n", output.str());
+
+        // A child that dies in the middle of a frame closes the pipe, the rest is dropped
+        ASSERT_EQUALS(true, Framing::writeAll(pipes[1], frames.substr(13, 5), false));
+        close(pipes[1]);
+        ASSERT_EQUALS(-1, executor.handleRead(pipes[0], childPipe, result));
+        ASSERT_EQUALS("first\n", output.str());
+        ASSERT_EQUALS(0U, result);
+        close(pipes[0]);
+
+        // The end frame carries the result of the child
+        childPipe = ThreadExecutor::ChildPipe();
+        ASSERT_EQUALS(0, pipe(pipes));
+        fcntl(pipes[0], F_SETFL, fcntl(pipes[0], F_GETFL, 0) | O_NONBLOCK);
+        std::string end;
+        Framing::appendInt(end, 3U);
+        Framing::appendMissingIncludes(end);
+        frames.clear();
+        Framing::appendFrame(frames, ThreadExecutor::CHILD_END, end);
+        ASSERT_EQUALS(true, Framing::writeAll(pipes[1], frames, false));
+        ASSERT_EQUALS(-1, executor.handleRead(pipes[0], childPipe, result));
+        ASSERT_EQUALS(3U, result);
+        close(pipes[1]);
+        close(pipes[0]);
+#endif
+    }
 };
 
 REGISTER_TEST(TestThreadExecutor)
@@ -23,6 +23,7 @@
 #include "tokenize.h"
 #include "tokenlist.h"
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -79,6 +80,8 @@ private:
         TEST_CASE(matchOr);
         TEST_CASE(matchOp);
         TEST_CASE(matchConstOp);
+        TEST_CASE(matchParsedPattern);
+        TEST_CASE(simpleMatchParsedPattern);
 
         TEST_CASE(isArithmeticalOp);
         TEST_CASE(isOp);
@@ -654,6 +657,121 @@ private:
         }
     }
 
+    // Result of Token::Match() for every token: 'T', 'F' or 'E' for InternalError
+    template<typename T>
+    static std::string matchAll(const Token *tokens, const T &pattern, unsigned int varid) {
+        std::string result;
+        for (const Token *tok = tokens;; tok = tok->next()) {
+            try {
+                result += Token::Match(tok, pattern, varid) ? 'T' : 'F';
+            } catch (const InternalError &) {
+                result += 'E';
+            }
+            if (!tok)
+                break;
+        }
+        return result;
+    }
+
+    template<typename T>
+    static std::string simpleMatchAll(const Token *tokens, const T &pattern) {
+        std::string result;
+        for (const Token *tok = tokens;; tok = tok->next()) {
+            result += Token::simpleMatch(tok, pattern) ? 'T' : 'F';
+            if (!tok)
+                break;
+        }
+        return result;
+    }
+
+    // Match with a local constant array, the array is at the same address in every call
+    static bool matchLocal(const Token *tok, char first) {
+        const char pattern[4] = { first, 'n', 't', '\0' };
+        return Token::Match(tok, pattern);
+    }
+
+    // A literal pattern is parsed once, the result must be the same as when the pattern is parsed in every call
+    void matchParsedPattern() {
+        givenACodeSampleToTokenize var("int a ; a |= b || c % 2 ; if ( a ) { } else { s = \"a b\" ; } c = 'x' ; d [ 0 ] = a > true ;");
+
+        static const char patterns[][40] = {
+            "int %name% ;", "%type% %varid% ;", "%name%|%num% =|;", "[;{}] %name%", "[]]", "[[]]", "[]x]",
+            "!!else", "; !!else", "!!else !!if", "!!{ a", "%or%|%oror% %name%", "%op%|%cop%|%comp%",
+            "%assign%", "%bool%|%char%", "%str% ;", "\"a b\"", "\"a", "if|while ( %var% )", "else|", "|",
+            "a|", "|a", "( %any% )", "%var% |= %var% %oror%", "x|y|z| %name%", "%", "% %num%", "%varid%|a",
+            "a|%varid%", "%foo%", "  a  ", ">|%name%|%any% %bool%", ""
+        };
+
+        for (const char (&pattern)[40] : patterns) {
+            const char *runtimePattern = pattern;
+            for (unsigned int varid = 0; varid < 3; ++varid) {
+                ASSERT_EQUALS_MSG(matchAll(var.tokens(), runtimePattern, varid), matchAll(var.tokens(), pattern, varid), pattern);
+                // parsed pattern from the cache
+                ASSERT_EQUALS_MSG(matchAll(var.tokens(), runtimePattern, varid), matchAll(var.tokens(), pattern, varid), pattern);
+            }
+        }
+
+        // The table of parsed patterns grows, and still has the patterns above
+        static const char emptyPatterns[1100][1] = {};
+        const char *emptyPattern = emptyPatterns[0];
+        for (const char (&pattern)[1] : emptyPatterns)
+            ASSERT_EQUALS(matchAll(var.tokens(), emptyPattern, 0), matchAll(var.tokens(), pattern, 0));
+        for (const char (&pattern)[40] : patterns) {
+            const char *runtimePattern = pattern;
+            ASSERT_EQUALS_MSG(matchAll(var.tokens(), runtimePattern, 1), matchAll(var.tokens(), pattern, 1), pattern);
+        }
+
+        // A modifiable array is parsed in every call
+        char pattern[20] = "int";
+        ASSERT_EQUALS(true, Token::Match(var.tokens(), pattern));
+        std::strcpy(pattern, "%num%");
+        ASSERT_EQUALS(false, Token::Match(var.tokens(), pattern));
+        std::strcpy(pattern, "int %name%");
+        ASSERT_EQUALS(true, Token::Match(var.tokens(), pattern));
+
+        // A constant array may have another pattern at the same address in a later call
+        char buffer[8] = "int";
+        const char (&constPattern)[8] = buffer;
+        ASSERT_EQUALS(true, Token::Match(var.tokens(), constPattern));
+        ASSERT_EQUALS(true, Token::simpleMatch(var.tokens(), constPattern));
+        std::strcpy(buffer, "%num%");
+        ASSERT_EQUALS(false, Token::Match(var.tokens(), constPattern));
+        ASSERT_EQUALS(false, Token::simpleMatch(var.tokens(), constPattern));
+        std::strcpy(buffer, "int a");
+        ASSERT_EQUALS(true, Token::Match(var.tokens(), constPattern));
+        ASSERT_EQUALS(true, Token::simpleMatch(var.tokens(), constPattern));
+        ASSERT_EQUALS(true, matchLocal(var.tokens(), 'i'));
+        ASSERT_EQUALS(false, matchLocal(var.tokens(), 'x'));
+        ASSERT_EQUALS(true, matchLocal(var.tokens(), 'i'));
+
+        // A search may get another pattern at the same address
+        std::strcpy(pattern, "%num%");
+        ASSERT_EQUALS(true, Token::findmatch(var.tokens(), pattern) != nullptr);
+        std::strcpy(pattern, "%char%");
+        ASSERT_EQUALS("'x'", Token::findmatch(var.tokens(), pattern)->str());
+        std::strcpy(pattern, "%bool% ;");
+        ASSERT_EQUALS("true", Token::findmatch(var.tokens(), pattern)->str());
+        std::strcpy(pattern, "x");
+        ASSERT_EQUALS(true, Token::findsimplematch(var.tokens(), pattern) == nullptr);
+        std::strcpy(pattern, "else {");
+        ASSERT_EQUALS("else", Token::findsimplematch(var.tokens(), pattern)->str());
+    }
+
+    void simpleMatchParsedPattern() {
+        givenACodeSampleToTokenize var("int a ; a |= b ; if ( a ) { } else { s = \"a b\" ; }", true);
+
+        static const char patterns[][20] = {
+            "a", "a |= b", "; if (", "a  |=", " a", "a ", "\"a b\"", "} else {", ""
+        };
+
+        for (const char (&pattern)[20] : patterns) {
+            const char *runtimePattern = pattern;
+            ASSERT_EQUALS_MSG(simpleMatchAll(var.tokens(), runtimePattern), simpleMatchAll(var.tokens(), pattern), pattern);
+        }
+        ASSERT_EQUALS(true, Token::simpleMatch(var.tokens(), "int a ;"));
+        ASSERT_EQUALS(false, Token::simpleMatch(var.tokens(), "int a  ;"));
+    }
+
 
     void isArithmeticalOp() const {
         std::vector<std::string>::const_iterator test_op, test_ops_end = arithmeticalOps.end();
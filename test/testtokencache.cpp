@@ -0,0 +1,172 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testsuite.h"
+#include "tokencache.h"
+
+#include <simplecpp.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class TestTokenCache : public TestFixture {
+public:
+    TestTokenCache() : TestFixture("TestTokenCache") {
+    }
+
+private:
+    const std::string cacheFile = "testtokencache.rawtokens";
+
+    void run() OVERRIDE {
+        TEST_CASE(storeAndLoad);
+        TEST_CASE(lineDirective);
+        TEST_CASE(otherContent);
+        TEST_CASE(invalidFile);
+        TEST_CASE(changedFile);
+    }
+
+    static std::string tokens(const simplecpp::TokenList &tokenList) {
+        std::ostringstream ostr;
+        for (const simplecpp::Token *tok = tokenList.cfront(); tok; tok = tok->next)
+            ostr << tok->location.file() << ':' << tok->location.line << ':' << tok->location.col << ' ' << tok->str() << '\n';
+        return ostr.str();
+    }
+
+    // Tokenize code, store it in the cache and read it back
+    std::string storeAndLoad(const std::string &code, const std::string &filename, const std::vector<std::string> &initialFiles) const {
+        std::vector<std::string> files1;
+        std::istringstream istr(code);
+        const simplecpp::TokenList tokens1(istr, files1, filename);
+        ASSERT_EQUALS(true, TokenCache::store(cacheFile, code, files1, filename, tokens1));
+
+        std::vector<std::string> files2(initialFiles);
+        simplecpp::TokenList tokens2(files2);
+        ASSERT_EQUALS(true, TokenCache::load(cacheFile, code, files2, filename, tokens2));
+        std::remove(cacheFile.c_str());
+
+        ASSERT_EQUALS(tokens(tokens1), tokens(tokens2));
+        return tokens(tokens2);
+    }
+
+    void storeAndLoad() const {
+        const char code[] = "// comment\n"
+                            "int a = 1;\n"
+                            "  const char *s = \"abc\";\n";
+        ASSERT_EQUALS("a.c:1:1 // comment\n"
+                      "a.c:2:1 int\n"
+                      "a.c:2:5 a\n"
+                      "a.c:2:7 =\n"
+                      "a.c:2:9 1\n"
+                      "a.c:2:10 ;\n"
+                      "a.c:3:3 const\n"
+                      "a.c:3:9 char\n"
+                      "a.c:3:14 *\n"
+                      "a.c:3:15 s\n"
+                      "a.c:3:17 =\n"
+                      "a.c:3:19 \"abc\"\n"
+                      "a.c:3:24 ;\n",
+                      storeAndLoad(code, "a.c", std::vector<std::string>()));
+
+        // The cached tokens can be used for a file with another name and file index
+        std::vector<std::string> initialFiles;
+        initialFiles.push_back("main.c");
+        ASSERT_EQUALS("b.h:1:1 x\n", storeAndLoad("x", "b.h", initialFiles));
+    }
+
+    void lineDirective() const {
+        const char code[] = "#line 10 \"x.y\"\n"
+                            "a\n";
+        ASSERT_EQUALS("a.c:1:1 #\n"
+                      "a.c:1:2 line\n"
+                      "a.c:1:7 10\n"
+                      "a.c:1:10 \"x.y\"\n"
+                      "x.y:10:1 a\n",
+                      storeAndLoad(code, "a.c", std::vector<std::string>()));
+    }
+
+    void otherContent() const {
+        std::vector<std::string> files1;
+        std::istringstream istr("int a;");
+        const simplecpp::TokenList tokens1(istr, files1, "a.c");
+        ASSERT_EQUALS(true, TokenCache::store(cacheFile, "int a;", files1, "a.c", tokens1));
+
+        std::vector<std::string> files2;
+        simplecpp::TokenList tokens2(files2);
+        ASSERT_EQUALS(false, TokenCache::load(cacheFile, "int b;", files2, "a.c", tokens2));
+        ASSERT_EQUALS(true, tokens2.empty());
+        std::remove(cacheFile.c_str());
+    }
+
+    void invalidFile() const {
+        std::vector<std::string> files1;
+        std::istringstream istr("int a;");
+        const simplecpp::TokenList tokens1(istr, files1, "a.c");
+        ASSERT_EQUALS(true, TokenCache::store(cacheFile, "int a;", files1, "a.c", tokens1));
+
+        // Truncated file
+        std::string data;
+        {
+            std::ifstream fin(cacheFile, std::ios::binary);
+            data.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        }
+        {
+            std::ofstream fout(cacheFile, std::ios::binary);
+            fout.write(data.data(), data.size() - 1U);
+        }
+
+        std::vector<std::string> files2;
+        simplecpp::TokenList tokens2(files2);
+        ASSERT_EQUALS(false, TokenCache::load(cacheFile, "int a;", files2, "a.c", tokens2));
+        ASSERT_EQUALS(true, tokens2.empty());
+        std::remove(cacheFile.c_str());
+
+        ASSERT_EQUALS(false, TokenCache::load(cacheFile, "int a;", files2, "a.c", tokens2));
+    }
+
+    // Read file through the cache in the current directory
+    static std::string readfile(const std::string &code, const std::string &filename) {
+        std::vector<std::string> files;
+        simplecpp::TokenList tokenList(files);
+        std::istringstream istr(code);
+        TokenCache::readfile(".", istr, files, filename, tokenList, nullptr);
+        return tokens(tokenList);
+    }
+
+    void changedFile() const {
+        const std::string file = TokenCache::getCacheFile(".", "testtokencache.c");
+        ASSERT_EQUALS(file, TokenCache::getCacheFile(".", "./testtokencache.c"));
+        ASSERT(file != TokenCache::getCacheFile(".", "sub/testtokencache.c"));
+
+        ASSERT_EQUALS("testtokencache.c:1:1 a\n", readfile("a", "testtokencache.c"));
+        ASSERT_EQUALS("testtokencache.c:1:1 b\n", readfile("b", "testtokencache.c"));
+
+        // The new content replaced the cache file of the old content
+        std::vector<std::string> files;
+        simplecpp::TokenList tokens1(files);
+        ASSERT_EQUALS(false, TokenCache::load(file, "a", files, "testtokencache.c", tokens1));
+        simplecpp::TokenList tokens2(files);
+        ASSERT_EQUALS(true, TokenCache::load(file, "b", files, "testtokencache.c", tokens2));
+        ASSERT_EQUALS("testtokencache.c:1:1 b\n", tokens(tokens2));
+        std::remove(file.c_str());
+    }
+};
+
+REGISTER_TEST(TestTokenCache)
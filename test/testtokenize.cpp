@@ -7475,6 +7475,17 @@ private:
         ASSERT_EQUALS("Abc({newreturn", testAst("return new A {b(c)};"));
         ASSERT_EQUALS("a{{return", testAst("return{{a}};"));
         ASSERT_EQUALS("a{b{,{return", testAst("return{{a},{b}};"));
+        ASSERT_EQUALS("x12,{34,{,56,{,{=", testAst("x = { {1, 2}, {3, 4}, {5, 6} };"));
+        ASSERT_EQUALS("f{{,{,(", testAst("f({1}, {2}, {3});"));
+        ASSERT_EQUALS("a{b{,c{,{return", testAst("return{{a},{b},{c}};"));
+
+        // long lists, the elements after the first reuse the walk of their predecessor
+        ASSERT_EQUALS("x12,{34,{,56,{,78,{,910,{,1112,{,1314,{,1516,{,1718,{,1920,{,{=", testAst("x = { {1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14}, {15, 16}, {17, 18}, {19, 20} };"));
+        ASSERT_EQUALS("x12,{34,{,56,{78,{,910,{1112,{,1314,{1516,{,{,{,{,{{=", testAst("x = { {{1, 2}, {3, 4}}, {{5, 6}, {7, 8}}, {{9, 10}, {11, 12}}, {{13, 14}, {15, 16}} };"));
+        ASSERT_EQUALS("f{{,{,{,{,{,{,{,(", testAst("f({1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14}, {15, 16});"));
+        ASSERT_EQUALS("f{{,{,{,(", testAst("f({{1}, {2}}, {{3}, {4}}, {{5}, {6}}, {{7}, {8}});"));
+        ASSERT_EQUALS("fa{,b,{,c,(", testAst("f(a, {{1, 2}, {3, 4}}, b, {{5, 6}, {7, 8}}, c);"));
+        ASSERT_EQUALS("A1{2{,3{,4{,5{,6{,7{,8{,9{,10{,{return", testAst("return A{{1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, {10}};"));
     }
 
     void astbrackets() { // []
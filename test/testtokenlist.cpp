@@ -19,6 +19,7 @@
 #include "settings.h"
 #include "testsuite.h"
 #include "token.h"
+#include "tokenize.h"
 #include "tokenlist.h"
 
 #include <sstream>
@@ -36,6 +37,8 @@ private:
         TEST_CASE(testaddtoken1);
         TEST_CASE(testaddtoken2);
         TEST_CASE(inc);
+        TEST_CASE(reuseDeletedTokens);
+        TEST_CASE(defUseIndexReset);
     }
 
     // inspired by #5895
@@ -73,6 +76,63 @@ private:
 
         ASSERT(Token::simpleMatch(tokenlist.front(), "a + + 1 ; 1 + + b ;"));
     }
+
+    // Tokens are allocated from the arena of the token list
+    void reuseDeletedTokens() const {
+        TokenList tokenlist(&settings);
+        std::istringstream istr("int a ; int b ;");
+        tokenlist.createTokens(istr, "a.cpp");
+
+        Token *tok = tokenlist.front();
+        tok->deleteNext(2);
+        tok->insertToken("x");
+        tok->next()->insertToken("y");
+        tok->next()->originalName("z");
+        ASSERT(Token::simpleMatch(tokenlist.front(), "int x y int b ;"));
+        tokenlist.back()->deletePrevious();
+        ASSERT(Token::simpleMatch(tokenlist.front(), "int x y int ;"));
+        ASSERT_EQUALS("z", tok->next()->originalName());
+
+        tokenlist.deallocateTokens();
+        std::istringstream istr2("a = b ;");
+        tokenlist.createTokens(istr2, "a.cpp");
+        ASSERT(Token::simpleMatch(tokenlist.front(), "a = b ;"));
+        ASSERT_EQUALS(";", tokenlist.back()->str());
+    }
+
+    // The index of the variable uses is dropped when what it was created from changes
+    void defUseIndexReset() {
+        Tokenizer tokenizer(&settings, this);
+        std::istringstream istr("void g(int a, int b) { a = b; f(a); }");
+        tokenizer.tokenize(istr, "a.cpp");
+        TokenList &tokenlist = tokenizer.list;
+        Token *tok = const_cast<Token *>(Token::findsimplematch(tokenlist.front(), "a ="));
+
+        tokenlist.createDefUseIndex();
+        ASSERT(tok->defUseIndex() != nullptr);
+        tok->next()->astOperand2(nullptr);
+        ASSERT(tok->defUseIndex() == nullptr);
+
+        tokenlist.createDefUseIndex();
+        tok->clearAst();
+        ASSERT(tok->defUseIndex() == nullptr);
+
+        tokenlist.createDefUseIndex();
+        tok->variable(nullptr);
+        ASSERT(tok->defUseIndex() == nullptr);
+
+        tokenlist.createDefUseIndex();
+        tok->tokAt(4)->function(nullptr);
+        ASSERT(tok->defUseIndex() == nullptr);
+
+        tokenlist.createDefUseIndex();
+        tok->setValueType(nullptr);
+        ASSERT(tok->defUseIndex() == nullptr);
+
+        tokenlist.createDefUseIndex();
+        tok->varId(1);
+        ASSERT(tok->defUseIndex() == nullptr);
+    }
 };
 
 REGISTER_TEST(TestTokenList)
@@ -28,6 +28,7 @@
 #include <cmath>
 #include <list>
 #include <map>
+#include <set>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -119,6 +120,11 @@ private:
         TEST_CASE(valueFlowContainerSize);
 
         TEST_CASE(valueFlowDynamicBufferSize);
+
+        TEST_CASE(valueFlowJobs);
+
+        TEST_CASE(valueList);
+        TEST_CASE(sharedErrorPath);
     }
 
     static bool isNotTokValue(const ValueFlow::Value &val) {
@@ -191,7 +197,7 @@ private:
 
             std::ostringstream ostr;
             for (const ValueFlow::Value &v : tok->values()) {
-                for (const ValueFlow::Value::ErrorPathItem &ep : v.errorPath) {
+                for (const ValueFlow::Value::ErrorPathItem &ep : ValueFlow::Value::ErrorPath(v.errorPath)) {
                     const Token *eptok = ep.first;
                     const std::string &msg = ep.second;
                     ostr << eptok->linenr() << ',' << msg << '\n';
@@ -467,6 +473,11 @@ private:
                "}";
         ASSERT_EQUALS(true, testValueOfX(code, 4U, ValueFlow::Value::ForwardedVariable));
 
+        // Moved values are not needed by the checks that run
+        settings.analysis = 0;
+        ASSERT_EQUALS(false, testValueOfX(code, 4U, ValueFlow::Value::ForwardedVariable));
+        settings.analysis = Settings::MOVED_VALUES;
+
         code = "void f() {\n"
                "   X x;\n"
                "   g(std::move(x).getA());\n"   // Only parts of x might be moved out
@@ -2604,6 +2615,28 @@ private:
         ValueFlow::Value value2 = valueOfTok(code, "+");
         ASSERT_EQUALS(16, value2.intvalue);
         ASSERT(value2.isKnown());
+
+        // many case values => int range
+        code = "void f(int x) {\n"
+               "    switch (x) {\n"
+               "    case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8: case 9:\n"
+               "    case 10: case 11: case 12: case 13: case 14: case 15: case 16: case 17: case 18: case 19:\n"
+               "        a = x + 1;\n"
+               "        if (x < 5)\n"
+               "            b = x;\n"  // <- x is not 0..19
+               "        break;\n"
+               "    }\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 5U, 0, ValueFlow::Value::INT));
+        ASSERT_EQUALS(true, testValueOfX(code, 5U, 8, ValueFlow::Value::INT));
+        ASSERT_EQUALS(false, testValueOfX(code, 5U, 9, ValueFlow::Value::INT));
+        ASSERT_EQUALS(true, testValueOfX(code, 5U, 9, ValueFlow::Value::INT_RANGE));
+        ASSERT_EQUALS(false, testValueOfX(code, 7U, 9, ValueFlow::Value::INT_RANGE));
+        const std::list<ValueFlow::Value> values3 = tokenValues(code, "+");
+        ASSERT_EQUALS(10U, values3.size());
+        ASSERT(values3.back().isIntRangeValue());
+        ASSERT_EQUALS(10, values3.back().intvalue);
+        ASSERT_EQUALS(20, values3.back().intvalueMax);
     }
 
     void valueFlowForLoop() {
@@ -2858,6 +2891,29 @@ private:
                "    a = x;\n" // <- max value is 3
                "}";
         ASSERT_EQUALS(true, testValueOfX(code, 5U, 3));
+
+        // many variables in program memory
+        code = "void f() {\n"
+               "  int a,b,c,d,e,g,h,i,j,k,x;\n"
+               "  for(a=0,b=1,c=2,d=3,e=4,g=5,h=6,i=7,j=8,k=9,x=0; x < 10; a++,b++,c++,d++,e++,g++,h++,i++,j++,k++,x++)\n"
+               "    z = x;\n"
+               "  z = x;\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 4U, 0));
+        ASSERT_EQUALS(true, testValueOfX(code, 4U, 9));
+        ASSERT_EQUALS(false, testValueOfX(code, 4U, 10));
+        ASSERT_EQUALS(true, testValueOfX(code, 5U, 10));
+
+        code = "void f() {\n"
+               "  int x;\n"
+               "  for (x = 1; x < 100 && x != 64; x *= 2)\n"
+               "    a = x;\n"
+               "  b = x;\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 4U, 1));
+        ASSERT_EQUALS(true, testValueOfX(code, 4U, 32));
+        ASSERT_EQUALS(false, testValueOfX(code, 4U, 64));
+        ASSERT_EQUALS(true, testValueOfX(code, 5U, 64));
     }
 
     void valueFlowFunctionReturn() {
@@ -3874,6 +3930,204 @@ private:
                "}";
         ASSERT_EQUALS(true, testValueOfX(code, 4U, 5,  ValueFlow::Value::BUFFER_SIZE));
     }
+
+    std::string valueFlowJobsValues(const char code[], unsigned int jobs) {
+        settings.valueFlowJobs = jobs;
+        Tokenizer tokenizer(&settings, this);
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+        settings.valueFlowJobs = 1;
+
+        // The passes run in the same order, so the values of a token are in the same order
+        std::string ret;
+        for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+            for (const ValueFlow::Value &value : tok->values())
+                ret += std::to_string(tok->linenr()) + " " + tok->str() + " " + value.infoString() + (value.isKnown() ? " known" : "") + "\n";
+        }
+        return ret;
+    }
+
+    void valueFlowJobs() {
+        const char code[] = "int *f1(int *p) { return p; }\n"
+                            "int f2(int a) {\n"
+                            "    int x = 0;\n"
+                            "    for (int i = 0; i < 10; i++)\n"
+                            "        x += i;\n"
+                            "    if (a == 3) {}\n"
+                            "    switch (a) { case 1: return x; case 2: return 2; }\n"
+                            "    return a + x;\n"
+                            "}\n"
+                            "void f3() {\n"
+                            "    struct S { int g(int b) { if (b > 1) {} return b; } };\n"
+                            "    int y = 1;\n"
+                            "    int *q;\n"
+                            "    q = f1(&y);\n"
+                            "    std::string s;\n"
+                            "    s = \"abc\";\n"
+                            "    if (s.size() == 3) {}\n"
+                            "    f2(y + 1);\n"
+                            "}\n"
+                            "void f4(std::vector<int> v, int c) {\n"
+                            "    std::unique_ptr<int> p;\n"
+                            "    if (c > 0) {} else if (c <= 0) {}\n"
+                            "    if (v.empty()) { v.push_back(c); }\n"
+                            "    v.push_back(1);\n"
+                            "    if (v.size() == 2) { return; }\n"
+                            "    int z;\n"
+                            "    f2(z);\n"
+                            "}\n";
+        // The values of f2 depend on the call in f3, so there are several rounds.
+        // The worker threads are reused by the following rounds and checks.
+        const std::string expected = valueFlowJobsValues(code, 1);
+        ASSERT(expected.find("a 2") != std::string::npos);
+        ASSERT_EQUALS(expected, valueFlowJobsValues(code, 4));
+        ASSERT_EQUALS(expected, valueFlowJobsValues(code, 2));
+        ASSERT_EQUALS(expected, valueFlowJobsValues(code, 4));
+    }
+
+    static std::string intValues(const ValueFlow::ValueList &values) {
+        std::string ret;
+        for (const ValueFlow::Value &value : values)
+            ret += (ret.empty() ? "" : ",") + std::to_string(value.intvalue);
+        return ret;
+    }
+
+    void valueList() {
+        // The first value is inline, then the values are moved to larger arrays
+        ValueFlow::ValueList values;
+        ASSERT_EQUALS(true, values.empty());
+        std::string expected;
+        for (int i = 1; i <= 20; ++i) {
+            values.push_back(ValueFlow::Value(i));
+            expected += (i == 1 ? "" : ",") + std::to_string(i);
+            ASSERT_EQUALS(expected, intValues(values));
+            ASSERT_EQUALS(i, values.size());
+        }
+        ASSERT_EQUALS(1, values.front().intvalue);
+        ASSERT_EQUALS(20, values.back().intvalue);
+
+        // Remove values at the front, in the middle and at the back
+        values.remove_if([](const ValueFlow::Value &value) {
+            return value.intvalue == 1 || value.intvalue == 10 || value.intvalue == 11 || value.intvalue == 20;
+        });
+        ASSERT_EQUALS("2,3,4,5,6,7,8,9,12,13,14,15,16,17,18,19", intValues(values));
+        values.remove_if([](const ValueFlow::Value &value) {
+            return value.intvalue % 2 == 0;
+        });
+        ASSERT_EQUALS("3,5,7,9,13,15,17,19", intValues(values));
+
+        // Insert values at the front and at the back
+        values.push_front(ValueFlow::Value(0));
+        values.push_back(ValueFlow::Value(21));
+        ASSERT_EQUALS("0,3,5,7,9,13,15,17,19,21", intValues(values));
+
+        // Insert at the front when the inline value and the arrays are full
+        ValueFlow::ValueList front;
+        front.push_front(ValueFlow::Value(3));
+        front.push_front(ValueFlow::Value(2));
+        front.push_front(ValueFlow::Value(1));
+        front.push_front(ValueFlow::Value(0));
+        front.push_front(ValueFlow::Value(-1));
+        ASSERT_EQUALS("-1,0,1,2,3", intValues(front));
+
+        // Remove all values, and add a value again
+        front.remove_if([](const ValueFlow::Value &) {
+            return true;
+        });
+        ASSERT_EQUALS(true, front.empty());
+        front.push_back(ValueFlow::Value(7));
+        ASSERT_EQUALS("7", intValues(front));
+
+        // Copy
+        ValueFlow::ValueList copy(values);
+        ASSERT_EQUALS(intValues(values), intValues(copy));
+        ASSERT(copy == values);
+        copy.push_back(ValueFlow::Value(22));
+        ASSERT(copy != values);
+        copy = front;
+        ASSERT_EQUALS("7", intValues(copy));
+        copy = values;
+        ASSERT_EQUALS(intValues(values), intValues(copy));
+        const ValueFlow::ValueList &self = copy;
+        copy = self;
+        ASSERT_EQUALS(intValues(values), intValues(copy));
+
+        // Move, the array is taken and the inline value is moved
+        const ValueFlow::Value *data = &copy.front();
+        ValueFlow::ValueList moved(std::move(copy));
+        ASSERT_EQUALS(intValues(values), intValues(moved));
+        ASSERT_EQUALS(true, data == &moved.front());
+        ASSERT_EQUALS(true, copy.empty());
+        ValueFlow::ValueList movedInline(std::move(front));
+        ASSERT_EQUALS("7", intValues(movedInline));
+        ASSERT_EQUALS(true, front.empty());
+        moved = std::move(movedInline);
+        ASSERT_EQUALS("7", intValues(moved));
+        ASSERT_EQUALS(true, movedInline.empty());
+        moved = std::move(values);
+        ASSERT_EQUALS("0,3,5,7,9,13,15,17,19,21", intValues(moved));
+        ASSERT_EQUALS(true, values.empty());
+
+        // A list that is moved from can be used again
+        values.push_back(ValueFlow::Value(1));
+        values.push_back(ValueFlow::Value(2));
+        ASSERT_EQUALS("1,2", intValues(values));
+    }
+
+    static std::string errorPathString(const ValueFlow::SharedErrorPath &errorPath) {
+        std::string ret;
+        for (const ValueFlow::SharedErrorPath::Item &item : ValueFlow::SharedErrorPath::List(errorPath))
+            ret += (ret.empty() ? "" : ",") + item.second;
+        return ret;
+    }
+
+    void sharedErrorPath() {
+        ValueFlow::SharedErrorPath errorPath;
+        ASSERT_EQUALS(true, errorPath.empty());
+        ASSERT_EQUALS(0, errorPath.size());
+        errorPath.emplace_back(nullptr, "a");
+        errorPath.push_back(ValueFlow::SharedErrorPath::Item(nullptr, "b"));
+        ASSERT_EQUALS("a,b", errorPathString(errorPath));
+        ASSERT_EQUALS(2, errorPath.size());
+        ASSERT_EQUALS("b", errorPath.back().second);
+
+        // Copies share the tail, adding items to one does not change the others
+        ValueFlow::SharedErrorPath copy1(errorPath);
+        ValueFlow::SharedErrorPath copy2(errorPath);
+        copy1.emplace_back(nullptr, "c1");
+        copy2.emplace_back(nullptr, "c2");
+        copy2.emplace_back(nullptr, "d2");
+        ASSERT_EQUALS("a,b", errorPathString(errorPath));
+        ASSERT_EQUALS("a,b,c1", errorPathString(copy1));
+        ASSERT_EQUALS("a,b,c2,d2", errorPathString(copy2));
+        ASSERT_EQUALS(3, copy1.size());
+        ASSERT_EQUALS(4, copy2.size());
+
+        // Adding an item in front does not change the copies
+        copy1.emplace_front(nullptr, "z");
+        ASSERT_EQUALS("z,a,b,c1", errorPathString(copy1));
+        ASSERT_EQUALS("a,b", errorPathString(errorPath));
+        ASSERT_EQUALS("a,b,c2,d2", errorPathString(copy2));
+
+        // Assign a list
+        ValueFlow::SharedErrorPath::List items;
+        items.emplace_back(nullptr, "x");
+        items.emplace_back(nullptr, "y");
+        copy2 = items;
+        ASSERT_EQUALS("x,y", errorPathString(copy2));
+        copy2 = ValueFlow::SharedErrorPath::List();
+        ASSERT_EQUALS(true, copy2.empty());
+        ASSERT_EQUALS("a,b", errorPathString(errorPath));
+
+        // Values with error paths that share a tail
+        ValueFlow::Value value1(1);
+        value1.errorPath.emplace_back(nullptr, "a");
+        ValueFlow::Value value2(value1);
+        value1.errorPath.emplace_back(nullptr, "b1");
+        value2.errorPath.emplace_back(nullptr, "b2");
+        ASSERT_EQUALS("a,b1", errorPathString(value1.errorPath));
+        ASSERT_EQUALS("a,b2", errorPathString(value2.errorPath));
+    }
 };
 
 REGISTER_TEST(TestValueFlow)
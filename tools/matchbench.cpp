@@ -0,0 +1,115 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2019 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Micro benchmark of Token::Match() and Token::simpleMatch().
+ *
+ * The same patterns are matched against every token of a file, once as
+ * string literals and once through pointers so they are parsed in every
+ * call. "make matchbench" uses the patterns that are parsed once by
+ * Token, "make matchbench-mc" compiles the string literals with
+ * tools/matchcompiler.py.
+ *
+ * Usage: matchbench <file> [iterations]
+ */
+
+#include "settings.h"
+#include "token.h"
+#include "tokenize.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+static unsigned int matchLiteral(const Token *tokens)
+{
+    unsigned int count = 0;
+    for (const Token *tok = tokens; tok; tok = tok->next()) {
+        count += Token::Match(tok, "%name% (") ? 1U : 0U;
+        count += Token::Match(tok, "%var% =") ? 1U : 0U;
+        count += Token::Match(tok, "[;{}] %name% :: %name%") ? 1U : 0U;
+        count += Token::Match(tok, "if|while|for|switch (") ? 1U : 0U;
+        count += Token::Match(tok, "return|throw !!;") ? 1U : 0U;
+        count += Token::Match(tok, "%type% *|&| %name% ;|=|[") ? 1U : 0U;
+        count += Token::Match(tok, "%op%|%comp%|%assign% %num%|%str%|%char%") ? 1U : 0U;
+        count += Token::Match(tok, ") const| {") ? 1U : 0U;
+        count += Token::Match(tok, "std :: vector|list|map <") ? 1U : 0U;
+        count += Token::Match(tok, "%name% . %name% (") ? 1U : 0U;
+        count += Token::simpleMatch(tok, "else {") ? 1U : 0U;
+        count += Token::simpleMatch(tok, ") ;") ? 1U : 0U;
+        count += Token::simpleMatch(tok, "delete [ ]") ? 1U : 0U;
+        count += Token::simpleMatch(tok, "= 0 ;") ? 1U : 0U;
+    }
+    return count;
+}
+
+static unsigned int matchRuntime(const Token *tokens)
+{
+    const char *patterns[] = {
+        "%name% (", "%var% =", "[;{}] %name% :: %name%", "if|while|for|switch (", "return|throw !!;",
+        "%type% *|&| %name% ;|=|[", "%op%|%comp%|%assign% %num%|%str%|%char%", ") const| {",
+        "std :: vector|list|map <", "%name% . %name% ("
+    };
+    const char *simplePatterns[] = {
+        "else {", ") ;", "delete [ ]", "= 0 ;"
+    };
+
+    unsigned int count = 0;
+    for (const Token *tok = tokens; tok; tok = tok->next()) {
+        for (const char *pattern : patterns)
+            count += Token::Match(tok, pattern) ? 1U : 0U;
+        for (const char *pattern : simplePatterns)
+            count += Token::simpleMatch(tok, pattern) ? 1U : 0U;
+    }
+    return count;
+}
+
+template<class F>
+static void measure(const char *name, F f, const Token *tokens, int iterations)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    unsigned int count = 0;
+    for (int i = 0; i < iterations; ++i)
+        count += f(tokens);
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << elapsed.count() << " ms (" << count << " matches)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Syntax: matchbench <file> [iterations]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream fin(argv[1]);
+    if (!fin.is_open()) {
+        std::cerr << "Failed to open " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    const int iterations = (argc > 2) ? std::atoi(argv[2]) : 100;
+
+    Settings settings;
+    Tokenizer tokenizer(&settings, nullptr);
+    tokenizer.createTokens(fin, argv[1]);
+
+    measure("literal patterns", matchLiteral, tokenizer.tokens(), iterations);
+    measure("runtime patterns", matchRuntime, tokenizer.tokens(), iterations);
+    return EXIT_SUCCESS;
+}